@@ -18,6 +18,9 @@
 #include <AssemblyLogFileView.h>
 #include <AssemblyParameters.h>
 #include <AssemblyUtilities.h>
+#ifdef NOUEYE
+#include <AssemblyUEyeFakeCamera.h>
+#endif
 
 #include <string>
 
@@ -126,6 +129,8 @@ AssemblyMainWindow::AssemblyMainWindow(const QString& outputdir_path, const QStr
       1000
     );
 
+    motion_model_->setMotionWatchInterval(config->getValue<int>("LStepExpressModel_motionWatchInterval", 20));
+
     motion_manager_ = new LStepExpressMotionManager(motion_model_);
     connect(motion_manager_->model(), SIGNAL(emergencyStop_request()), motion_manager_, SLOT(clear_motion_queue()));
 
@@ -147,6 +152,16 @@ AssemblyMainWindow::AssemblyMainWindow(const QString& outputdir_path, const QStr
       NQLog("AssemblyMainWindow", NQLog::Critical) << "initialization error: null pointer to AssemblyVUEyeCamera object (camera_ID=" << camera_ID_ << ")";
       NQLog("AssemblyMainWindow", NQLog::Critical) << "---------------------------------------------------------------------------------";
     }
+
+#ifdef NOUEYE
+    // fake camera replaying a recorded z-stack follows the z-position of the motion stage
+    AssemblyUEyeFakeCamera* fake_camera = dynamic_cast<AssemblyUEyeFakeCamera*>(camera_);
+    if(fake_camera != nullptr)
+    {
+      const LStepExpressMotionManager* const mm = motion_manager_;
+      fake_camera->setZPositionSource([mm](){ return mm->get_position_Z(); });
+    }
+#endif
     /// -------------------
 
     /// Vacuum Manager
@@ -784,6 +799,9 @@ void AssemblyMainWindow::disconnect_objectAligner()
   // kick-start alignment
   disconnect(aligner_, SIGNAL(configuration_updated()), aligner_, SLOT(execute()));
 
+  // motions of an interrupted alignment are no longer followed
+  aligner_->release_motion_manager();
+
   aligner_view_->Configuration_Widget()->setEnabled(true);
 
   aligner_connected_ = false;
@@ -960,6 +978,9 @@ void AssemblyMainWindow::quit()
     this->quit_thread(camera_thread_, "terminated AssemblyUEyeCameraThread");
     this->quit_thread(finder_thread_, "terminated AssemblyObjectFinderPatRecThread");
 
+    // complete the queued output files while the objects they refer to still exist
+    assembly::AsyncWriter::instance()->shutdown();
+
     NQLog("AssemblyMainWindow", NQLog::Message) << "quit: application closed";
 
     return;
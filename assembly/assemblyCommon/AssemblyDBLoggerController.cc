@@ -77,7 +77,10 @@ void AssemblyDBLoggerController::copy_current_logfile(const QString dest_path)
 //Connect signal/slots between Model/View/Controller classes
 void AssemblyDBLoggerController::connect_all()
 {
+    this->view_->set_maximum_lines(this->model_->get_maximum_lines());
+
     connect(this->model_, SIGNAL(refresh_content_view(QStringList)), this->view_, SLOT(update_content(QStringList)));
+    connect(this->model_, SIGNAL(prepend_content_view(QStringList)), this->view_, SLOT(prepend_content(QStringList)));
     connect(this->model_, SIGNAL(overwrite_content_view()), this->view_, SLOT(clear_content()));
 
     connect(this->view_->get_DBLogger_appendModeBox(), SIGNAL(currentIndexChanged(const QString&)), this->model_, SLOT(setAppendMode(const QString&)));
@@ -20,7 +20,8 @@ dblogfilepath_(path)
     reading_ = false;
     overwrite_ = false;
     appendToEnd_ = true;
-    last_read_endline_ = 0;
+    read_offset_ = 0;
+    maximum_lines_ = 10000;
     verbosity_ = 0;
 
     //Set timer -- used to update log display in GUI
@@ -78,6 +79,7 @@ void AssemblyDBLoggerModel::writeLogHeader()
 }
 
 //Writes desired message to log
+//The file is append-only: messages are always written at its end, the 'Start of log file' mode only reverses the order of the display
 void AssemblyDBLoggerModel::writeMessage(QString message)
 {
     // std::cout<<"\e[1;31m writeMessage \e[0m"<<message.toUtf8().constData()<<std::endl;
@@ -85,35 +87,18 @@ void AssemblyDBLoggerModel::writeMessage(QString message)
     QMutexLocker locker(&mutex_); //Lock mutex to protect following data from being accessed by multiple threads at once
     QFile file(dblogfilepath_);
 
-    if(this->appendToEnd_) //Message will be appended at end of file [default]
-    {
-        if(!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text) ) {return;} //Open file in write mode
-
-        QTextStream stream(&file);
-        stream << "[" << getTimestamp() << "] "; //Print timestamp
-        stream << message << endl; //Print message
-        file.close();
-    }
-    else if(!this->appendToEnd_) //Message will be appenbded at beginning of file
-    {
-        if(!file.open(QFile::ReadOnly | QFile::Text) ) {return;} //Open file in read mode
-        QByteArray buffer = file.readAll(); //Get file's content
-        file.close();
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text) ) {return;} //Open file in write mode
 
-        file.open(QFile::WriteOnly | QFile::Text); //Re-open file in write mode
-        QTextStream out(&file);
-        out << "[" << getTimestamp() << "] "; //Print timestamp
-        out << message << endl << endl; //Print message
-        out << buffer; //Print previous file's content
-        file.close();
-
-        overwrite_ = true; //Tell the Viewer it needs to update the entire GUI display
-    }
+    QTextStream stream(&file);
+    stream << "[" << getTimestamp() << "] "; //Print timestamp
+    stream << message << endl; //Print message
+    file.close();
 
     return;
 }
 
-//After each time interval of timer_, read the DBLog file and look for new lines to display in the GUI tab
+//After each time interval of timer_, read the lines appended to the DBLog file since the previous call and display them in the GUI tab
+//The file is only opened if its size changed, and read from the last read position on (no re-reading of the whole file)
 void AssemblyDBLoggerModel::read_newlines()
 {
     // std::cout<<"\e[1;31m read_newlines \e[0m"<<std::endl;
@@ -122,50 +107,117 @@ void AssemblyDBLoggerModel::read_newlines()
     {
         reading_ = true;
 
+        QMutexLocker locker(&mutex_);
+
+        const qint64 file_size = QFileInfo(dblogfilepath_).size();
+
+        //A file smaller than the part already read has been replaced (e.g. loaded from an existing log): read it again from the start
+        if(file_size < read_offset_) {overwrite_ = true;}
+
         if(overwrite_) //Need to overwrite previous content display
         {
+            read_offset_ = 0;
+            lines_.clear();
+
             NQLog("AssemblyDBLoggerModel", NQLog::Debug) << "read_newlines" << ": emitting signal \"overwrite_content_view(QStringList)\"";
             emit overwrite_content_view();
+
+            overwrite_ = false;
         }
 
+        if(file_size == read_offset_) {reading_ = false; return;} //Nothing new
+
         QFile file(dblogfilepath_);
-        if(file.open(QIODevice::ReadOnly | QIODevice::Text) == false)
+        if(file.open(QIODevice::ReadOnly) == false || file.seek(read_offset_) == false)
         {
             NQLog("AssemblyDBLoggerModel", NQLog::Warning) << "read_newlines" << ": file " << dblogfilepath_ << " not opened...";
+            reading_ = false;
             return;
         }
 
-        QTextStream in(&file);
-        uint line_number(0);
+        const QByteArray buffer = file.readAll();
+        file.close();
+
+        //Only complete lines are read, a partially written line is read at the next call
+        const int end = buffer.lastIndexOf('\n');
+        if(end < 0) {reading_ = false; return;}
+
         QStringList qstr_list;
-        while(in.atEnd() == false)
+        int begin(0);
+        while(begin <= end)
         {
-            const QString line = in.readLine();
-            // std::cout<<"line : "<<line.toUtf8().constData()<<std::endl;
-            ++line_number;
-            if(overwrite_ || line_number > last_read_endline_) {qstr_list.append(line);} //Store all 'new' lines
+            const int next = buffer.indexOf('\n', begin);
+            qstr_list.append(QString::fromUtf8(buffer.constData() + begin, next - begin)); //Store all 'new' lines
+            begin = next + 1;
         }
 
-        NQLog("AssemblyDBLoggerModel", NQLog::Debug) << "read_newlines" << ": emitting signal \"refresh_content_view(QStringList)\"";
-        emit refresh_content_view(qstr_list);
+        read_offset_ += (end + 1); //Update current read position
 
-        last_read_endline_ = line_number; //Update current line index
-        file.close();
+        //Lines beyond the maximum would be dropped right away, neither kept nor displayed
+        if(qstr_list.size() > maximum_lines_) {qstr_list.erase(qstr_list.begin(), qstr_list.end() - maximum_lines_);}
+
+        for(const auto& i_qstr : qstr_list)
+        {
+            lines_.push_back(i_qstr);
+            if(int(lines_.size()) > maximum_lines_) {lines_.pop_front();}
+        }
+
+        if(appendToEnd_)
+        {
+            NQLog("AssemblyDBLoggerModel", NQLog::Debug) << "read_newlines" << ": emitting signal \"refresh_content_view(QStringList)\"";
+            emit refresh_content_view(qstr_list);
+        }
+        else
+        {
+            //Newest lines are displayed first: only the new lines are inserted at the top of the display
+            QStringList qstr_list_reversed;
+            qstr_list_reversed.reserve(qstr_list.size());
+            for(int i=qstr_list.size()-1; i>=0; --i) {qstr_list_reversed.append(qstr_list.at(i));}
+
+            NQLog("AssemblyDBLoggerModel", NQLog::Debug) << "read_newlines" << ": emitting signal \"prepend_content_view(QStringList)\"";
+            emit prepend_content_view(qstr_list_reversed);
+        }
 
-        overwrite_ = false;
         reading_ = false;
     }
 
     return;
 }
 
-//Choose whether the next message will be appended at the beginning or end of the DBLog file
+//Display all lines kept in memory, newest lines last ('End of log file') or first ('Start of log file')
+//Only needed when the display mode changes, new lines are added to the display as they are read
+void AssemblyDBLoggerModel::display_all_lines()
+{
+    QStringList qstr_list;
+    qstr_list.reserve(lines_.size());
+
+    if(appendToEnd_) {for(const auto& i_qstr : lines_) {qstr_list.append(i_qstr);}}
+    else {for(auto it = lines_.rbegin(); it != lines_.rend(); ++it) {qstr_list.append(*it);}}
+
+    NQLog("AssemblyDBLoggerModel", NQLog::Debug) << "display_all_lines" << ": emitting signal \"overwrite_content_view(QStringList)\"";
+    emit overwrite_content_view();
+
+    NQLog("AssemblyDBLoggerModel", NQLog::Debug) << "display_all_lines" << ": emitting signal \"refresh_content_view(QStringList)\"";
+    emit refresh_content_view(qstr_list);
+
+    return;
+}
+
+//Choose whether the newest lines of the DBLog file are displayed at the end or at the beginning of the GUI tab
 void AssemblyDBLoggerModel::setAppendMode(const QString& mode)
 {
+    const bool appendToEnd = appendToEnd_;
+
     if(mode == "End of log file") {appendToEnd_ = true;}
     else if(mode == "Start of log file") {appendToEnd_ = false;}
     else {NQLog("AssemblyDBLoggerModel", NQLog::Warning) << "wrong value for variable \"appendToEnd_\" " << appendToEnd_;}
 
+    if(appendToEnd_ != appendToEnd)
+    {
+        QMutexLocker locker(&mutex_);
+        display_all_lines();
+    }
+
     return;
 }
 
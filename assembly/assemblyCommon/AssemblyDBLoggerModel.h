@@ -27,6 +27,9 @@
 #include <QLocale>
 #include <QTimer>
 #include <QStringList>
+#include <QFileInfo>
+
+#include <deque>
 
 class AssemblyDBLoggerModel : public QObject
 {
@@ -40,6 +43,7 @@ class AssemblyDBLoggerModel : public QObject
         void writeMessage(QString);
         const QString get_dblogfilepath() {return dblogfilepath_;}
         void setOverwritingMode() {overwrite_ = true;}
+        int get_maximum_lines() const {return maximum_lines_;}
 
     protected:
 
@@ -49,10 +53,13 @@ class AssemblyDBLoggerModel : public QObject
         QTimer* timer_;
         bool reading_;
         bool overwrite_;
-        uint last_read_endline_;
+        qint64 read_offset_; //Position in the DBLog file up to which it has been read
+        std::deque<QString> lines_; //Ring of the most recent lines of the DBLog file (oldest first)
+        int maximum_lines_; //Maximum number of lines kept in memory (and displayed)
         int verbosity_;
 
         void writeLogHeader();
+        void display_all_lines();
 
     public slots:
 
@@ -62,6 +69,7 @@ class AssemblyDBLoggerModel : public QObject
     signals:
 
         void refresh_content_view(const QStringList&);
+        void prepend_content_view(const QStringList&);
         void overwrite_content_view();
 };
 
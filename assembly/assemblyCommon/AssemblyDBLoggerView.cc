@@ -13,6 +13,7 @@
 #include <AssemblyDBLoggerView.h>
 
 AssemblyDBLoggerView::AssemblyDBLoggerView(const QString& outputdir_path) :
+maximum_lines_(0),
 outputdir_path_(outputdir_path)
 {
 //--------------------------------------------
@@ -57,7 +58,7 @@ outputdir_path_(outputdir_path)
     // QBoxLayout* editLayout_ = new QBoxLayout(Qt::Horizontal); //The QBoxLayout class lines up child widgets horizontally or vertically
 
     locComboBox_ = new QComboBox; //Multiple choice box
-    locLabel_ = new QLabel(tr("Append the comment at:"));
+    locLabel_ = new QLabel(tr("Display the newest lines at:"));
     locComboBox_->setStyleSheet("QComboBox { background: white; } QComboBox QAbstractItemView {border: 1px solid grey; background: white; selection-background-color: blue; } ");
     locComboBox_->addItem(tr("End of log file"));
     locComboBox_->addItem(tr("Start of log file"));
@@ -144,6 +145,46 @@ void AssemblyDBLoggerView::update_content(const QStringList& qstr_list)
     return;
 }
 
+//Insert the given lines at the top of the logfile content displayed in the GUI tab
+//The maximum number of lines is applied by hand, the viewer would remove the lines at the top (the newest ones)
+void AssemblyDBLoggerView::prepend_content(const QStringList& qstr_list)
+{
+    if(qstr_list.isEmpty()) {return;}
+
+    QTextDocument* document = viewer_->document();
+
+    viewer_->setMaximumBlockCount(0);
+
+    if(document->isEmpty()) {viewer_->setPlainText(qstr_list.join("\n"));}
+    else
+    {
+        QTextCursor cursor(document);
+        cursor.movePosition(QTextCursor::Start);
+        cursor.insertText(qstr_list.join("\n") + "\n");
+    }
+
+    if(maximum_lines_ > 0 && document->blockCount() > maximum_lines_)
+    {
+        QTextCursor cursor(document->findBlockByNumber(maximum_lines_ - 1));
+        cursor.movePosition(QTextCursor::EndOfBlock);
+        cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
+        cursor.removeSelectedText();
+    }
+
+    viewer_->setMaximumBlockCount(maximum_lines_);
+
+    return;
+}
+
+//Limit the number of lines displayed in the GUI tab (oldest lines are removed first)
+void AssemblyDBLoggerView::set_maximum_lines(const int max_lines)
+{
+    maximum_lines_ = max_lines;
+    viewer_->setMaximumBlockCount(max_lines);
+
+    return;
+}
+
 //Prompt dialog box for user to select existing logfile to be loaded
 void AssemblyDBLoggerView::load_logfile()
 {
@@ -198,7 +239,7 @@ void AssemblyDBLoggerView::display_infoTab()
     "<p>The DB log is automatically generated whenever the program is launched <i>(NB: the path to the logfile is printed in the terminal at startup; it is stored in the cache assembly-specific directory)</i>."
     "<br>This log is filled with relevant information related to the assembly procedure, such as: timestamps of the different steps, quality critera for PatRec, etc." 
     "<br>In the future, this file will be uploaded into the central upgrade database.</p>"
-    "<p>The 'Edit Log' functionality allows to interactively prepend or append additional messages to the DB log.</p>"
+    "<p>The 'Edit Log' functionality allows to interactively append additional messages to the DB log. The newest lines can be displayed at the end or at the start of the logfile content.</p>"
     ));
 
     QSpacerItem* horizontalSpacer = new QSpacerItem(3000, 0, QSizePolicy::Minimum, QSizePolicy::Expanding); //Use this to enlarge box width
@@ -33,6 +33,8 @@
 #include <QLabel>
 #include <QComboBox>
 #include <QPlainTextEdit>
+#include <QTextDocument>
+#include <QTextCursor>
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QFrame>
@@ -53,10 +55,12 @@ class AssemblyDBLoggerView : public QWidget
         QPushButton* get_DBLogger_button_save() const {return button_save_;}
         QPushButton* get_DBLogger_button_send() const {return button_send_;}
         QComboBox* get_DBLogger_appendModeBox() const {return locComboBox_;}
+        void set_maximum_lines(const int);
 
     protected:
 
         AssemblyDBLoggerViewer* viewer_;
+        int maximum_lines_;
         const QString outputdir_path_;
 
         QVBoxLayout* mainLayout_;
@@ -81,6 +85,7 @@ class AssemblyDBLoggerView : public QWidget
 
         void messageBoxWriteMessage();
         void update_content(const QStringList&);
+        void prepend_content(const QStringList&);
         void load_logfile();
         void save_logfile();
         void clear_content();
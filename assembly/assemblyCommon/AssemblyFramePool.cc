@@ -0,0 +1,134 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include <AssemblyFramePool.h>
+
+#include <algorithm>
+
+namespace {
+
+  // number of cv::Mat objects referencing the data of mat
+  int reference_count(const cv::Mat& mat)
+  {
+#if CV_MAJOR_VERSION >= 3
+    return (mat.u != nullptr) ? mat.u->refcount : 0;
+#else
+    return (mat.refcount != nullptr) ? *mat.refcount : 0;
+#endif
+  }
+}
+
+AssemblyFramePool::AssemblyFramePool() :
+  frame_cols_(0),
+  next_(0)
+{
+}
+
+void AssemblyFramePool::allocate(const size_t N, const int rows, const int cols, const int type, const size_t step)
+{
+  this->clear();
+
+  // buffer rows padded to the requested step
+  const size_t elem_size = CV_ELEM_SIZE(type);
+  const int buffer_cols = std::max(cols, int((step + elem_size - 1) / elem_size));
+
+  for(size_t i=0; i<N; ++i)
+  {
+    // buffers are allocated by OpenCV, consumers still holding a frame keep it alive after clear()
+    buffers_.emplace_back(cv::Mat(rows, buffer_cols, type));
+    locked_ .emplace_back(false);
+  }
+
+  frame_cols_ = cols;
+}
+
+void AssemblyFramePool::clear()
+{
+  buffers_.clear();
+  locked_ .clear();
+
+  frame_cols_ = 0;
+
+  next_ = 0;
+}
+
+char* AssemblyFramePool::data(const size_t i) const
+{
+  return (char*) buffers_.at(i).data;
+}
+
+int AssemblyFramePool::index(const char* data) const
+{
+  for(size_t i=0; i<buffers_.size(); ++i)
+  {
+    if(((const char*) buffers_.at(i).data) == data){ return int(i); }
+  }
+
+  return -1;
+}
+
+bool AssemblyFramePool::in_use(const size_t i) const
+{
+  // the pool holds one reference
+  return (reference_count(buffers_.at(i)) > 1);
+}
+
+int AssemblyFramePool::next_free()
+{
+  for(size_t j=0; j<buffers_.size(); ++j)
+  {
+    const size_t i = (next_ + j) % buffers_.size();
+
+    if(!locked_.at(i) && !this->in_use(i))
+    {
+      next_ = (i + 1) % buffers_.size();
+
+      return int(i);
+    }
+  }
+
+  return -1;
+}
+
+cv::Mat AssemblyFramePool::frame(const size_t i) const
+{
+  // header sharing the data (and the reference count) of the buffer
+  return buffers_.at(i).colRange(0, frame_cols_);
+}
+
+void AssemblyFramePool::lock(const size_t i)
+{
+  locked_.at(i) = true;
+}
+
+bool AssemblyFramePool::locked(const size_t i) const
+{
+  return locked_.at(i);
+}
+
+std::vector<size_t> AssemblyFramePool::release()
+{
+  std::vector<size_t> v_released;
+
+  for(size_t i=0; i<buffers_.size(); ++i)
+  {
+    if(locked_.at(i) && !this->in_use(i))
+    {
+      locked_.at(i) = false;
+
+      v_released.emplace_back(i);
+    }
+  }
+
+  return v_released;
+}
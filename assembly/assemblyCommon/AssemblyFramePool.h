@@ -0,0 +1,77 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef ASSEMBLYFRAMEPOOL_H
+#define ASSEMBLYFRAMEPOOL_H
+
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+//
+// pool of reference-counted frame buffers shared by a camera and the consumers of its images:
+//   - the camera writes into the buffers of the pool (for the uEye camera, they are the image memories of the capture sequence)
+//   - frame() returns a cv::Mat header on a buffer, which is passed to the consumers without copying the image data
+//   - a buffer is in use as long as a consumer holds a cv::Mat referencing it (OpenCV reference count),
+//     a buffer which was handed out (lock) is returned by release() once all consumers have dropped their references
+//
+// The pool itself is used from the thread of the camera only,
+// the reference counts are changed atomically by OpenCV in the threads of the consumers.
+//
+class AssemblyFramePool
+{
+ public:
+
+  explicit AssemblyFramePool();
+  virtual ~AssemblyFramePool() {}
+
+  // allocates N buffers of rows x cols of type, with at least step bytes per row (e.g. the line pitch required by the camera)
+  void allocate(const size_t N, const int rows, const int cols, const int type, const size_t step=0);
+  void clear();
+
+  size_t size() const { return buffers_.size(); }
+
+  // data pointer of buffer
+  char* data(const size_t) const;
+
+  // index of the buffer with the given data pointer, -1 if not in the pool
+  int index(const char*) const;
+
+  // true if a consumer holds a frame of the buffer
+  bool in_use(const size_t) const;
+
+  // next buffer which is neither in use nor locked (round-robin), -1 if there is none
+  int next_free();
+
+  // frame header on buffer (no copy of the image data)
+  cv::Mat frame(const size_t) const;
+
+  // marks buffer as handed out to the consumers
+  void lock(const size_t);
+
+  bool locked(const size_t) const;
+
+  // buffers handed out whose frames are no longer in use, they are unmarked
+  std::vector<size_t> release();
+
+ protected:
+
+  std::vector<cv::Mat> buffers_;
+  std::vector<bool>    locked_;
+
+  int frame_cols_;
+
+  size_t next_;
+};
+
+#endif // ASSEMBLYFRAMEPOOL_H
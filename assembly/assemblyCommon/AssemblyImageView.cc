@@ -219,7 +219,7 @@ void AssemblyImageView::update_image(const cv::Mat& img, const bool update_image
     cv::Mat img_color;
     cv::cvtColor(img, img_color, cv::COLOR_GRAY2BGR);
 
-    image_ = img_color.clone();
+    image_ = img_color;
   }
   else
   {
@@ -24,6 +24,20 @@ AssemblyObjectAligner::AssemblyObjectAligner(const LStepExpressMotionManager* co
 
  , motion_manager_(motion_manager)
  , motion_manager_enabled_(false)
+
+ , pipelined_(false)
+ , prefetch_enabled_(false)
+ , prefetch_active_(false)
+ , prefetch_moving_(false)
+ , prefetch_dX_(0.)
+ , prefetch_dY_(0.)
+ , pending_motion_(false)
+ , pending_dX_(0.)
+ , pending_dY_(0.)
+ , pending_dZ_(0.)
+ , pending_dA_(0.)
+ , patrec_angle_one_valid_(false)
+ , patrec_angle_one_(0.)
 {
   if(motion_manager_ == nullptr)
   {
@@ -45,6 +59,8 @@ AssemblyObjectAligner::AssemblyObjectAligner(const LStepExpressMotionManager* co
   }
   else {
     max_numOfRotations_ = config->getValue<int>("AssemblyObjectAligner_maxNumberOfRotations", 10);
+
+    pipelined_ = config->getValue<bool>("AssemblyObjectAligner_pipelined", false);
   }
 
   qRegisterMetaType<AssemblyObjectAligner::Configuration>("AssemblyObjectAligner::Configuration"); //"After a type has been registered, you can create and destroy objects of that type dynamically at run-time"
@@ -118,9 +134,30 @@ bool AssemblyObjectAligner::Configuration::is_valid() const
 }
 
 void AssemblyObjectAligner::reset()
+{
+  this->reset_iteration();
+
+  // a motion started in advance is no longer followed
+  this->enable_prefetch_motion(false);
+
+  prefetch_moving_ = false;
+  pending_motion_ = false;
+
+  return;
+}
+
+// restart for the next iteration, a motion started in advance is still followed
+void AssemblyObjectAligner::reset_iteration()
 {
   alignment_step_ = 0;
 
+  prefetch_active_ = false;
+  prefetch_dX_ = 0.;
+  prefetch_dY_ = 0.;
+
+  image_x_ = 0.;
+  image_y_ = 0.;
+
   posi_x1_ = 0.;
   posi_y1_ = 0.;
   posi_x2_ = 0.;
@@ -136,6 +173,22 @@ void AssemblyObjectAligner::reset_counter_numOfRotations()
   counter_numOfRotations_ = 0;
 }
 
+void AssemblyObjectAligner::marker_distance(double& dX_1to2, double& dY_1to2, const double patrec_angle) const
+{
+  const double obj_deltaX = this->configuration().object_deltaX;
+  const double obj_deltaY = this->configuration().object_deltaY;
+
+  const AssemblyParameters* const params = AssemblyParameters::instance(false);
+
+  // angle from marker's outer edge to best-match position in the camera ref-frame
+  //   - the 90.0 deg offset corresponds to the angle spanned by the marker (L-shape)
+  const double patrec_angle_full = (patrec_angle + 90.0);
+
+  const double camera_offset_dA = params->get("AngleOfCameraFrameInRefFrame_dA");
+
+  assembly::rotation2D_deg(dX_1to2, dY_1to2, (patrec_angle_full + camera_offset_dA), obj_deltaX, obj_deltaY);
+}
+
 void AssemblyObjectAligner::update_configuration(const AssemblyObjectAligner::Configuration& conf)
 {
   if(conf.is_valid() == false)
@@ -148,6 +201,9 @@ void AssemblyObjectAligner::update_configuration(const AssemblyObjectAligner::Co
 
   configuration_ = conf;
 
+  // the PatRec #1 angle of a previous execution does not apply to a different object
+  patrec_angle_one_valid_ = false;
+
   NQLog("AssemblyObjectAligner", NQLog::Spam) << "update_configuration"
      << ": emitting signal \"configuration_updated\"";
 
@@ -225,6 +281,107 @@ void AssemblyObjectAligner::complete_motion()
   emit motion_completed();
 }
 
+void AssemblyObjectAligner::enable_prefetch_motion(const bool arg)
+{
+  if(arg == prefetch_enabled_)
+  {
+    NQLog("AssemblyObjectAligner", NQLog::Debug) << "enable_prefetch_motion(" << arg << ")"
+       << ": motion-manager for prefetch motions already " << (arg ? "enabled" : "disabled") << ", no action taken";
+
+    return;
+  }
+
+  if(arg)
+  {
+    connect(this, SIGNAL(prefetch_motion_request(double, double, double, double)), motion_manager_, SLOT(moveRelative(double, double, double, double)));
+    connect(motion_manager_, SIGNAL(motion_finished()), this, SLOT(complete_prefetch_motion()));
+
+    prefetch_enabled_ = true;
+  }
+  else
+  {
+    disconnect(this, SIGNAL(prefetch_motion_request(double, double, double, double)), motion_manager_, SLOT(moveRelative(double, double, double, double)));
+    disconnect(motion_manager_, SIGNAL(motion_finished()), this, SLOT(complete_prefetch_motion()));
+
+    prefetch_enabled_ = false;
+  }
+
+  return;
+}
+
+void AssemblyObjectAligner::release_motion_manager()
+{
+  this->disconnect_motion_manager();
+
+  this->enable_prefetch_motion(false);
+
+  prefetch_active_ = false;
+  prefetch_moving_ = false;
+  pending_motion_ = false;
+
+  return;
+}
+
+void AssemblyObjectAligner::prefetch_motion(const double x, const double y)
+{
+  prefetch_active_ = true;
+  prefetch_moving_ = true;
+
+  prefetch_dX_ = x;
+  prefetch_dY_ = y;
+
+  this->enable_prefetch_motion(true);
+
+  NQLog("AssemblyObjectAligner", NQLog::Spam) << "prefetch_motion"
+     << ": emitting signal \"prefetch_motion_request(" << x << ", " << y << ", 0, 0)\"";
+
+  emit prefetch_motion_request(x, y, 0.0, 0.0);
+}
+
+void AssemblyObjectAligner::complete_prefetch_motion()
+{
+  this->enable_prefetch_motion(false);
+
+  prefetch_moving_ = false;
+
+  if(pending_motion_)
+  {
+    pending_motion_ = false;
+
+    this->move_after_prefetch(pending_dX_, pending_dY_, pending_dZ_, pending_dA_);
+  }
+
+  return;
+}
+
+void AssemblyObjectAligner::move_after_prefetch(const double x, const double y, const double z, const double a)
+{
+  // the motion started in advance has to be completed first,
+  // the motion-manager only reports the end of its queue
+  if(prefetch_moving_)
+  {
+    pending_motion_ = true;
+
+    pending_dX_ = x;
+    pending_dY_ = y;
+    pending_dZ_ = z;
+    pending_dA_ = a;
+
+    return;
+  }
+
+  if((x == 0.) && (y == 0.) && (z == 0.) && (a == 0.))
+  {
+    this->complete_motion();
+  }
+  else
+  {
+    this->move_relative(x, y, z, a);
+  }
+
+  return;
+}
+
 void AssemblyObjectAligner::launch_next_alignment_step()
 {
   NQLog("AssemblyObjectAligner", NQLog::Spam) << "launch_next_alignment_step"
@@ -306,12 +463,28 @@ void AssemblyObjectAligner::run_alignment(const double patrec_dX, const double p
   {
     NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]";
 
+    image_x_ = motion_manager_->get_position_X();
+    image_y_ = motion_manager_->get_position_Y();
+
     NQLog("AssemblyObjectAligner", NQLog::Spam) << "run_alignment: step [" << alignment_step_ << "]"
        << ": emitting signal \"PatRec_request\"";
 
     ++alignment_step_;
 
     emit PatRec_request(this->configuration().PatRecOne_configuration);
+
+    // pipelined mode: while PatRec #1 runs, move towards the nominal position of marker-2,
+    // predicted with the PatRec #1 angle of the previous iteration
+    if(pipelined_ && patrec_angle_one_valid_)
+    {
+      double dX_1to2, dY_1to2;
+      this->marker_distance(dX_1to2, dY_1to2, patrec_angle_one_);
+
+      NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << (alignment_step_-1) << "]"
+         << ": pipelined mode, moving towards position for PatRec #2 during PatRec #1";
+
+      this->prefetch_motion(dX_1to2, dY_1to2);
+    }
   }
   // Step #2: move to marker-2
   else if(alignment_step_ == 2)
@@ -320,12 +493,15 @@ void AssemblyObjectAligner::run_alignment(const double patrec_dX, const double p
        << ": determining best-match position of PatRec #1";
 
     // marker-1: position of PatRec best-match
-    posi_x1_ = motion_manager_->get_position_X() + patrec_dX;
-    posi_y1_ = motion_manager_->get_position_Y() + patrec_dY;
+    posi_x1_ = image_x_ + patrec_dX;
+    posi_y1_ = image_y_ + patrec_dY;
+
+    patrec_angle_one_ = patrec_angle;
+    patrec_angle_one_valid_ = true;
 
     NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]";
-    NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]: motion-stage X = " << motion_manager_->get_position_X();
-    NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]: motion-stage Y = " << motion_manager_->get_position_Y();
+    NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]: motion-stage X = " << image_x_;
+    NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]: motion-stage Y = " << image_y_;
     NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]";
     NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]: PatRec dX = " << patrec_dX;
     NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]: PatRec dY = " << patrec_dY;
@@ -335,23 +511,20 @@ void AssemblyObjectAligner::run_alignment(const double patrec_dX, const double p
     NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]";
 
     // relative movement to reach the opposite marker
-    const double obj_deltaX = this->configuration().object_deltaX;
-    const double obj_deltaY = this->configuration().object_deltaY;
-
-    const AssemblyParameters* const params = AssemblyParameters::instance(false);
-
-    // angle from marker's outer edge to best-match position in the camera ref-frame
-    //   - the 90.0 deg offset corresponds to the angle spanned by the marker (L-shape)
-    const double patrec_angle_full = (patrec_angle + 90.0);
+    double dX_1to2, dY_1to2;
+    this->marker_distance(dX_1to2, dY_1to2, patrec_angle);
 
-    const double camera_offset_dA = params->get("AngleOfCameraFrameInRefFrame_dA");
+    // combined relative movement (minus the part already applied in pipelined mode)
+    double dX = patrec_dX + dX_1to2;
+    double dY = patrec_dY + dY_1to2;
 
-    double dX_1to2, dY_1to2;
-    assembly::rotation2D_deg(dX_1to2, dY_1to2, (patrec_angle_full + camera_offset_dA), obj_deltaX, obj_deltaY);
+    if(prefetch_active_)
+    {
+      dX -= prefetch_dX_;
+      dY -= prefetch_dY_;
 
-    // combined relative movement
-    const double dX = patrec_dX + dX_1to2;
-    const double dY = patrec_dY + dY_1to2;
+      prefetch_active_ = false;
+    }
 
     NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]"
        << ": moving to position for PatRec #2";
@@ -361,7 +534,7 @@ void AssemblyObjectAligner::run_alignment(const double patrec_dX, const double p
 
     ++alignment_step_;
 
-    this->move_relative(dX, dY, 0.0, 0.0);
+    this->move_after_prefetch(dX, dY, 0.0, 0.0);
   }
   // Step #3: request image on marker-2
   else if(alignment_step_ == 3)
@@ -393,18 +566,31 @@ void AssemblyObjectAligner::run_alignment(const double patrec_dX, const double p
   {
     NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]";
 
+    image_x_ = motion_manager_->get_position_X();
+    image_y_ = motion_manager_->get_position_Y();
+
     NQLog("AssemblyObjectAligner", NQLog::Spam) << "run_alignment: step [" << alignment_step_ << "]"
        << ": emitting signal \"PatRec_request\"";
 
     ++alignment_step_;
 
     emit PatRec_request(this->configuration().PatRecTwo_configuration);
+
+    // pipelined mode: the motion back to marker-1 does not depend on PatRec #2,
+    // start it while PatRec #2 runs (the rotation, if any, is applied afterwards)
+    if(pipelined_ && this->configuration().complete_at_position1)
+    {
+      NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << (alignment_step_-1) << "]"
+         << ": pipelined mode, moving back to best-match position of PatRec #1 during PatRec #2";
+
+      this->prefetch_motion(posi_x1_ - image_x_, posi_y1_ - image_y_);
+    }
   }
   // Step #5: move back to marker-1
   else if(alignment_step_ == 5)
   {
-    posi_x2_ = motion_manager_->get_position_X() + patrec_dX;
-    posi_y2_ = motion_manager_->get_position_Y() + patrec_dY;
+    posi_x2_ = image_x_ + patrec_dX;
+    posi_y2_ = image_y_ + patrec_dY;
 
     NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]";
     NQLog("AssemblyObjectAligner", NQLog::Message) << "run_alignment: step [" << alignment_step_ << "]: position(X1) = " << posi_x1_;
@@ -428,8 +614,17 @@ void AssemblyObjectAligner::run_alignment(const double patrec_dX, const double p
     emit measured_angle(obj_angle_deg_);
 
     // relative (X,Y) movement to reach the opposite marker (marker-1)
-    const double dX = (posi_x1_ - motion_manager_->get_position_X());
-    const double dY = (posi_y1_ - motion_manager_->get_position_Y());
+    // (minus the part already applied in pipelined mode)
+    double dX = (posi_x1_ - image_x_);
+    double dY = (posi_y1_ - image_y_);
+
+    if(prefetch_active_)
+    {
+      dX -= prefetch_dX_;
+      dY -= prefetch_dY_;
+
+      prefetch_active_ = false;
+    }
 
     if(this->configuration().only_measure_angle) //If box "Measure Angle" is ticked --> Only measure angle, don't align motion stage
     {
@@ -449,7 +644,7 @@ void AssemblyObjectAligner::run_alignment(const double patrec_dX, const double p
 
         ++alignment_step_;
 
-        this->move_relative(dX, dY, 0.0, 0.0);
+        this->move_after_prefetch(dX, dY, 0.0, 0.0);
       }
       else //Else, finish there and emit 'execution_completed' signal
       {
@@ -497,11 +692,11 @@ void AssemblyObjectAligner::run_alignment(const double patrec_dX, const double p
           NQLog("AssemblyObjectAligner", NQLog::Spam) << "run_alignment: step [" << alignment_step_ << "]"
              << ": emitting signal \"move_relative(" << dX << ", " << dY << ", 0, " << delta_angle_deg << ")\"";
 
-          this->reset();
+          this->reset_iteration();
 
           ++counter_numOfRotations_;
 
-          this->move_relative(dX, dY, 0.0, delta_angle_deg);
+          this->move_after_prefetch(dX, dY, 0.0, delta_angle_deg);
         }
         else //Else, if exceeds the 'angle_max_dontIter' parameter, rotate motion stage by max. allowed value '+-angle_max_dontIter', and restart routine
         {
@@ -519,11 +714,11 @@ void AssemblyObjectAligner::run_alignment(const double patrec_dX, const double p
           NQLog("AssemblyObjectAligner", NQLog::Spam) << "run_alignment: step [" << alignment_step_ << "]"
              << ": emitting signal \"move_relative(" << dX << ", " << dY << ", 0, " << rot_deg << ")\"";
 
-          this->reset();
+          this->reset_iteration();
 
           ++counter_numOfRotations_;
 
-          this->move_relative(dX, dY, 0.0, rot_deg);
+          this->move_after_prefetch(dX, dY, 0.0, rot_deg);
         }
       }
       else //If a sufficiently small angle value has been found
@@ -542,7 +737,7 @@ void AssemblyObjectAligner::run_alignment(const double patrec_dX, const double p
 
           ++alignment_step_;
 
-          this->move_relative(dX, dY, 0.0, 0.0);
+          this->move_after_prefetch(dX, dY, 0.0, 0.0);
         }
         else //Else stop there, emit 'execution_completed' signal
         {
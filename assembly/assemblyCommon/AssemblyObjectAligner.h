@@ -73,18 +73,48 @@ class AssemblyObjectAligner : public QObject
     // maximum number of allowed iterations in a single alignment execution
     int max_numOfRotations_;
 
+    // pipelined mode: the motion towards the next marker is started
+    // while PatRec runs on the image just acquired, and corrected with the PatRec result
+    bool pipelined_;
+
+    // relative motion started in advance of the PatRec result
+    bool   prefetch_enabled_;
+    bool   prefetch_active_;
+    bool   prefetch_moving_;
+    double prefetch_dX_, prefetch_dY_;
+
+    // motion to be applied once the motion started in advance is completed
+    bool   pending_motion_;
+    double pending_dX_, pending_dY_, pending_dZ_, pending_dA_;
+
+    // PatRec #1 angle of the previous iteration, used to predict the position of marker-2
+    bool   patrec_angle_one_valid_;
+    double patrec_angle_one_;
+
+    void enable_prefetch_motion(const bool);
+
+    void prefetch_motion(const double, const double);
+    void move_after_prefetch(const double, const double, const double, const double);
+
     // transient data (values to be updated during alignment)
     int alignment_step_;
     int counter_numOfRotations_; //Count the number of rotations executed during the alignment routine
 
+    // motion-stage position at the time of the image acquisition
+    double image_x_, image_y_;
+
     double posi_x1_, posi_y1_;
     double posi_x2_, posi_y2_;
 
     double obj_angle_deg_;
 
     void reset();
+    void reset_iteration();
     void reset_counter_numOfRotations();
 
+    // relative movement from marker-1 to marker-2 for a given PatRec #1 angle
+    void marker_distance(double&, double&, const double) const;
+
   public slots:
 
     void update_configuration(const Configuration&);
@@ -100,6 +130,9 @@ class AssemblyObjectAligner : public QObject
     void move_relative(const double, const double, const double, const double);
 
     void complete_motion();
+    void complete_prefetch_motion();
+
+    void release_motion_manager();
 
   signals:
 
@@ -116,6 +149,7 @@ class AssemblyObjectAligner : public QObject
     void PatRec_request(const AssemblyObjectFinderPatRec::Configuration&);
 
     void move_relative_request(const double, const double, const double, const double);
+    void prefetch_motion_request(const double, const double, const double, const double);
 
     void motion_completed();
 
@@ -19,10 +19,16 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <numeric>
 
 #include <QFile>
 #include <QTextStream>
 #include <QMutexLocker>
+#include <QPointer>
 
 #include <TFile.h>
 #include <TGraph.h>
@@ -42,7 +48,15 @@ AssemblyObjectFinderPatRec::AssemblyObjectFinderPatRec(AssemblyThresholder* cons
   save_subdir_images_(true),
 
   updated_img_master_(false),
-  updated_img_master_PatRec_(false)
+  updated_img_master_PatRec_(false),
+
+  parallel_scan_(true),
+  benchmark_scan_(false),
+  rotate_template_(false),
+
+  pyramid_levels_(0),
+  pyramid_candidates_(3),
+  pyramid_minTemplateSize_(16)
 {
   if(thresholder_ == nullptr)
   {
@@ -70,6 +84,13 @@ AssemblyObjectFinderPatRec::AssemblyObjectFinderPatRec(AssemblyThresholder* cons
   mm_per_pixel_row_ = config->getValue<double>("mm_per_pixel_row");
   mm_per_pixel_col_ = config->getValue<double>("mm_per_pixel_col");
 
+  parallel_scan_   = config->getValue<bool>("AssemblyObjectFinderPatRec_parallelScan"  , true);
+  benchmark_scan_  = config->getValue<bool>("AssemblyObjectFinderPatRec_benchmarkScan" , false);
+  rotate_template_ = config->getValue<bool>("AssemblyObjectFinderPatRec_rotateTemplate", false);
+
+  pyramid_levels_     = config->getValue<int>("AssemblyObjectFinderPatRec_pyramidLevels"    , 0);
+  pyramid_candidates_ = config->getValue<int>("AssemblyObjectFinderPatRec_pyramidCandidates", 3);
+
   NQLog("AssemblyObjectFinderPatRec", NQLog::Debug) << "constructed";
 }
 
@@ -217,7 +238,7 @@ void AssemblyObjectFinderPatRec::update_image_master(const cv::Mat& img)
     cv::Mat img_color;
     cv::cvtColor(img, img_color, cv::COLOR_GRAY2BGR);
 
-    img_master_ = img_color.clone();
+    img_master_ = img_color;
   }
 
   if(!updated_img_master_){ updated_img_master_ = true; }
@@ -391,20 +412,15 @@ void AssemblyObjectFinderPatRec::template_matching(const AssemblyObjectFinderPat
   const std::string filepath_img_master_PatRec = output_dir+"/image_master_PatRec.png";
   const std::string filepath_img_templa_PatRec = output_dir+"/image_template_PatRec.png";
 
-  assembly::cv_imwrite(filepath_img_master, img_master);
-
-  NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "template_matching"
-     << ": saved master image to " << filepath_img_master;
-
-  assembly::cv_imwrite(filepath_img_master_PatRec, img_master_PatRec);
+  // output files are written asynchronously, after the results are emitted
+  assembly::AsyncWriter* const writer = assembly::AsyncWriter::instance();
 
-  NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "template_matching"
-     << ": saved PatRec-input master image to " << filepath_img_master_PatRec;
-
-  assembly::cv_imwrite(filepath_img_templa_PatRec, img_templa_PatRec);
+  writer->imwrite(assembly::AsyncWriter::Inputs, filepath_img_master       , img_master);
+  writer->imwrite(assembly::AsyncWriter::Inputs, filepath_img_master_PatRec, img_master_PatRec);
+  writer->imwrite(assembly::AsyncWriter::Inputs, filepath_img_templa_PatRec, img_templa_PatRec);
 
   NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "template_matching"
-     << ": saved PatRec-input template image to " << filepath_img_templa_PatRec;
+     << ": queued PatRec-input master and template images for " << output_dir;
   // -----------
 
   // --- Template Matching
@@ -420,6 +436,9 @@ void AssemblyObjectFinderPatRec::template_matching(const AssemblyObjectFinderPat
     img_templa_PatRec_gs = img_templa_PatRec.clone();
   }
 
+  // rotated templates of previous calls are kept as long as the template does not change
+  if(rotate_template_){ this->update_template_bank(img_templa_PatRec_gs); }
+
   // Template-Matching method for matchTemplate() routine of OpenCV
   // For SQDIFF and SQDIFF_NORMED, the best match is the lowest value; for all the other methods, the best match is the highest value.
   // REF https://docs.opencv.org/2.4/modules/imgproc/doc/object_detection.html?highlight=matchtemplate#matchtemplate
@@ -428,25 +447,54 @@ void AssemblyObjectFinderPatRec::template_matching(const AssemblyObjectFinderPat
 
   NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "template_matching" << ": initiated matching routine with angular scan";
 
+  // image pyramid:
+  //   the angular scans are done on downsampled master and template images,
+  //   only the best candidates of the fine scan are matched at full resolution
+  //   in a small area around their coarse match position
+  cv::Mat img_master_PatRec_coarse = img_master_PatRec;
+  cv::Mat img_templa_PatRec_coarse = img_templa_PatRec_gs;
+
+  int pyramid_levels(0);
+
+  while((pyramid_levels < pyramid_levels_)
+     && ((img_templa_PatRec_coarse.cols / 2) >= pyramid_minTemplateSize_)
+     && ((img_templa_PatRec_coarse.rows / 2) >= pyramid_minTemplateSize_))
+  {
+    cv::pyrDown(img_master_PatRec_coarse, img_master_PatRec_coarse);
+    cv::pyrDown(img_templa_PatRec_coarse, img_templa_PatRec_coarse);
+
+    ++pyramid_levels;
+  }
+
+  const int pyramid_scale = (1 << pyramid_levels);
+
+  if(pyramid_levels > 0)
+  {
+    NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "template_matching"
+       << ": angular scans on images downsampled by a factor " << pyramid_scale
+       << " (master " << img_master_PatRec_coarse.cols << "x" << img_master_PatRec_coarse.rows
+       << ", template " << img_templa_PatRec_coarse.cols << "x" << img_templa_PatRec_coarse.rows << ")";
+  }
+
   // First, get angle-prescan angle: best guess of central value for finer angular scan
   double angle_prescan(-9999.);
 
   if(prescan_angles.size() > 0)
   {
+    std::vector<double>    prescan_FOMs;
+    std::vector<cv::Point> prescan_matchLocs;
+
+    this->PatRec_scan(prescan_FOMs, prescan_matchLocs, img_master_PatRec_coarse, img_templa_PatRec_coarse, prescan_angles, match_method);
+
     double best_FOM(0.);
 
     for(unsigned int i=0; i<prescan_angles.size(); ++i)
     {
-      const double i_angle = prescan_angles.at(i);
-
-      double i_FOM(0.);
-      cv::Point i_matchLoc;
-
-      this->PatRec(i_FOM, i_matchLoc, img_master_PatRec, img_templa_PatRec_gs, i_angle, match_method);
+      const double i_FOM = prescan_FOMs.at(i);
 
       const bool update = (i==0) || (use_minFOM ? (i_FOM < best_FOM) : (i_FOM > best_FOM));
 
-      if(update){ best_FOM = i_FOM; angle_prescan = i_angle; }
+      if(update){ best_FOM = i_FOM; angle_prescan = prescan_angles.at(i); }
     }
   }
   else
@@ -478,32 +526,75 @@ void AssemblyObjectFinderPatRec::template_matching(const AssemblyObjectFinderPat
 
   const int N_rotations = (2 * int((angle_fine_max-angle_fine_min) / angle_fine_step));
 
-  std::vector<std::pair<double, double> > vec_angleNfom;
-  vec_angleNfom.reserve(N_rotations);
-
-  double    best_FOM  (0.);
-  double    best_angle(0.);
-  cv::Point best_matchLoc;
+  // list of angles of the fine scan (same steps as the former sequential loop)
+  std::vector<double> fine_angles;
+  fine_angles.reserve(N_rotations);
 
   for(double angle_fine=angle_fine_min; angle_fine<=angle_fine_max; angle_fine += angle_fine_step)
   {
-    const unsigned int scan_counter = vec_angleNfom.size();
+    fine_angles.emplace_back(angle_prescan + angle_fine);
+  }
 
-    const double i_angle = angle_prescan + angle_fine;
+  std::vector<double>    fine_FOMs;
+  std::vector<cv::Point> fine_matchLocs;
 
-    double i_FOM(0.);
-    cv::Point i_matchLoc;
+  const int64 scan_ticks = cv::getTickCount();
 
-    this->PatRec(i_FOM, i_matchLoc, img_master_PatRec, img_templa_PatRec_gs, i_angle, match_method, output_subdir);
+  double scan_time_sum(0.);
 
-    const bool update = (scan_counter == 0) || (use_minFOM ? (i_FOM < best_FOM) : (i_FOM > best_FOM));
+  if(pyramid_levels == 0)
+  {
+    scan_time_sum = this->PatRec_scan(fine_FOMs, fine_matchLocs, img_master_PatRec, img_templa_PatRec_gs, fine_angles, match_method, output_subdir);
+  }
+  else
+  {
+    scan_time_sum = this->PatRec_scan(fine_FOMs, fine_matchLocs, img_master_PatRec_coarse, img_templa_PatRec_coarse, fine_angles, match_method);
+  }
 
-    if(update)
-    {
-      best_FOM      = i_FOM;
-      best_angle    = i_angle;
-      best_matchLoc = i_matchLoc;
-    }
+  const double scan_time = (cv::getTickCount() - scan_ticks) / cv::getTickFrequency();
+
+  if(benchmark_scan_ && parallel_scan_)
+  {
+    // same scan again, sequentially and without output files, to compare the wall-clock times
+    std::vector<double>    sequential_FOMs;
+    std::vector<cv::Point> sequential_matchLocs;
+
+    const int64 sequential_ticks = cv::getTickCount();
+
+    this->PatRec_scan(sequential_FOMs, sequential_matchLocs,
+                      (pyramid_levels == 0) ? img_master_PatRec    : img_master_PatRec_coarse,
+                      (pyramid_levels == 0) ? img_templa_PatRec_gs : img_templa_PatRec_coarse,
+                      fine_angles, match_method, "", std::vector<cv::Point>(), -1, false);
+
+    const double sequential_time = (cv::getTickCount() - sequential_ticks) / cv::getTickFrequency();
+
+    NQLog("AssemblyObjectFinderPatRec", NQLog::Message) << "template_matching"
+       << ": angular scan of " << fine_angles.size() << " angles took " << scan_time << " s"
+       << " (sequential scan " << sequential_time << " s"
+       << ", speedup " << ((scan_time > 0.) ? (sequential_time / scan_time) : 1.) << ")";
+  }
+  else
+  {
+    // the single-angle times are measured inside the (possibly parallel) scan, their sum is not a sequential time
+    NQLog("AssemblyObjectFinderPatRec", NQLog::Message) << "template_matching"
+       << ": angular scan of " << fine_angles.size() << " angles took " << scan_time << " s"
+       << " (sum of single-angle times " << scan_time_sum << " s)";
+  }
+
+  std::vector<std::pair<double, double> > vec_angleNfom;
+  vec_angleNfom.reserve(fine_angles.size());
+
+  // best match selected in order of increasing angle, independent of the execution order of the scan
+  unsigned int best_idx(0);
+
+  for(unsigned int scan_counter=0; scan_counter<fine_angles.size(); ++scan_counter)
+  {
+    const double i_angle = fine_angles.at(scan_counter);
+    const double i_FOM   = fine_FOMs  .at(scan_counter);
+
+    const bool update = (scan_counter == 0) || (use_minFOM ? (i_FOM < fine_FOMs.at(best_idx)) : (i_FOM > fine_FOMs.at(best_idx)));
+
+    if(update){ best_idx = scan_counter; }
 
     vec_angleNfom.emplace_back(std::make_pair(i_angle, i_FOM));
 
@@ -511,6 +602,71 @@ void AssemblyObjectFinderPatRec::template_matching(const AssemblyObjectFinderPat
        << ": angular scan: [" << scan_counter << "] angle=" << i_angle << ", FOM=" << i_FOM;
   }
 
+  // FOM of the best match (replaced by the full-resolution FOM in case of the image pyramid)
+  double best_FOM = fine_FOMs.at(best_idx);
+
+  double    best_angle    = fine_angles   .at(best_idx);
+  cv::Point best_matchLoc = fine_matchLocs.at(best_idx);
+
+  if(pyramid_levels > 0)
+  {
+    // candidates: the best angles of the coarse scan, refined in order of increasing angle
+    std::vector<unsigned int> candidates(fine_angles.size());
+    std::iota(candidates.begin(), candidates.end(), 0);
+
+    std::stable_sort(candidates.begin(), candidates.end(), [&](const unsigned int a, const unsigned int b)
+    {
+      return use_minFOM ? (fine_FOMs.at(a) < fine_FOMs.at(b)) : (fine_FOMs.at(a) > fine_FOMs.at(b));
+    });
+
+    candidates.resize(std::min(candidates.size(), size_t(std::max(pyramid_candidates_, 1))));
+
+    std::sort(candidates.begin(), candidates.end());
+
+    // search area at full resolution: the coarse match position is known to about one coarse pixel
+    const int search_radius = 2 * pyramid_scale;
+
+    std::vector<double>    refine_angles;
+    std::vector<cv::Point> refine_guessLocs;
+
+    for(const unsigned int idx : candidates)
+    {
+      refine_angles   .emplace_back(fine_angles.at(idx));
+      refine_guessLocs.emplace_back(fine_matchLocs.at(idx) * pyramid_scale);
+    }
+
+    std::vector<double>    refine_FOMs;
+    std::vector<cv::Point> refine_matchLocs;
+
+    const int64 refine_ticks = cv::getTickCount();
+
+    this->PatRec_scan(refine_FOMs, refine_matchLocs, img_master_PatRec, img_templa_PatRec_gs, refine_angles, match_method, output_subdir, refine_guessLocs, search_radius);
+
+    const double refine_time = (cv::getTickCount() - refine_ticks) / cv::getTickFrequency();
+
+    unsigned int refine_best_idx(0);
+
+    for(unsigned int i=0; i<refine_angles.size(); ++i)
+    {
+      const double i_FOM = refine_FOMs.at(i);
+
+      const bool update = (i == 0) || (use_minFOM ? (i_FOM < refine_FOMs.at(refine_best_idx)) : (i_FOM > refine_FOMs.at(refine_best_idx)));
+
+      if(update){ refine_best_idx = i; }
+
+      NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "template_matching"
+         << ": full-resolution refinement: angle=" << refine_angles.at(i) << ", FOM=" << i_FOM;
+    }
+
+    best_FOM      = refine_FOMs     .at(refine_best_idx);
+    best_angle    = refine_angles   .at(refine_best_idx);
+    best_matchLoc = refine_matchLocs.at(refine_best_idx);
+
+    NQLog("AssemblyObjectFinderPatRec", NQLog::Message) << "template_matching"
+       << ": full-resolution refinement of " << refine_angles.size() << " candidates took " << refine_time << " s"
+       << ", best FOM=" << best_FOM;
+  }
+
   NQLog("AssemblyObjectFinderPatRec", NQLog::Message) << "template_matching"
      << ": angular scan completed: best_angle=" << best_angle;
 
@@ -540,52 +696,62 @@ void AssemblyObjectFinderPatRec::template_matching(const AssemblyObjectFinderPat
   // FOM(angle) plot
   if(vec_angleNfom.size() > 0)
   {
-    TCanvas c1("FOM", "Rotation extraction", 200, 10, 700, 500);
+    // the task runs in the writer thread, possibly after the finder is deleted:
+    // the signal is emitted in the thread of the finder, only if the finder still exists
+    const QPointer<AssemblyObjectFinderPatRec> finder(this);
 
-    TGraph gr_scan;
-    for(unsigned int idx=0; idx<vec_angleNfom.size(); ++idx)
+    writer->post(assembly::AsyncWriter::Results, [finder, vec_angleNfom, best_angle, best_FOM, output_dir]()
     {
-      gr_scan.SetPoint(idx, vec_angleNfom.at(idx).first, vec_angleNfom.at(idx).second);
-    }
+      TCanvas c1("FOM", "Rotation extraction", 200, 10, 700, 500);
 
-//    gr_scan.Fit("pol6");
+      TGraph gr_scan;
+      for(unsigned int idx=0; idx<vec_angleNfom.size(); ++idx)
+      {
+        gr_scan.SetPoint(idx, vec_angleNfom.at(idx).first, vec_angleNfom.at(idx).second);
+      }
 
-    gr_scan.Draw("AC*");
-    gr_scan.SetName("PatRec_FOM");
-    gr_scan.GetHistogram()->GetXaxis()->SetTitle("angle (degrees)");
-    gr_scan.GetHistogram()->GetYaxis()->SetTitle("PatRec FOM");
-    gr_scan.GetHistogram()->SetTitle("");
+//      gr_scan.Fit("pol6");
 
-    TGraph gr_best;
-    gr_best.SetPoint(0, best_angle, best_FOM);
-    gr_best.SetMarkerColor(2);
-    gr_best.SetMarkerStyle(22);
-    gr_best.SetMarkerSize(3);
-    gr_best.Draw("PSAME");
-    gr_best.SetName("PatRec_FOM_best");
+      gr_scan.Draw("AC*");
+      gr_scan.SetName("PatRec_FOM");
+      gr_scan.GetHistogram()->GetXaxis()->SetTitle("angle (degrees)");
+      gr_scan.GetHistogram()->GetYaxis()->SetTitle("PatRec FOM");
+      gr_scan.GetHistogram()->SetTitle("");
 
-    const std::string filepath_FOM_base = output_dir+"/RotationExtraction";
+      TGraph gr_best;
+      gr_best.SetPoint(0, best_angle, best_FOM);
+      gr_best.SetMarkerColor(2);
+      gr_best.SetMarkerStyle(22);
+      gr_best.SetMarkerSize(3);
+      gr_best.Draw("PSAME");
+      gr_best.SetName("PatRec_FOM_best");
 
-    const std::string filepath_FOM_png  = filepath_FOM_base+".png";
-    const std::string filepath_FOM_root = filepath_FOM_base+".root";
+      const std::string filepath_FOM_base = output_dir+"/RotationExtraction";
 
-    c1.SaveAs(filepath_FOM_png.c_str());
+      const std::string filepath_FOM_png  = filepath_FOM_base+".png";
+      const std::string filepath_FOM_root = filepath_FOM_base+".root";
 
-    TFile o_file(filepath_FOM_root.c_str(), "recreate");
-    o_file.cd();
-    gr_scan.Write();
-    gr_best.Write();
-    o_file.Close();
+      c1.SaveAs(filepath_FOM_png.c_str());
 
-    NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "template_matching"
-       << ": emitting signal \"PatRec_res_image_angscan(" << filepath_FOM_png << ")\"";
+      TFile o_file(filepath_FOM_root.c_str(), "recreate");
+      o_file.cd();
+      gr_scan.Write();
+      gr_best.Write();
+      o_file.Close();
+
+      // the plot is only shown once the file exists
+      if(finder.isNull()){ return; }
+
+      NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "template_matching"
+         << ": emitting signal \"PatRec_res_image_angscan(" << filepath_FOM_png << ")\"";
 
-    emit PatRec_res_image_angscan(QString::fromStdString(filepath_FOM_png));
+      QMetaObject::invokeMethod(finder.data(), "PatRec_res_image_angscan", Qt::QueuedConnection, Q_ARG(QString, QString::fromStdString(filepath_FOM_png)));
+    });
   }
   // ---
 
   const std::string filepath_img_master_copy = output_dir+"/image_master_PatRec_edited.png";
-  assembly::cv_imwrite(filepath_img_master_copy, img_master_copy);
+  writer->imwrite(assembly::AsyncWriter::Results, filepath_img_master_copy, img_master_copy);
 
   NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "template_matching"
      << ": emitting signal \"PatRec_res_image_master_edited()\"";
@@ -595,17 +761,20 @@ void AssemblyObjectFinderPatRec::template_matching(const AssemblyObjectFinderPat
   // text output file -
   const QString txt_file_path = QString::fromStdString(output_dir+"/PatRec_results.txt");
 
-  QFile txtfile(txt_file_path);
-  if(txtfile.open(QIODevice::WriteOnly | QIODevice::Text) == true)
+  writer->post(assembly::AsyncWriter::Results, [txt_file_path, best_matchLoc, best_angle]()
   {
-    QTextStream txts(&txtfile);
+    QFile txtfile(txt_file_path);
+    if(txtfile.open(QIODevice::WriteOnly | QIODevice::Text) == true)
+    {
+      QTextStream txts(&txtfile);
 
-    txts << "# best_matchLoc.x best_matchLoc.y best_angle\n";
-    txts << best_matchLoc.x << " " << best_matchLoc.y << " " << best_angle << "\n";
-  }
+      txts << "# best_matchLoc.x best_matchLoc.y best_angle\n";
+      txts << best_matchLoc.x << " " << best_matchLoc.y << " " << best_angle << "\n";
+    }
 
-  NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "template_matching"
-     << ": created output file: " << txt_file_path;
+    NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "template_matching"
+       << ": created output file: " << txt_file_path;
+  });
   // ------------------
 
   // PatRec result(s)
@@ -648,7 +817,8 @@ void AssemblyObjectFinderPatRec::template_matching(const AssemblyObjectFinderPat
                 // QString("-- Best match X = ")     + QString::number(best_matchLoc.x) + " (px) \n" +
                 QString("-- Best match X = ")     + QString::number(patrec_dX) + " (mm) \n" +
                 QString("-- Best match Y = ")     + QString::number(patrec_dY) + " (mm) \n" +
-                QString("-- Best match angle = ") + QString::number(best_angle) + " (deg)";
+                QString("-- Best match angle = ") + QString::number(best_angle) + " (deg) \n" +
+                QString("-- Best match FOM = ")   + QString::number(best_FOM);
   emit DBLogMessage(mess_tmp);
 
   emit PatRec_results(patrec_dX, patrec_dY, best_angle);
@@ -669,7 +839,26 @@ void AssemblyObjectFinderPatRec::template_matching(const AssemblyObjectFinderPat
 
 void AssemblyObjectFinderPatRec::PatRec(double& fom, cv::Point& match_loc, const cv::Mat& img_master_PatRec, const cv::Mat& img_templa_PatRec, const double angle, const int match_method, const std::string& out_dir) const
 {
-  // rotated master image
+  this->PatRec(fom, match_loc, img_master_PatRec, img_templa_PatRec, angle, match_method, cv::Point(), -1, out_dir);
+
+  return;
+}
+
+//
+// PatRec restricted to the neighbourhood of an expected match position:
+//   - guess_loc is the expected match position (template top-left corner, in pixels of the master image)
+//   - only matches within search_radius pixels of guess_loc are considered (whole master image if search_radius < 0)
+//
+void AssemblyObjectFinderPatRec::PatRec(double& fom, cv::Point& match_loc, const cv::Mat& img_master_PatRec, const cv::Mat& img_templa_PatRec, const double angle, const int match_method, const cv::Point& guess_loc, const int search_radius, const std::string& out_dir) const
+{
+  if(rotate_template_)
+  {
+    this->PatRec_rotatedTemplate(fom, match_loc, img_master_PatRec, img_templa_PatRec, angle, match_method, guess_loc, search_radius, out_dir);
+
+    return;
+  }
+
+  // rotated master image (search area only)
   cv::Mat img_master_PatRec_rot;
 
   const cv::Point2f src_center(img_master_PatRec.cols/2.0F, img_master_PatRec.rows/2.0F);
@@ -682,26 +871,45 @@ void AssemblyObjectFinderPatRec::PatRec(double& fom, cv::Point& match_loc, const
   //
   const double angle_master = (-1.0 * angle);
 
-  const cv::Mat rot_mat = cv::getRotationMatrix2D(src_center, angle_master, 1.0);
+  // search area in the rotated master image
+  const cv::Rect full_area(0, 0, img_master_PatRec.cols, img_master_PatRec.rows);
+
+  cv::Rect search_area(full_area);
+
+  if(search_radius >= 0)
+  {
+    const cv::Point2f guess_loc_rot = this->RotatePoint(src_center, guess_loc, angle);
+
+    search_area = cv::Rect(int(guess_loc_rot.x) - search_radius, int(guess_loc_rot.y) - search_radius,
+                           img_templa_PatRec.cols + 2*search_radius, img_templa_PatRec.rows + 2*search_radius) & full_area;
+
+    if((search_area.width < img_templa_PatRec.cols) || (search_area.height < img_templa_PatRec.rows)){ search_area = full_area; }
+  }
+
+  cv::Mat rot_mat = cv::getRotationMatrix2D(src_center, angle_master, 1.0);
+
+  // shift the origin to the top-left corner of the search area
+  rot_mat.at<double>(0, 2) -= search_area.x;
+  rot_mat.at<double>(1, 2) -= search_area.y;
 
   const cv::Scalar avgPixelIntensity = cv::mean(img_master_PatRec);
 
-  warpAffine(img_master_PatRec, img_master_PatRec_rot, rot_mat, img_master_PatRec.size(), cv::INTER_NEAREST, cv::BORDER_CONSTANT, avgPixelIntensity);
+  warpAffine(img_master_PatRec, img_master_PatRec_rot, rot_mat, search_area.size(), cv::INTER_NEAREST, cv::BORDER_CONSTANT, avgPixelIntensity);
 
-  if(out_dir != "")
+  if((out_dir != "") && assembly::AsyncWriter::instance()->enabled(assembly::AsyncWriter::Debug))
   {
     const std::string filepath_img_master_PatRec_rot = out_dir+"/image_master_PatRec_Rotation_"+std::to_string(angle_master)+".png";
 
-    assembly::cv_imwrite(filepath_img_master_PatRec_rot, img_master_PatRec_rot);
+    assembly::AsyncWriter::instance()->imwrite(assembly::AsyncWriter::Debug, filepath_img_master_PatRec_rot, img_master_PatRec_rot);
 
     NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "PatRec"
-       << ": saved rotated input master image for PatRec to " << filepath_img_master_PatRec_rot;
+       << ": queued rotated input master image for PatRec for " << filepath_img_master_PatRec_rot;
   }
   // -----------
 
   // matrix with PatRec Figure-Of-Merit values
   cv::Mat result_mat;
-  result_mat.create((img_master_PatRec.rows-img_templa_PatRec.rows+1), (img_master_PatRec.cols-img_templa_PatRec.cols+1), CV_32FC1);
+  result_mat.create((img_master_PatRec_rot.rows-img_templa_PatRec.rows+1), (img_master_PatRec_rot.cols-img_templa_PatRec.cols+1), CV_32FC1);
 
   matchTemplate(img_master_PatRec_rot, img_templa_PatRec, result_mat, match_method);
 
@@ -718,11 +926,263 @@ void AssemblyObjectFinderPatRec::PatRec(double& fom, cv::Point& match_loc, const
 
   // convert match-loc val of rotated  master image
   // to pixel-coordinates  in original master image
+  match_loc += search_area.tl();
   match_loc = this->RotatePoint(src_center, match_loc, angle_master);
 
   return;
 }
 
+//
+// PatRec with the template rotated instead of the master image:
+//   - the template is rotated by "angle" on a canvas large enough to contain it,
+//     the corners of the canvas not covered by the template are excluded from the comparison by a mask
+//   - rotated templates are taken from the template bank, so each angle is only computed once per template
+//
+void AssemblyObjectFinderPatRec::PatRec_rotatedTemplate(double& fom, cv::Point& match_loc, const cv::Mat& img_master_PatRec, const cv::Mat& img_templa_PatRec, const double angle, const int match_method, const cv::Point& guess_loc, const int search_radius, const std::string& out_dir) const
+{
+  const RotatedTemplate rot_templa = this->rotated_template(img_templa_PatRec, angle);
+
+  // search area in the master image (position of the canvas of the rotated template)
+  const cv::Rect full_area(0, 0, img_master_PatRec.cols, img_master_PatRec.rows);
+
+  cv::Rect search_area(full_area);
+
+  if(search_radius >= 0)
+  {
+    const cv::Point guess_loc_canvas = guess_loc - cv::Point(rot_templa.corner);
+
+    search_area = cv::Rect(guess_loc_canvas.x - search_radius, guess_loc_canvas.y - search_radius,
+                           rot_templa.image.cols + 2*search_radius, rot_templa.image.rows + 2*search_radius) & full_area;
+
+    if((search_area.width < rot_templa.image.cols) || (search_area.height < rot_templa.image.rows)){ search_area = full_area; }
+  }
+
+  if((out_dir != "") && assembly::AsyncWriter::instance()->enabled(assembly::AsyncWriter::Debug))
+  {
+    const std::string filepath_img_templa_PatRec_rot = out_dir+"/image_template_PatRec_Rotation_"+std::to_string(angle)+".png";
+
+    assembly::AsyncWriter::instance()->imwrite(assembly::AsyncWriter::Debug, filepath_img_templa_PatRec_rot, rot_templa.image);
+
+    NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "PatRec"
+       << ": queued rotated input template image for PatRec for " << filepath_img_templa_PatRec_rot;
+  }
+  // -----------
+
+  // matrix with PatRec Figure-Of-Merit values
+  cv::Mat result_mat;
+
+  this->matchTemplate_masked(img_master_PatRec(search_area), rot_templa.image, rot_templa.mask, result_mat, match_method);
+
+  double minVal, maxVal;
+  cv::Point minLoc, maxLoc;
+
+  minMaxLoc(result_mat, &minVal, &maxVal, &minLoc, &maxLoc, cv::Mat());
+
+  const bool use_minFOM = ((match_method  == CV_TM_SQDIFF) || (match_method == CV_TM_SQDIFF_NORMED));
+
+  if(use_minFOM){ match_loc = minLoc; fom = minVal; }
+  else          { match_loc = maxLoc; fom = maxVal; }
+  // -----------
+
+  // convert position of the canvas of the rotated template
+  // to position of the (rotated) top-left corner of the template in the master image
+  match_loc += search_area.tl() + cv::Point(rot_templa.corner);
+
+  return;
+}
+
+//
+// rotated template and its mask from the template bank, computed on first use
+//
+AssemblyObjectFinderPatRec::RotatedTemplate AssemblyObjectFinderPatRec::rotated_template(const cv::Mat& img_templa_PatRec, const double angle) const
+{
+  const TemplateBankKey key(img_templa_PatRec.cols, img_templa_PatRec.rows, std::llround(angle * 1e6));
+
+  {
+    QMutexLocker ml(&template_bank_mutex_);
+
+    const auto it = template_bank_.find(key);
+    if(it != template_bank_.end()){ return it->second; }
+  }
+
+  const cv::Point2f templa_center(img_templa_PatRec.cols/2.0F, img_templa_PatRec.rows/2.0F);
+
+  cv::Mat rot_mat = cv::getRotationMatrix2D(templa_center, angle, 1.0);
+
+  // canvas: bounding box of the rotated template
+  const cv::Rect canvas = cv::RotatedRect(templa_center, img_templa_PatRec.size(), -angle).boundingRect();
+
+  rot_mat.at<double>(0, 2) += (canvas.width  - img_templa_PatRec.cols) / 2.0;
+  rot_mat.at<double>(1, 2) += (canvas.height - img_templa_PatRec.rows) / 2.0;
+
+  RotatedTemplate rot_templa;
+
+  warpAffine(img_templa_PatRec, rot_templa.image, rot_mat, canvas.size(), cv::INTER_NEAREST, cv::BORDER_CONSTANT, cv::Scalar(0));
+
+  const cv::Mat mask_ones(img_templa_PatRec.size(), img_templa_PatRec.type(), cv::Scalar::all(1));
+
+  warpAffine(mask_ones, rot_templa.mask, rot_mat, canvas.size(), cv::INTER_NEAREST, cv::BORDER_CONSTANT, cv::Scalar(0));
+
+  // position of the top-left corner of the template on the canvas
+  rot_templa.corner = cv::Point2f(rot_mat.at<double>(0, 2), rot_mat.at<double>(1, 2));
+
+  QMutexLocker ml(&template_bank_mutex_);
+
+  template_bank_[key] = rot_templa;
+
+  return rot_templa;
+}
+
+//
+// clears the template bank if the template differs from the one the bank was made for
+//
+void AssemblyObjectFinderPatRec::update_template_bank(const cv::Mat& img_templa_PatRec)
+{
+  QMutexLocker ml(&template_bank_mutex_);
+
+  const bool same_template = (template_bank_source_.size() == img_templa_PatRec.size())
+                          && (template_bank_source_.type() == img_templa_PatRec.type())
+                          && (cv::norm(template_bank_source_, img_templa_PatRec, cv::NORM_INF) == 0.);
+
+  if(same_template){ return; }
+
+  template_bank_.clear();
+  template_bank_source_ = img_templa_PatRec.clone();
+
+  NQLog("AssemblyObjectFinderPatRec", NQLog::Spam) << "update_template_bank"
+     << ": new template image, cleared bank of rotated templates";
+}
+
+//
+// matchTemplate considering only the template pixels where mask is non-zero;
+// CV_TM_SQDIFF_NORMED is computed from the masked CV_TM_SQDIFF,
+// because OpenCV supports masks only for some of the matching methods;
+// OpenCV 2.4 has no masked matchTemplate: CV_TM_SQDIFF(_NORMED) and CV_TM_CCORR(_NORMED)
+// are computed from correlations with the masked template, the other methods ignore the mask
+//
+void AssemblyObjectFinderPatRec::matchTemplate_masked(const cv::Mat& image, const cv::Mat& templ, const cv::Mat& mask, cv::Mat& result, const int match_method) const
+{
+#if CV_MAJOR_VERSION >= 3
+  if(match_method != CV_TM_SQDIFF_NORMED)
+  {
+    matchTemplate(image, templ, result, match_method, mask);
+
+    return;
+  }
+
+  matchTemplate(image, templ, result, CV_TM_SQDIFF, mask);
+#else
+  const bool sqdiff = (match_method == CV_TM_SQDIFF) || (match_method == CV_TM_SQDIFF_NORMED);
+  const bool ccorr  = (match_method == CV_TM_CCORR ) || (match_method == CV_TM_CCORR_NORMED );
+
+  if((sqdiff == false) && (ccorr == false))
+  {
+    matchTemplate(image, templ, result, match_method);
+
+    return;
+  }
+#endif
+
+  cv::Mat image_f, templ_f, mask_f;
+  image.convertTo(image_f, CV_32F);
+  templ.convertTo(templ_f, CV_32F);
+  mask .convertTo(mask_f , CV_32F);
+
+  // sum of the squared pixels of the image under the mask, for every position of the template
+  cv::Mat image_norm;
+  matchTemplate(image_f.mul(image_f), mask_f, image_norm, CV_TM_CCORR);
+
+  const double templ_norm = cv::sum(templ_f.mul(templ_f).mul(mask_f))[0];
+
+#if CV_MAJOR_VERSION < 3
+  // sum(M*(T-I)^2) = sum(M*I^2) - 2*sum(M*T*I) + sum(M*T^2)
+  cv::Mat cross;
+  matchTemplate(image_f, templ_f.mul(mask_f), cross, CV_TM_CCORR);
+
+  if(sqdiff){ result = image_norm - 2. * cross + templ_norm; }
+  else      { result = cross; }
+
+  if((match_method == CV_TM_SQDIFF) || (match_method == CV_TM_CCORR)){ return; }
+#endif
+
+  image_norm *= templ_norm;
+  cv::sqrt(image_norm, image_norm);
+  image_norm = cv::max(image_norm, FLT_EPSILON);
+
+  cv::divide(result, image_norm, result);
+
+  return;
+}
+
+namespace {
+
+  // one PatRec call per index, results stored by index
+  class PatRecScanBody : public cv::ParallelLoopBody
+  {
+   public:
+    typedef std::function<void(double&, cv::Point&, int)> function_type;
+
+    PatRecScanBody(const function_type& func, std::vector<double>& foms, std::vector<cv::Point>& locs, std::vector<double>& times) :
+      func_(func), foms_(foms), locs_(locs), times_(times) {}
+
+    void operator()(const cv::Range& range) const
+    {
+      for(int i=range.start; i<range.end; ++i)
+      {
+        const int64 ticks = cv::getTickCount();
+
+        func_(foms_[i], locs_[i], i);
+
+        times_[i] = (cv::getTickCount() - ticks) / cv::getTickFrequency();
+      }
+    }
+
+   private:
+    const function_type& func_;
+    std::vector<double>& foms_;
+    std::vector<cv::Point>& locs_;
+    std::vector<double>& times_;
+  };
+}
+
+//
+// evaluates PatRec for every angle, concurrently if parallel_scan_ and parallel are enabled;
+// fom[i] and match_loc[i] belong to angles[i], so the result does not depend on the order of execution;
+// returns the sum of the single-angle execution times
+//
+double AssemblyObjectFinderPatRec::PatRec_scan(std::vector<double>& foms, std::vector<cv::Point>& match_locs, const cv::Mat& img_master_PatRec, const cv::Mat& img_templa_PatRec, const std::vector<double>& angles, const int match_method, const std::string& out_dir, const std::vector<cv::Point>& guess_locs, const int search_radius, const bool parallel) const
+{
+  foms      .assign(angles.size(), 0.);
+  match_locs.assign(angles.size(), cv::Point());
+
+  std::vector<double> times(angles.size(), 0.);
+
+  const PatRecScanBody::function_type func = [&](double& fom, cv::Point& match_loc, const int idx)
+  {
+    if(guess_locs.empty())
+    {
+      this->PatRec(fom, match_loc, img_master_PatRec, img_templa_PatRec, angles.at(idx), match_method, out_dir);
+    }
+    else
+    {
+      this->PatRec(fom, match_loc, img_master_PatRec, img_templa_PatRec, angles.at(idx), match_method, guess_locs.at(idx), search_radius, out_dir);
+    }
+  };
+
+  const PatRecScanBody body(func, foms, match_locs, times);
+
+  if(parallel_scan_ && parallel)
+  {
+    cv::parallel_for_(cv::Range(0, angles.size()), body, angles.size());
+  }
+  else
+  {
+    body(cv::Range(0, angles.size()));
+  }
+
+  return std::accumulate(times.begin(), times.end(), 0.);
+}
+
 cv::Point2f AssemblyObjectFinderPatRec::RotatePoint(const cv::Point2f& p, const double deg) const
 {
   const double rad = deg * (M_PI/180.);
@@ -19,6 +19,9 @@
 #include <QString>
 #include <QMutex>
 
+#include <map>
+#include <tuple>
+
 #include <opencv2/opencv.hpp>
 
 class AssemblyObjectFinderPatRec : public QObject
@@ -88,7 +91,37 @@ class AssemblyObjectFinderPatRec : public QObject
   bool updated_img_master_;
   bool updated_img_master_PatRec_;
 
+  bool parallel_scan_;
+  bool benchmark_scan_;     // repeat the angular scan sequentially to measure the speedup of the parallel scan
+  bool rotate_template_;    // rotate the template instead of the master image
+
+  int pyramid_levels_;     // number of times the images are downsampled for the angular scans, 0 to disable the image pyramid
+  int pyramid_candidates_; // number of angles refined at full resolution
+  int pyramid_minTemplateSize_;
+
+  // bank of rotated templates (key: template cols, template rows, angle in micro-degrees)
+  struct RotatedTemplate {
+    cv::Mat image;
+    cv::Mat mask;
+    cv::Point2f corner; // top-left corner of the template on the canvas of the rotated template
+  };
+
+  typedef std::tuple<int, int, long long> TemplateBankKey;
+
+  mutable QMutex template_bank_mutex_;
+  mutable std::map<TemplateBankKey, RotatedTemplate> template_bank_;
+  cv::Mat template_bank_source_;
+
+  void update_template_bank(const cv::Mat&);
+  RotatedTemplate rotated_template(const cv::Mat&, const double) const;
+
   void PatRec(double&, cv::Point&, const cv::Mat&, const cv::Mat&, const double, const int, const std::string& out_dir="") const;
+  void PatRec(double&, cv::Point&, const cv::Mat&, const cv::Mat&, const double, const int, const cv::Point&, const int, const std::string& out_dir="") const;
+  void PatRec_rotatedTemplate(double&, cv::Point&, const cv::Mat&, const cv::Mat&, const double, const int, const cv::Point&, const int, const std::string& out_dir="") const;
+
+  void matchTemplate_masked(const cv::Mat&, const cv::Mat&, const cv::Mat&, cv::Mat&, const int) const;
+
+  double PatRec_scan(std::vector<double>&, std::vector<cv::Point>&, const cv::Mat&, const cv::Mat&, const std::vector<double>&, const int, const std::string& out_dir="", const std::vector<cv::Point>& guess_locs=std::vector<cv::Point>(), const int search_radius=-1, const bool parallel=true) const;
 
   cv::Point2f RotatePoint(const cv::Point2f&, const double) const;
   cv::Point2f RotatePoint(const cv::Point2f&, const cv::Point2f&, const double) const;
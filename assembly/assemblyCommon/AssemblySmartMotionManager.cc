@@ -102,6 +102,7 @@ void AssemblySmartMotionManager::enable_motion_manager(const bool arg)
     connect(this, SIGNAL(move_absolute_request(double, double, double, double)), motion_manager_, SLOT(moveAbsolute(double, double, double, double)));
 
     connect(this, SIGNAL(motion_request(LStepExpressMotion)), motion_manager_, SLOT(appendMotion(LStepExpressMotion)));
+    connect(this, SIGNAL(motions_request(QQueue<LStepExpressMotion>)), motion_manager_, SLOT(appendMotions(QQueue<LStepExpressMotion>)));
 
     connect(motion_manager_, SIGNAL(motion_finished()), this, SLOT(next_step()));
 
@@ -116,6 +117,7 @@ void AssemblySmartMotionManager::enable_motion_manager(const bool arg)
     disconnect(this, SIGNAL(move_absolute_request(double, double, double, double)), motion_manager_, SLOT(moveAbsolute(double, double, double, double)));
 
     disconnect(this, SIGNAL(motion_request(LStepExpressMotion)), motion_manager_, SLOT(appendMotion(LStepExpressMotion)));
+    disconnect(this, SIGNAL(motions_request(QQueue<LStepExpressMotion>)), motion_manager_, SLOT(appendMotions(QQueue<LStepExpressMotion>)));
 
     disconnect(motion_manager_, SIGNAL(motion_finished()), this, SLOT(next_step()));
 
@@ -162,7 +164,28 @@ void AssemblySmartMotionManager::move_relative(const double dx0, const double dy
 
   motion_index_ = -1;
 
-  this->next_step();
+  // the motions before the smartMove steps do not need a confirmation:
+  // they are sent to the motion manager as one queue and executed back-to-back,
+  // "motion_finished" is only received once the whole queue is completed
+  const int motions_auto_N = motions_.size() - smartMotions_N_;
+
+  if(motions_auto_N > 1)
+  {
+    QQueue<LStepExpressMotion> motions_auto;
+
+    for(int i_mot=0; i_mot<motions_auto_N; ++i_mot){ motions_auto.enqueue(motions_.at(i_mot)); }
+
+    motion_index_ = (motions_auto_N - 1);
+
+    NQLog("AssemblySmartMotionManager", NQLog::Spam) << "move_relative"
+       << ": emitting signal \"motions_request\" (" << motions_auto_N << " motions)";
+
+    emit motions_request(motions_auto);
+  }
+  else
+  {
+    this->next_step();
+  }
 }
 
 void AssemblySmartMotionManager::next_step()
@@ -65,6 +65,7 @@ class AssemblySmartMotionManager : public QObject
   void move_absolute_request(const double, const double, const double, const double);
 
   void motion_request(const LStepExpressMotion&);
+  void motions_request(const QQueue<LStepExpressMotion>&);
 
   void motion_completed();
 };
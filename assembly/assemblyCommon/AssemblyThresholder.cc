@@ -43,7 +43,7 @@ void AssemblyThresholder::update_image_raw(const cv::Mat& img)
     cv::Mat img_color;
     cv::cvtColor(img, img_color, cv::COLOR_GRAY2BGR);
 
-    img_raw_ = img_color.clone();
+    img_raw_ = img_color;
   }
 
   if(updated_img_raw_ == false){ updated_img_raw_ = true ; }
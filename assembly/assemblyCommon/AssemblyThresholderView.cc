@@ -181,7 +181,7 @@ void AssemblyThresholderView::update_image_raw(const cv::Mat& img)
     cv::Mat img_color;
     cv::cvtColor(img, img_color, cv::COLOR_GRAY2BGR);
 
-    imgraw_ = img_color.clone();
+    imgraw_ = img_color;
   }
   else
   {
@@ -202,7 +202,7 @@ void AssemblyThresholderView::update_image_binary(const cv::Mat& img)
     cv::Mat img_color;
     cv::cvtColor(img, img_color, cv::COLOR_GRAY2BGR);
 
-    imgbin_ = img_color.clone();
+    imgbin_ = img_color;
   }
   else
   {
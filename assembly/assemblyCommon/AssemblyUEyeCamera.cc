@@ -77,6 +77,8 @@ AssemblyUEyeCamera::AssemblyUEyeCamera(QObject *parent) : AssemblyVUEyeCamera(pa
 
     ZeroMemory(images_, sizeof(images_));
 
+    droppedFrames_ = 0;
+
     pixelClocks_.clear();
     currentPixelClock_ = 0;
 }
@@ -493,17 +495,33 @@ void AssemblyUEyeCamera::eventHappend()
     if (bufferProps_.width < 1 || bufferProps_.height < 1)
         return;
 
+    this->unlockReleasedBuffers();
+
+    const int index = pool_.index(lastBuffer_);
+    if (index < 0 || pool_.locked(index)) {
+        ++droppedFrames_;
+
+        NQLog("AssemblyUEyeCamera", NQLog::Warning) << "eventHappend"
+           << ": no new frame buffer, frame dropped (" << droppedFrames_ << " frames dropped)";
+        return;
+    }
+
     nNum = getImageNumber(lastBuffer_);
     ret = is_LockSeqBuf(cameraHandle_, nNum, lastBuffer_);
+    if (ret != IS_SUCCESS) {
+        NQLog("AssemblyUEyeCamera", NQLog::Warning) << "eventHappend: is_LockSeqBuf=" << ret << ", no frame emitted";
+        return;
+    }
 
-    memcpy(image_.ptr(), (uchar*)lastBuffer_, bufferProps_.width * bufferProps_.height * 1);
+    // the buffer stays locked until all consumers have dropped the frame
+    pool_.lock(index);
 
-    is_UnlockSeqBuf(cameraHandle_, nNum, lastBuffer_);
+    const cv::Mat frame = pool_.frame(index);
 
     NQLog("AssemblyUEyeCamera", NQLog::Debug) << "eventHappend"
        << ": emitting signal \"imageAcquired\"";
 
-    emit imageAcquired(image_);
+    emit imageAcquired(frame);
 }
 
 void AssemblyUEyeCamera::acquireImage()
@@ -517,6 +535,20 @@ void AssemblyUEyeCamera::acquireImage()
 
   NQLog("AssemblyUEyeCamera", NQLog::Spam) << "acquireImage: camera is ready";
 
+  // buffers are also returned to the sequence here: if the consumers hold all of them,
+  // no frame event arrives and eventHappend() never gets to unlock them
+  this->unlockReleasedBuffers();
+
+  if(pool_.next_free() < 0)
+  {
+      ++droppedFrames_;
+
+      NQLog("AssemblyUEyeCamera", NQLog::Warning) << "acquireImage"
+         << ": all frame buffers are in use, frame dropped (" << droppedFrames_ << " frames dropped)";
+
+      return;
+  }
+
   unsigned int ret = is_FreezeVideo(cameraHandle_, IS_DONT_WAIT);
 
   if(ret == IS_SUCCESS)
@@ -527,6 +559,15 @@ void AssemblyUEyeCamera::acquireImage()
   return;
 }
 
+// buffers whose frames were dropped by all consumers go back to the sequence
+void AssemblyUEyeCamera::unlockReleasedBuffers()
+{
+    const std::vector<size_t> released = pool_.release();
+    for (const size_t i : released) {
+        is_UnlockSeqBuf(cameraHandle_, images_[i].nImageSeqNum, images_[i].pBuf);
+    }
+}
+
 int AssemblyUEyeCamera::searchDefaultImageFormats(int supportMask)
 {
     int ret = IS_SUCCESS;
@@ -613,8 +654,6 @@ void AssemblyUEyeCamera::setupCapture()
             break;
         }
 
-        image_.create(bufferProps_.height, bufferProps_.width, bufferProps_.cvimgformat);
-
         allocImages();
     }
 }
@@ -721,33 +760,46 @@ bool AssemblyUEyeCamera::allocImages()
 
     is_ClearSequence(cameraHandle_);
 
+    freeImages();
+
+    nWidth = bufferProps_.width;
+    nHeight = bufferProps_.height;
+
+    if (nAbsPosX) {
+        bufferProps_.width = nWidth = getMaxWidth();
+    }
+    if (nAbsPosY)
+    {
+        bufferProps_.height = nHeight = getMaxHeight();
+    }
+
+    // the image memories are the buffers of the frame pool (lines padded to 4 bytes, like is_AllocImageMem)
+    const size_t nLineBytes = ((nWidth * bufferProps_.bitspp / 8) + 3) / 4 * 4;
+
+    pool_.allocate(sizeof(images_) / sizeof(images_[0]), nHeight, nWidth, bufferProps_.cvimgformat, nLineBytes);
+
     for (unsigned int i = 0; i < sizeof(images_) / sizeof(images_[0]); i++) {
 
-        if (images_[i].pBuf) {
-            is_FreeImageMem (cameraHandle_, images_[i].pBuf, images_[i].nImageID);
-            images_[i].pBuf = nullptr;
-            images_[i].nImageID = 0;
-        }
+        images_[i].pBuf = pool_.data(i);
 
-        nWidth = bufferProps_.width;
-        nHeight = bufferProps_.height;
+        if (is_SetAllocatedImageMem (cameraHandle_, nWidth, nHeight, bufferProps_.bitspp, images_[i].pBuf,
+                                     &images_[i].nImageID) != IS_SUCCESS)
+            return FALSE;
 
-        if (nAbsPosX) {
-            bufferProps_.width = nWidth = getMaxWidth();
-        }
-        if (nAbsPosY)
-        {
-            bufferProps_.height = nHeight = getMaxHeight();
-        }
+        INT nX = 0, nY = 0, nBits = 0, nPitch = 0;
+        is_InquireImageMem (cameraHandle_, images_[i].pBuf, images_[i].nImageID, &nX, &nY, &nBits, &nPitch);
 
-        if (is_AllocImageMem (cameraHandle_, nWidth, nHeight, bufferProps_.bitspp, &images_[i].pBuf,
-                              &images_[i].nImageID) != IS_SUCCESS)
+        if (size_t(nPitch) != pool_.frame(i).step[0]) {
+            NQLog("AssemblyUEyeCamera", NQLog::Critical) << "allocImages: line pitch of image memory (" << nPitch
+               << ") differs from frame buffer (" << pool_.frame(i).step[0] << ")";
             return FALSE;
+        }
+
         if (is_AddToSequence (cameraHandle_, images_[i].pBuf, images_[i].nImageID) != IS_SUCCESS)
             return FALSE;
 
         images_[i].nImageSeqNum = i + 1;
-        images_[i].nBufferSize = nWidth * nHeight * bufferProps_.bitspp / 8;
+        images_[i].nBufferSize = nPitch * nHeight;
     }
 
     return TRUE;
@@ -760,12 +812,20 @@ bool AssemblyUEyeCamera::freeImages()
     {
         if (images_[i].pBuf)
         {
+            if (i < pool_.size() && pool_.locked(i)) {
+                is_UnlockSeqBuf (cameraHandle_, images_[i].nImageSeqNum, images_[i].pBuf);
+            }
+
+            // memory set with is_SetAllocatedImageMem is only released from the driver, the pool owns it
             is_FreeImageMem (cameraHandle_, images_[i].pBuf, images_[i].nImageID);
             images_[i].pBuf = nullptr;
             images_[i].nImageID = 0;
         }
     }
 
+    // frames still held by consumers stay valid
+    pool_.clear();
+
     return true;
 }
 
@@ -14,6 +14,7 @@
 #define ASSEMBLYUEYECAMERA_H
 
 #include <AssemblyVUEyeCamera.h>
+#include <AssemblyFramePool.h>
 #include <uEye.h>
 
 #include <QThread>
@@ -91,6 +92,7 @@ class AssemblyUEyeCamera : public AssemblyVUEyeCamera
     bool allocImages();
     bool freeImages();
     int getImageNumber(char * pBuffer);
+    void unlockReleasedBuffers();
     unsigned int readPixelClock();
     double readExposureTime();
 
@@ -123,7 +125,9 @@ class AssemblyUEyeCamera : public AssemblyVUEyeCamera
     char *lastBuffer_;
     UEYE_IMAGE images_[5];
 
-    cv::Mat image_;
+    // image memories of the capture sequence, frames are emitted without copy
+    AssemblyFramePool pool_;
+    unsigned long droppedFrames_;
 };
 
 #endif // ASSEMBLYUEYECAMERA_H
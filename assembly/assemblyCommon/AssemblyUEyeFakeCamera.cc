@@ -15,10 +15,15 @@
 #include <nqlogger.h>
 
 #include <unistd.h>
+#include <cmath>
+#include <fstream>
+#include <sstream>
 
 AssemblyUEyeFakeCamera::AssemblyUEyeFakeCamera(QObject* parent) :
   AssemblyVUEyeCamera(parent),
-  imageIndex_(0)
+  droppedFrames_(0),
+  imageIndex_(0),
+  zStackOffset_(0.)
 {
     cameraState_ = State::OFF;
 
@@ -51,6 +56,16 @@ AssemblyUEyeFakeCamera::AssemblyUEyeFakeCamera(QObject* parent) :
     imageFilenamesForPixelClock_[4] = filenames;
 
     imageFilenames_ = imageFilenamesForPixelClock_[24];
+
+    ApplicationConfig* config = ApplicationConfig::instance();
+    if(config != nullptr)
+    {
+      const std::string zStackPath = config->getValue("AssemblyUEyeFakeCamera_zstack_path", std::string(""));
+
+      zStackOffset_ = config->getValue<double>("AssemblyUEyeFakeCamera_zstack_offset", 0.);
+
+      if(zStackPath != ""){ loadZStack(zStackPath); }
+    }
 }
 
 AssemblyUEyeFakeCamera::~AssemblyUEyeFakeCamera()
@@ -105,6 +120,8 @@ void AssemblyUEyeFakeCamera::close()
 
     cameraState_ = State::CLOSING;
 
+    pool_.clear();
+
     usleep(500000);
 
     cameraState_ = State::OFF;
@@ -217,16 +234,117 @@ void AssemblyUEyeFakeCamera::setExposureTime(double et)
     }
 }
 
+bool AssemblyUEyeFakeCamera::loadZStack(const std::string& path)
+{
+    zStack_.clear();
+    zStackImages_.clear();
+
+    std::ifstream values(path+"/values.txt");
+    if(!values.is_open())
+    {
+      NQLog("AssemblyUEyeFakeCamera", NQLog::Warning) << "loadZStack"
+         << ": failed to open " << path << "/values.txt, z-stack not loaded";
+
+      return false;
+    }
+
+    std::string line;
+    while(std::getline(values, line))
+    {
+      if(line.empty() || line[0] == '#'){ continue; }
+
+      std::istringstream iss(line);
+
+      int index;
+      double z;
+      if(!(iss >> index >> z)){ continue; }
+
+      zStack_.emplace_back(std::make_pair(z, path+"/AssemblyZFocusFinder_"+std::to_string(index)+".png"));
+    }
+
+    NQLog("AssemblyUEyeFakeCamera", NQLog::Message) << "loadZStack"
+       << ": loaded z-stack of " << zStack_.size() << " images from " << path;
+
+    return !zStack_.empty();
+}
+
+void AssemblyUEyeFakeCamera::setZPositionSource(const std::function<double()>& source)
+{
+    zPositionSource_ = source;
+}
+
 void AssemblyUEyeFakeCamera::acquireImage()
 {
     if(cameraState_ != State::READY){ return; }
 
-    image_ = cv::imread(imageFilenames_[imageIndex_++], CV_LOAD_IMAGE_GRAYSCALE);
+    if(!zStack_.empty() && zPositionSource_)
+    {
+      const double z = zPositionSource_() - zStackOffset_;
+
+      size_t index = 0;
+      for(size_t i=1; i<zStack_.size(); ++i)
+      {
+        if(std::fabs(zStack_[i].first - z) < std::fabs(zStack_[index].first - z)){ index = i; }
+      }
 
-    NQLog("AssemblyUEyeFakeCamera", NQLog::Debug) << "acquireImage"
-       << ": emitting signal \"imageAcquired\"";
+      std::map<size_t, cv::Mat>::const_iterator it = zStackImages_.find(index);
+      if(it == zStackImages_.end())
+      {
+        it = zStackImages_.insert(std::make_pair(index, cv::imread(zStack_[index].second, CV_LOAD_IMAGE_GRAYSCALE))).first;
+      }
 
-    emit imageAcquired(image_);
+      NQLog("AssemblyUEyeFakeCamera", NQLog::Debug) << "acquireImage"
+         << ": z-stack image " << index << " (z=" << zStack_[index].first << ") for z=" << z;
+
+      this->emitFrame(it->second);
+
+      return;
+    }
+
+    const cv::Mat image = cv::imread(imageFilenames_[imageIndex_++], CV_LOAD_IMAGE_GRAYSCALE);
 
     if(imageIndex_ == imageFilenames_.size()){ imageIndex_ = 0; }
+
+    this->emitFrame(image);
+}
+
+void AssemblyUEyeFakeCamera::emitFrame(const cv::Mat& image)
+{
+    if(image.empty())
+    {
+      NQLog("AssemblyUEyeFakeCamera", NQLog::Warning) << "emitFrame"
+         << ": empty input image, no frame emitted";
+
+      return;
+    }
+
+    // same number of buffers as the capture sequence of AssemblyUEyeCamera
+    if((pool_.size() == 0) || (pool_.frame(0).size() != image.size()) || (pool_.frame(0).type() != image.type()))
+    {
+      pool_.allocate(5, image.rows, image.cols, image.type());
+    }
+
+    // buffers handed out before and no longer used by any consumer
+    pool_.release();
+
+    const int index = pool_.next_free();
+    if(index < 0)
+    {
+      ++droppedFrames_;
+
+      NQLog("AssemblyUEyeFakeCamera", NQLog::Warning) << "emitFrame"
+         << ": all frame buffers are in use, frame dropped (" << droppedFrames_ << " frames dropped)";
+
+      return;
+    }
+
+    cv::Mat frame = pool_.frame(index);
+    image.copyTo(frame);
+
+    pool_.lock(index);
+
+    NQLog("AssemblyUEyeFakeCamera", NQLog::Debug) << "emitFrame"
+       << ": frame buffer " << index << ", emitting signal \"imageAcquired\"";
+
+    emit imageAcquired(frame);
 }
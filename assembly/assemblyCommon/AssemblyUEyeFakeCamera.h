@@ -14,9 +14,12 @@
 #define ASSEMBLYUEYEFAKECAMERA_H
 
 #include <AssemblyVUEyeCamera.h>
+#include <AssemblyFramePool.h>
 
 #include <vector>
 #include <map>
+#include <string>
+#include <functional>
 
 #include <opencv2/opencv.hpp>
 
@@ -35,6 +38,10 @@ class AssemblyUEyeFakeCamera : public AssemblyVUEyeCamera
 
   bool isAvailable() const { return true; }
 
+  // recorded z-stack (output directory of AssemblyZFocusFinder): the image closest to the z-position given by source is acquired
+  bool loadZStack(const std::string&);
+  void setZPositionSource(const std::function<double()>&);
+
  public slots:
 
   void open();
@@ -47,11 +54,21 @@ class AssemblyUEyeFakeCamera : public AssemblyVUEyeCamera
 
  protected:
 
-  cv::Mat image_;
+  // copies the image into a buffer of the frame pool (like the camera writing into its image memory) and emits the frame
+  void emitFrame(const cv::Mat&);
+
+  AssemblyFramePool pool_;
+  unsigned long droppedFrames_;
+
   std::vector<std::string> imageFilenames_;
   size_t imageIndex_;
 
   std::map<unsigned int, std::vector<std::string> > imageFilenamesForPixelClock_;
+
+  std::vector<std::pair<double, std::string> > zStack_;
+  std::map<size_t, cv::Mat> zStackImages_;
+  double zStackOffset_;
+  std::function<double()> zPositionSource_;
 };
 
 #endif // ASSEMBLYUEYEFAKECAMERA_H
@@ -11,6 +11,7 @@
 /////////////////////////////////////////////////////////////////////////////////
 
 #include <nqlogger.h>
+#include <ApplicationConfig.h>
 #include <AssemblyUtilities.h>
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 0, 0)
@@ -22,6 +23,9 @@
 #include <QFileInfo>
 #include <QImageReader>
 #include <QMessageBox>
+#include <QMutexLocker>
+
+#include <algorithm>
 
 void assembly::kill_application(const QString& log1, const QString& log2)
 {
@@ -159,3 +163,203 @@ void assembly::rotation2D_deg(double& X_1, double& Y_1, const double angle_deg,
 
   return;
 }
+
+assembly::AsyncWriter* assembly::AsyncWriter::instance()
+{
+  static AsyncWriter writer;
+
+  return &writer;
+}
+
+assembly::AsyncWriter::AsyncWriter() :
+  QThread(),
+
+  verbosity_(Debug),
+  capacity_(64),
+  policy_(DropNewest),
+
+  busy_(false),
+  stop_(false),
+
+  dropped_(0)
+{
+  ApplicationConfig* config = ApplicationConfig::instance();
+  if(config != nullptr)
+  {
+    const std::string policy = config->getValue("AsyncWriter_policy", std::string("dropNewest"));
+
+    Policy policy_enum(DropNewest);
+    if     (policy == "block"     ){ policy_enum = Block; }
+    else if(policy == "dropOldest"){ policy_enum = DropOldest; }
+    else if(policy != "dropNewest")
+    {
+      NQLog("AsyncWriter", NQLog::Warning) << "invalid value of AsyncWriter_policy (" << policy << "), using \"dropNewest\"";
+    }
+
+    this->configure(config->getValue<int>("AsyncWriter_verbosity", Debug), config->getValue<int>("AsyncWriter_queueSize", 64), policy_enum);
+  }
+
+  this->start();
+
+  NQLog("AsyncWriter", NQLog::Debug) << "constructed";
+}
+
+assembly::AsyncWriter::~AsyncWriter()
+{
+  this->shutdown();
+}
+
+void assembly::AsyncWriter::shutdown()
+{
+  // pending tasks are completed before exiting
+  {
+    QMutexLocker ml(&mutex_);
+
+    if(stop_){ return; }
+
+    stop_ = true;
+    queue_changed_.wakeAll();
+  }
+
+  this->wait();
+
+  NQLog("AsyncWriter", NQLog::Debug) << "shutdown"
+     << ": writer thread stopped (" << this->dropped() << " tasks dropped)";
+}
+
+void assembly::AsyncWriter::configure(const int verbosity, const int capacity, const Policy policy)
+{
+  QMutexLocker ml(&mutex_);
+
+  verbosity_ = verbosity;
+  capacity_  = std::max(capacity, 1);
+  policy_    = policy;
+
+  NQLog("AsyncWriter", NQLog::Message) << "configure"
+     << ": verbosity=" << verbosity_ << ", queue size=" << capacity_ << ", policy=" << policy_;
+}
+
+bool assembly::AsyncWriter::enabled(const Level level) const
+{
+  QMutexLocker ml(&mutex_);
+
+  return (level <= verbosity_);
+}
+
+bool assembly::AsyncWriter::accepts(const Level level)
+{
+  QMutexLocker ml(&mutex_);
+
+  if(stop_ || (level > verbosity_)){ return false; }
+
+  if((level != Results) && (policy_ == DropNewest) && (int(queue_.size()) >= capacity_))
+  {
+    ++dropped_;
+
+    NQLog("AsyncWriter", NQLog::Spam) << "accepts: queue full, task dropped";
+
+    return false;
+  }
+
+  return true;
+}
+
+bool assembly::AsyncWriter::post(const Level level, const std::function<void()>& function)
+{
+  QMutexLocker ml(&mutex_);
+
+  if(stop_ || (level > verbosity_)){ return false; }
+
+  while(int(queue_.size()) >= capacity_)
+  {
+    if((level != Results) && (policy_ == DropNewest))
+    {
+      ++dropped_;
+
+      NQLog("AsyncWriter", NQLog::Spam) << "post: queue full, task dropped";
+
+      return false;
+    }
+    else if(policy_ == DropOldest)
+    {
+      const auto it = std::find_if(queue_.begin(), queue_.end(), [](const Task& task){ return (task.level != Results); });
+
+      if(it != queue_.end())
+      {
+        queue_.erase(it);
+
+        ++dropped_;
+
+        NQLog("AsyncWriter", NQLog::Spam) << "post: queue full, oldest task dropped";
+
+        continue;
+      }
+    }
+
+    // backpressure: wait for the writer thread
+    queue_changed_.wait(&mutex_);
+  }
+
+  queue_.emplace_back(Task{level, function});
+
+  queue_changed_.wakeAll();
+
+  return true;
+}
+
+bool assembly::AsyncWriter::imwrite(const Level level, const std::string& path, const cv::Mat& img)
+{
+  // no copy of the image for a task which would be discarded
+  if(this->accepts(level) == false){ return false; }
+
+  const cv::Mat img_copy = img.clone();
+
+  return this->post(level, [path, img_copy](){ assembly::cv_imwrite(path, img_copy); });
+}
+
+void assembly::AsyncWriter::flush()
+{
+  QMutexLocker ml(&mutex_);
+
+  while((queue_.empty() == false) || busy_)
+  {
+    queue_changed_.wait(&mutex_);
+  }
+}
+
+unsigned long assembly::AsyncWriter::dropped() const
+{
+  QMutexLocker ml(&mutex_);
+
+  return dropped_;
+}
+
+void assembly::AsyncWriter::run()
+{
+  QMutexLocker ml(&mutex_);
+
+  while(true)
+  {
+    while(queue_.empty() && (stop_ == false)){ queue_changed_.wait(&mutex_); }
+
+    if(queue_.empty()){ break; }
+
+    const Task task = queue_.front();
+    queue_.pop_front();
+
+    busy_ = true;
+
+    // space in the queue
+    queue_changed_.wakeAll();
+
+    ml.unlock();
+
+    task.function();
+
+    ml.relock();
+
+    busy_ = false;
+
+    queue_changed_.wakeAll();
+  }
+}
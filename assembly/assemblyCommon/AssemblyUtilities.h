@@ -17,9 +17,14 @@
 
 #include <string>
 #include <sstream>
+#include <deque>
+#include <functional>
 
 #include <QString>
 #include <QLineEdit>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
 
 #include <opencv2/opencv.hpp>
 
@@ -54,6 +59,80 @@ namespace assembly {
   // geometry helpers
   void rotation2D_deg(double&, double&, const double, const double, const double);
 
+  //
+  // asynchronous writer of output files (images, plots, text files):
+  //   - tasks are executed in order, on a single thread
+  //   - every task has a level, tasks above the configured verbosity are not executed
+  //   - the number of queued tasks is limited; when the queue is full, a new task
+  //     waits (Block) or a debug/input task is discarded (DropNewest, DropOldest);
+  //     Results tasks are never discarded
+  //
+  class AsyncWriter : public QThread
+  {
+   public:
+
+    enum Level {
+      Results = 1, // results of a routine (annotated images, plots, text files)
+      Inputs  = 2, // input images of a routine
+      Debug   = 3  // intermediate images (e.g. every step of a scan)
+    };
+
+    enum Policy {
+      Block      = 0,
+      DropNewest = 1,
+      DropOldest = 2
+    };
+
+    static AsyncWriter* instance();
+
+    void configure(const int verbosity, const int capacity, const Policy policy);
+
+    bool enabled(const Level) const;
+
+    // false if a task of the given level would be discarded (level above verbosity, or queue full with a drop policy)
+    bool accepts(const Level);
+
+    bool post(const Level, const std::function<void()>&);
+
+    // queues a copy of the image for cv_imwrite
+    bool imwrite(const Level, const std::string&, const cv::Mat&);
+
+    // waits until all queued tasks are done
+    void flush();
+
+    // completes the queued tasks and stops the writer thread, later tasks are discarded;
+    // to be called before the objects used by the tasks are deleted (e.g. at the exit of the application)
+    void shutdown();
+
+    unsigned long dropped() const;
+
+   protected:
+
+    explicit AsyncWriter();
+    virtual ~AsyncWriter();
+
+    void run();
+
+    struct Task {
+      Level level;
+      std::function<void()> function;
+    };
+
+    mutable QMutex mutex_;
+    QWaitCondition queue_changed_;
+
+    std::deque<Task> queue_;
+
+    int    verbosity_;
+    int    capacity_;
+    Policy policy_;
+
+    bool busy_;
+    bool stop_;
+
+    unsigned long dropped_;
+  };
+
 }
 
 template <class T>
@@ -23,6 +23,7 @@
 #include <vector>
 #include <cstdio>
 #include <memory>
+#include <algorithm>
 
 #include <TCanvas.h>
 #include <TGraph.h>
@@ -42,9 +43,16 @@ AssemblyZFocusFinder::AssemblyZFocusFinder(const QString& output_dir_prepath, co
 
  , focus_completed_(false)
 
- , zposi_init_(-9999.)
+ , focus_strategy_(AssemblyZFocusSearch::UniformScan)
+ , focus_coarse_pointN_(7)
+ , focus_precision_(0.005)
+
+ , focus_metric_(LaplacianVariance)
+ , focus_metric_downsampling_(2)
+ , focus_roi_fraction_(1.0)
+ , focus_step_images_(StepImagesDeferred)
 
- , zrelm_index_(0)
+ , zposi_init_(-9999.)
 
  , output_dir_("")
 {
@@ -66,7 +74,45 @@ AssemblyZFocusFinder::AssemblyZFocusFinder(const QString& output_dir_prepath, co
 
   focus_stepsize_min_ = config->getValue<double>("AssemblyZFocusFinder_stepsize_min", 0.005);
 
-  v_zrelm_vals_.clear();
+  const std::string strategy = config->getValue("AssemblyZFocusFinder_strategy", std::string("UniformScan"));
+  if(AssemblyZFocusSearch::strategy_from_name(strategy, focus_strategy_) == false)
+  {
+    NQLog("AssemblyZFocusFinder", NQLog::Warning) << "invalid value of AssemblyZFocusFinder_strategy (" << strategy
+       << "), using " << AssemblyZFocusSearch::strategy_name(focus_strategy_);
+  }
+
+  focus_coarse_pointN_ = config->getValue<int>   ("AssemblyZFocusFinder_coarse_pointN", 7);
+  focus_precision_     = config->getValue<double>("AssemblyZFocusFinder_precision"    , 0.005);
+
+  const std::string metric = config->getValue("AssemblyZFocusFinder_metric", std::string("LaplacianVariance"));
+  if(AssemblyZFocusFinder::metric_from_name(metric, focus_metric_) == false)
+  {
+    NQLog("AssemblyZFocusFinder", NQLog::Warning) << "invalid value of AssemblyZFocusFinder_metric (" << metric
+       << "), using " << AssemblyZFocusFinder::metric_name(focus_metric_);
+  }
+
+  focus_metric_downsampling_ = std::max(1, config->getValue<int>("AssemblyZFocusFinder_metric_downsampling", 2));
+
+  focus_roi_fraction_ = config->getValue<double>("AssemblyZFocusFinder_roi_fraction", 1.0);
+  if((focus_roi_fraction_ <= 0.) || (focus_roi_fraction_ > 1.))
+  {
+    NQLog("AssemblyZFocusFinder", NQLog::Warning) << "invalid value of AssemblyZFocusFinder_roi_fraction (" << focus_roi_fraction_
+       << "), using full image";
+
+    focus_roi_fraction_ = 1.0;
+  }
+
+  const int step_images = config->getValue<int>("AssemblyZFocusFinder_stepImages", StepImagesDeferred);
+  if((step_images < StepImagesNone) || (step_images > StepImagesSync))
+  {
+    NQLog("AssemblyZFocusFinder", NQLog::Warning) << "invalid value of AssemblyZFocusFinder_stepImages (" << step_images
+       << "), images of z-steps will be saved asynchronously";
+  }
+  else
+  {
+    focus_step_images_ = StepImages(step_images);
+  }
+
   v_focus_vals_.clear();
   // --------------
 
@@ -195,6 +241,22 @@ void AssemblyZFocusFinder::update_focus_config(const double zrange, const int po
     emit updated_focus_config();
 }
 
+void AssemblyZFocusFinder::update_focus_strategy(const int strategy)
+{
+    if((strategy < AssemblyZFocusSearch::UniformScan) || (strategy > AssemblyZFocusSearch::HillClimbing))
+    {
+      NQLog("AssemblyZFocusFinder", NQLog::Critical) << "update_focus_strategy"
+         << ": invalid value for auto-focus strategy (" << strategy << "), value not updated";
+
+      return;
+    }
+
+    focus_strategy_ = AssemblyZFocusSearch::Strategy(strategy);
+
+    NQLog("AssemblyZFocusFinder", NQLog::Message) << "update_focus_strategy"
+       << ": updated auto-focus strategy to " << AssemblyZFocusSearch::strategy_name(focus_strategy_);
+}
+
 void AssemblyZFocusFinder::acquire_image()
 {
     if(focus_pointN_ <= 1)
@@ -250,26 +312,21 @@ void AssemblyZFocusFinder::acquire_image()
 
     zposi_init_ = motion_manager_->get_position_Z();
 
-    v_zrelm_vals_.clear();
-
     v_focus_vals_.clear();
 
-    // scan N points around initial position
+    // search N points around initial position
     const double zmin = (zposi_init_ - focus_zrange_);
     const double zmax = (zposi_init_ + focus_zrange_);
 
-    v_zrelm_vals_.emplace_back(zmax - zposi_init_);
+    const int pointN = (focus_strategy_ == AssemblyZFocusSearch::CoarseScanFit) ? std::min(focus_coarse_pointN_, focus_pointN_) : focus_pointN_;
 
-    for(int i=1; i<focus_pointN_; ++i)
-    {
-      v_zrelm_vals_.emplace_back(-1.0 * step_size);
-    }
-
-    zrelm_index_ = -1;
+    focus_search_.start(focus_strategy_, zposi_init_, focus_zrange_, pointN, focus_pointN_max_, std::max(focus_precision_, focus_stepsize_min_));
 
     NQLog("AssemblyZFocusFinder", NQLog::Message) << "acquire_image"
        << ": initialized auto-focusing"
-       << " (z-min=" << zmin << ", z-max=" << zmax << ", steps=" << focus_pointN_ << ")";
+       << " (z-min=" << zmin << ", z-max=" << zmax << ", steps=" << pointN
+       << ", strategy=" << AssemblyZFocusSearch::strategy_name(focus_strategy_)
+       << ", metric=" << AssemblyZFocusFinder::metric_name(focus_metric_) << ")";
 
     NQLog("AssemblyZFocusFinder", NQLog::Spam) << "acquire_image"
        << ": emitting signal \"next_zpoint\"";
@@ -279,20 +336,11 @@ void AssemblyZFocusFinder::acquire_image()
 
 void AssemblyZFocusFinder::test_focus()
 {
-  ++zrelm_index_;
-
-  if(zrelm_index_ < 0)
-  {
-    NQLog("AssemblyZFocusFinder", NQLog::Fatal) << "test_focus"
-       << ": logic error -> negative index for std::vector \"v_zrelm_vals_\", stopping AssemblyZFocusFinder";
-
-    this->disable_motion();
+  double zposi_next(0.);
 
-    return;
-  }
-  else if(zrelm_index_ < int(v_zrelm_vals_.size()))
+  if(focus_search_.next(zposi_next))
   {
-    const double dz = v_zrelm_vals_.at(zrelm_index_);
+    const double dz = (zposi_next - motion_manager_->get_position_Z());
 
     NQLog("AssemblyZFocusFinder", NQLog::Spam) << "test_focus"
        << ": emitting signal \"focus(0, 0, " << dz << ", 0)\"";
@@ -305,7 +353,12 @@ void AssemblyZFocusFinder::test_focus()
     NQLog("AssemblyZFocusFinder", NQLog::Spam) << "test_focus"
        << ": finding best-focus position";
 
-    double zposi_best(zposi_init_);
+    const double zposi_best = focus_search_.best();
+
+    NQLog("AssemblyZFocusFinder", NQLog::Message) << "test_focus"
+       << ": auto-focusing completed (strategy=" << AssemblyZFocusSearch::strategy_name(focus_search_.strategy())
+       << ", measurements=" << v_focus_vals_.size() << "), best-focus z-position=" << zposi_best;
+
     {
       std::unique_ptr<TGraph> zscan_gra(new TGraph(v_focus_vals_.size()));
       zscan_gra->SetName("zfocus_graph");
@@ -314,15 +367,13 @@ void AssemblyZFocusFinder::test_focus()
       zscan_gra->SetMarkerStyle(20);
       zscan_gra->SetMarkerSize(1.25);
 
-      double focus_best(-1.);
-      for(unsigned int i=0; i<v_focus_vals_.size(); ++i)
-      {
-        const double i_zposi = v_focus_vals_.at(i).z_position;
-        const double i_focus = v_focus_vals_.at(i).focus_disc;
-
-        zscan_gra->SetPoint(i, i_zposi, i_focus);
+      // points in order of z-position, the search strategies do not visit them in order
+      std::vector<focus_info> v_focus_vals_sorted(v_focus_vals_);
+      std::sort(v_focus_vals_sorted.begin(), v_focus_vals_sorted.end(), [](const focus_info& a, const focus_info& b){ return (a.z_position < b.z_position); });
 
-        if((i == 0) || (i_focus > focus_best)){ focus_best = i_focus; zposi_best = i_zposi; }
+      for(unsigned int i=0; i<v_focus_vals_sorted.size(); ++i)
+      {
+        zscan_gra->SetPoint(i, v_focus_vals_sorted.at(i).z_position, v_focus_vals_sorted.at(i).focus_disc);
       }
 
       std::unique_ptr<TCanvas> zscan_can(new TCanvas());
@@ -395,14 +446,12 @@ void AssemblyZFocusFinder::emergencyStop()
 
   this->disable_motion();
 
-  v_zrelm_vals_.clear();
+  focus_search_.reset();
 
   v_focus_vals_.clear();
 
   focus_completed_ = false;
 
-  zrelm_index_ = -1;
-
   NQLog("AssemblyZFocusFinder", NQLog::Message) << "emergencyStop"
      << ": emitting signal \"emergencyStopped\"";
 
@@ -421,18 +470,16 @@ void AssemblyZFocusFinder::process_image(const cv::Mat& img)
     this->disable_motion();
 
     // clear internal data members
-    v_zrelm_vals_.clear();
+    focus_search_.reset();
 
     v_focus_vals_.clear();
 
     focus_completed_ = false;
 
-    zrelm_index_ = -1;
-
     // save best-focus image
     const std::string img_outpath = output_dir_+"/AssemblyZFocusFinder_best.png";
 
-    cv::imwrite(img_outpath, img);
+    assembly::AsyncWriter::instance()->imwrite(assembly::AsyncWriter::Results, img_outpath, img);
 
     NQLog("AssemblyZFocusFinder", NQLog::Spam) << "process_image"
        << ": emitting signal \"image_acquired\"";
@@ -443,9 +490,17 @@ void AssemblyZFocusFinder::process_image(const cv::Mat& img)
   {
     // --- generic z-focus step ---
 
-    // save image
+    // save image (the z-step is not delayed by the image output, unless StepImagesSync is used)
     const std::string img_outpath = output_dir_+"/AssemblyZFocusFinder_"+std::to_string(v_focus_vals_.size())+".png";
-    cv::imwrite(img_outpath, img);
+
+    if(focus_step_images_ == StepImagesSync)
+    {
+      cv::imwrite(img_outpath, img);
+    }
+    else if(focus_step_images_ == StepImagesDeferred)
+    {
+      assembly::AsyncWriter::instance()->imwrite(assembly::AsyncWriter::Debug, img_outpath, img);
+    }
 
     // save z-focus info
     AssemblyZFocusFinder::focus_info this_focus;
@@ -464,14 +519,12 @@ void AssemblyZFocusFinder::process_image(const cv::Mat& img)
       this->disable_motion();
 
       // clear internal data members
-      v_zrelm_vals_.clear();
+      focus_search_.reset();
 
       v_focus_vals_.clear();
 
       focus_completed_ = false;
 
-      zrelm_index_ = -1;
-
       NQLog("AssemblyZFocusFinder", NQLog::Spam) << "process_image"
          << ": emitting signal \"image_acquired\"";
 
@@ -485,6 +538,8 @@ void AssemblyZFocusFinder::process_image(const cv::Mat& img)
          << ", focus-value = " << this_focus.focus_disc << "]";
 
       v_focus_vals_.emplace_back(this_focus);
+
+      focus_search_.add(this_focus.z_position, this_focus.focus_disc);
       // ------------------------------
 
       // go to next z-focus step
@@ -501,29 +556,104 @@ void AssemblyZFocusFinder::process_image(const cv::Mat& img)
 
 // \Brief Image-focus discriminant based on Laplacian method in OpenCV
 //        REF: https://docs.opencv.org/2.4/doc/tutorials/imgproc/imgtrans/laplace_operator/laplace_operator.html
-double AssemblyZFocusFinder::image_focus_value(const cv::Mat& img)
+bool AssemblyZFocusFinder::metric_from_name(const std::string& name, FocusMetric& metric)
+{
+  if     (name == "LaplacianVariance")   { metric = LaplacianVariance;    }
+  else if(name == "Tenengrad")           { metric = Tenengrad;            }
+  else if(name == "NormalizedVariance")  { metric = NormalizedVariance;   }
+  else if(name == "LaplacianDownsampled"){ metric = LaplacianDownsampled; }
+  else { return false; }
+
+  return true;
+}
+
+std::string AssemblyZFocusFinder::metric_name(const FocusMetric metric)
+{
+  switch(metric)
+  {
+    case LaplacianVariance   : return "LaplacianVariance";
+    case Tenengrad           : return "Tenengrad";
+    case NormalizedVariance  : return "NormalizedVariance";
+    case LaplacianDownsampled: return "LaplacianDownsampled";
+  }
+
+  return "";
+}
+
+cv::Mat AssemblyZFocusFinder::focus_roi(const cv::Mat& img) const
+{
+  if(focus_roi_fraction_ >= 1.){ return img; }
+
+  // centered region, no copy of the image data
+  const int roi_w = std::max(3, int(img.cols * focus_roi_fraction_));
+  const int roi_h = std::max(3, int(img.rows * focus_roi_fraction_));
+
+  if((roi_w >= img.cols) || (roi_h >= img.rows)){ return img; }
+
+  return img(cv::Rect((img.cols - roi_w) / 2, (img.rows - roi_h) / 2, roi_w, roi_h));
+}
+
+double AssemblyZFocusFinder::image_focus_value(const cv::Mat& img) const
 {
-//  // Remove noise by blurring with a Gaussian filter
-//  cv::Mat img_gaus;
-//  cv::GaussianBlur(img, img_gaus, cv::Size(img.cols, img.rows), 0, 0, cv::BORDER_DEFAULT);
-//
-//  // Convert the image to grayscale
-//  cv::Mat img_gray;
-//  cv::cvtColor(img_gaus, img_gray, CV_BGR2GRAY);
-
-  // Apply laplacian function to GS image
-  cv::Mat img_lap;
-  cv::Laplacian(img, img_lap, CV_64F);
-
-  cv::Mat img_lap_abs;
-//  cv::convertScaleAbs(img_lap, img_lap_abs);
-  img_lap_abs = img_lap.clone();
-
-  // Calculate standard deviation of laplace image
-  cv::Scalar mean, std_dev;
-  cv::meanStdDev(img_lap_abs, mean, std_dev);
-
-  const float value = (std_dev.val[0] * std_dev.val[0]);
+  const cv::Mat img_roi = this->focus_roi(img);
+
+  double value(0.);
+
+  switch(focus_metric_)
+  {
+    case Tenengrad:
+    {
+      cv::Mat img_gx, img_gy;
+      cv::Sobel(img_roi, img_gx, CV_32F, 1, 0, 3);
+      cv::Sobel(img_roi, img_gy, CV_32F, 0, 1, 3);
+
+      value = (cv::mean(img_gx.mul(img_gx) + img_gy.mul(img_gy)).val[0]);
+
+      break;
+    }
+
+    case NormalizedVariance:
+    {
+      cv::Scalar mean, std_dev;
+      cv::meanStdDev(img_roi, mean, std_dev);
+
+      value = (mean.val[0] > 0.) ? (std_dev.val[0] * std_dev.val[0] / mean.val[0]) : 0.;
+
+      break;
+    }
+
+    case LaplacianDownsampled:
+    {
+      cv::Mat img_small;
+      cv::resize(img_roi, img_small, cv::Size(), 1./focus_metric_downsampling_, 1./focus_metric_downsampling_, cv::INTER_AREA);
+
+      cv::Mat img_lap;
+      cv::Laplacian(img_small, img_lap, CV_32F);
+
+      cv::Scalar mean, std_dev;
+      cv::meanStdDev(img_lap, mean, std_dev);
+
+      value = (std_dev.val[0] * std_dev.val[0]);
+
+      break;
+    }
+
+    case LaplacianVariance:
+    default:
+    {
+      // Apply laplacian function to GS image
+      cv::Mat img_lap;
+      cv::Laplacian(img_roi, img_lap, CV_64F);
+
+      // Calculate standard deviation of laplace image
+      cv::Scalar mean, std_dev;
+      cv::meanStdDev(img_lap, mean, std_dev);
+
+      value = (std_dev.val[0] * std_dev.val[0]);
+
+      break;
+    }
+  }
 
   return value;
 }
@@ -14,6 +14,7 @@
 #define ASSEMBLYZFOCUSFINDER_H
 
 #include <AssemblyVUEyeCamera.h>
+#include <AssemblyZFocusSearch.h>
 #include <LStepExpressMotionManager.h>
 
 #include <QObject>
@@ -38,6 +39,34 @@ class AssemblyZFocusFinder : public QObject
     double zrange() const { return focus_zrange_; }
     int    points() const { return focus_pointN_; }
 
+    AssemblyZFocusSearch::Strategy strategy() const { return focus_strategy_; }
+
+    //
+    // focus metrics:
+    //   - LaplacianVariance    : variance of the Laplacian
+    //   - Tenengrad            : mean squared gradient magnitude (Sobel)
+    //   - NormalizedVariance   : variance of the image divided by its mean
+    //   - LaplacianDownsampled : variance of the Laplacian of the downsampled image
+    //
+    enum FocusMetric {
+      LaplacianVariance    = 0,
+      Tenengrad            = 1,
+      NormalizedVariance   = 2,
+      LaplacianDownsampled = 3
+    };
+
+    static bool        metric_from_name(const std::string&, FocusMetric&);
+    static std::string metric_name(const FocusMetric);
+
+    FocusMetric metric() const { return focus_metric_; }
+
+    // output of the image of every z-step
+    enum StepImages {
+      StepImagesNone     = 0, // not saved
+      StepImagesDeferred = 1, // queued to assembly::AsyncWriter
+      StepImagesSync     = 2  // saved before the next step
+    };
+
     struct focus_info
     {
       double z_position;
@@ -62,16 +91,26 @@ class AssemblyZFocusFinder : public QObject
     double focus_zrange_;
     double focus_stepsize_min_;
 
+    AssemblyZFocusSearch::Strategy focus_strategy_;
+    int    focus_coarse_pointN_;
+    double focus_precision_;
+
+    FocusMetric focus_metric_;
+    int         focus_metric_downsampling_;
+    double      focus_roi_fraction_;
+    StepImages  focus_step_images_;
+
     double zposi_init_;
 
-    int zrelm_index_;
+    AssemblyZFocusSearch focus_search_;
 
     std::string output_dir_;
 
-    std::vector<double>     v_zrelm_vals_;
     std::vector<focus_info> v_focus_vals_;
 
-    double image_focus_value(const cv::Mat&);
+    double image_focus_value(const cv::Mat&) const;
+
+    cv::Mat focus_roi(const cv::Mat&) const;
 
   public slots:
 
@@ -79,6 +118,7 @@ class AssemblyZFocusFinder : public QObject
     void disable_motion();
 
     void update_focus_config(const double, const int);
+    void update_focus_strategy(const int);
 
     void acquire_image();
 
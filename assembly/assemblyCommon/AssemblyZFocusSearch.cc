@@ -0,0 +1,356 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <AssemblyZFocusSearch.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+  // 1/golden ratio
+  const double golden_fraction = (std::sqrt(5.) - 1.) / 2.;
+}
+
+bool AssemblyZFocusSearch::strategy_from_name(const std::string& name, Strategy& strategy)
+{
+  if     (name == "UniformScan")  { strategy = UniformScan;   }
+  else if(name == "CoarseScanFit"){ strategy = CoarseScanFit; }
+  else if(name == "GoldenSection"){ strategy = GoldenSection; }
+  else if(name == "HillClimbing") { strategy = HillClimbing;  }
+  else { return false; }
+
+  return true;
+}
+
+std::string AssemblyZFocusSearch::strategy_name(const Strategy strategy)
+{
+  switch(strategy)
+  {
+    case UniformScan  : return "UniformScan";
+    case CoarseScanFit: return "CoarseScanFit";
+    case GoldenSection: return "GoldenSection";
+    case HillClimbing : return "HillClimbing";
+  }
+
+  return "";
+}
+
+AssemblyZFocusSearch::AssemblyZFocusSearch() :
+  strategy_(UniformScan),
+
+  z_center_(0.),
+  z_min_(0.),
+  z_max_(0.),
+  pointN_(0),
+  pointN_max_(0),
+  precision_(0.)
+{
+  this->reset();
+}
+
+void AssemblyZFocusSearch::start(const Strategy strategy, const double z_center, const double z_range, const int pointN, const int pointN_max, const double precision)
+{
+  this->reset();
+
+  strategy_   = strategy;
+  z_center_   = z_center;
+  z_min_      = z_center - z_range;
+  z_max_      = z_center + z_range;
+  pointN_     = std::max(pointN, 2);
+  pointN_max_ = std::max(pointN_max, pointN_);
+  precision_  = precision;
+
+  hc_step_ = z_range / 4.;
+}
+
+void AssemblyZFocusSearch::reset()
+{
+  pending_   = false;
+  pending_z_ = 0.;
+  completed_ = false;
+
+  points_.clear();
+
+  fit_requested_ = false;
+  fit_z_ = 0.;
+
+  gs_stage_ = 0;
+  gs_a_ = gs_b_ = gs_c_ = gs_d_ = 0.;
+  gs_fc_ = gs_fd_ = 0.;
+
+  hc_z_ = 0.;
+  hc_f_ = 0.;
+  hc_step_ = 0.;
+  hc_dir_ = +1;
+  hc_tried_[0] = hc_tried_[1] = false;
+}
+
+bool AssemblyZFocusSearch::next(double& z)
+{
+  if(completed_){ return false; }
+
+  if(pending_ == false)
+  {
+    bool requested(false);
+
+    if(int(points_.size()) < pointN_max_)
+    {
+      switch(strategy_)
+      {
+        case UniformScan  : requested = this->next_UniformScan  (pending_z_); break;
+        case CoarseScanFit: requested = this->next_CoarseScanFit(pending_z_); break;
+        case GoldenSection: requested = this->next_GoldenSection(pending_z_); break;
+        case HillClimbing : requested = this->next_HillClimbing (pending_z_); break;
+      }
+    }
+
+    if(requested == false)
+    {
+      completed_ = true;
+
+      return false;
+    }
+
+    pending_ = true;
+  }
+
+  z = pending_z_;
+
+  return true;
+}
+
+void AssemblyZFocusSearch::add(const double z, const double focus)
+{
+  points_.emplace_back(std::make_pair(z, focus));
+
+  if(pending_ == false){ return; }
+
+  pending_ = false;
+
+  // the state of the search is based on the requested z-positions
+  if(strategy_ == GoldenSection)
+  {
+    if     (gs_stage_ == 0){ gs_fc_ = focus; gs_stage_ = 1; }
+    else if(gs_stage_ == 1){ gs_fd_ = focus; gs_stage_ = 2; }
+    else if(gs_stage_ == 2){ gs_fc_ = focus; }
+    else if(gs_stage_ == 3){ gs_fd_ = focus; }
+  }
+  else if(strategy_ == HillClimbing)
+  {
+    if(points_.size() == 1)
+    {
+      hc_z_ = pending_z_;
+      hc_f_ = focus;
+    }
+    else if(focus > hc_f_)
+    {
+      hc_z_ = pending_z_;
+      hc_f_ = focus;
+
+      // keep going in the same direction, the previous position is worse
+      hc_tried_[(hc_dir_ > 0) ? 0 : 1] = false;
+      hc_tried_[(hc_dir_ > 0) ? 1 : 0] = true;
+    }
+    else
+    {
+      hc_tried_[(hc_dir_ > 0) ? 0 : 1] = true;
+    }
+  }
+}
+
+double AssemblyZFocusSearch::best() const
+{
+  const int idx = this->best_index();
+
+  return (idx < 0) ? z_center_ : points_.at(idx).first;
+}
+
+bool AssemblyZFocusSearch::next_UniformScan(double& z)
+{
+  const int i = points_.size();
+
+  if(i >= pointN_){ return false; }
+
+  z = z_max_ - i * ((z_max_ - z_min_) / double(pointN_ - 1));
+
+  return true;
+}
+
+bool AssemblyZFocusSearch::next_CoarseScanFit(double& z)
+{
+  if(int(points_.size()) < pointN_){ return this->next_UniformScan(z); }
+
+  if(fit_requested_){ return false; }
+
+  // measure at the fitted peak, unless it coincides with a measured point
+  if(this->fit_peak(fit_z_) == false){ return false; }
+
+  for(const auto& point : points_)
+  {
+    if(std::fabs(point.first - fit_z_) < precision_){ return false; }
+  }
+
+  fit_requested_ = true;
+
+  z = fit_z_;
+
+  return true;
+}
+
+bool AssemblyZFocusSearch::next_GoldenSection(double& z)
+{
+  if(gs_stage_ == 0)
+  {
+    gs_a_ = z_min_;
+    gs_b_ = z_max_;
+    gs_c_ = gs_b_ - golden_fraction * (gs_b_ - gs_a_);
+    gs_d_ = gs_a_ + golden_fraction * (gs_b_ - gs_a_);
+
+    z = gs_c_;
+
+    return true;
+  }
+  else if(gs_stage_ == 1)
+  {
+    z = gs_d_;
+
+    return true;
+  }
+
+  // the maximum is in [a, d] if f(c) > f(d), otherwise in [c, b]
+  if(gs_fc_ > gs_fd_)
+  {
+    gs_b_  = gs_d_;
+    gs_d_  = gs_c_;
+    gs_fd_ = gs_fc_;
+    gs_c_  = gs_b_ - golden_fraction * (gs_b_ - gs_a_);
+
+    gs_stage_ = 2;
+  }
+  else
+  {
+    gs_a_  = gs_c_;
+    gs_c_  = gs_d_;
+    gs_fc_ = gs_fd_;
+    gs_d_  = gs_a_ + golden_fraction * (gs_b_ - gs_a_);
+
+    gs_stage_ = 3;
+  }
+
+  if((gs_b_ - gs_a_) < precision_){ return false; }
+
+  z = (gs_stage_ == 2) ? gs_c_ : gs_d_;
+
+  return true;
+}
+
+bool AssemblyZFocusSearch::next_HillClimbing(double& z)
+{
+  if(points_.empty())
+  {
+    z = z_center_;
+
+    return true;
+  }
+
+  while(hc_step_ >= precision_)
+  {
+    // both neighbours are worse: the maximum is closer than the current step
+    if(hc_tried_[0] && hc_tried_[1])
+    {
+      hc_step_ /= 2.;
+
+      hc_tried_[0] = hc_tried_[1] = false;
+
+      continue;
+    }
+
+    if(hc_tried_[(hc_dir_ > 0) ? 0 : 1]){ hc_dir_ = -hc_dir_; }
+
+    const double z_next = this->clamp(hc_z_ + hc_dir_ * hc_step_);
+
+    // edge of the z-range
+    if(std::fabs(z_next - hc_z_) < (0.5 * precision_))
+    {
+      hc_tried_[(hc_dir_ > 0) ? 0 : 1] = true;
+
+      continue;
+    }
+
+    z = z_next;
+
+    return true;
+  }
+
+  return false;
+}
+
+int AssemblyZFocusSearch::best_index() const
+{
+  int idx(-1);
+
+  for(unsigned int i=0; i<points_.size(); ++i)
+  {
+    if((idx < 0) || (points_.at(i).second > points_.at(idx).second)){ idx = i; }
+  }
+
+  return idx;
+}
+
+//
+// position of the peak of a Gaussian through the best point and its two neighbours in z,
+// i.e. the vertex of the parabola through the logarithm of the focus values
+//
+bool AssemblyZFocusSearch::fit_peak(double& z_peak) const
+{
+  std::vector<std::pair<double, double> > sorted(points_);
+  std::sort(sorted.begin(), sorted.end());
+
+  int k(0);
+  for(unsigned int i=1; i<sorted.size(); ++i)
+  {
+    if(sorted.at(i).second > sorted.at(k).second){ k = i; }
+  }
+
+  // maximum at the edge of the z-range
+  if((k == 0) || (k == int(sorted.size()) - 1)){ return false; }
+
+  const double x0 = sorted.at(k-1).first, x1 = sorted.at(k).first, x2 = sorted.at(k+1).first;
+
+  double y0 = sorted.at(k-1).second, y1 = sorted.at(k).second, y2 = sorted.at(k+1).second;
+
+  if((y0 > 0.) && (y1 > 0.) && (y2 > 0.))
+  {
+    y0 = std::log(y0);
+    y1 = std::log(y1);
+    y2 = std::log(y2);
+  }
+
+  const double denom = (x0 - x1) * (x0 - x2) * (x1 - x2);
+
+  if(denom == 0.){ return false; }
+
+  const double A = (x2 * (y1 - y0) + x1 * (y0 - y2) + x0 * (y2 - y1)) / denom;
+  const double B = (x2*x2 * (y0 - y1) + x1*x1 * (y2 - y0) + x0*x0 * (y1 - y2)) / denom;
+
+  if(A >= 0.){ return false; }
+
+  z_peak = -B / (2. * A);
+
+  return ((z_peak > x0) && (z_peak < x2));
+}
+
+double AssemblyZFocusSearch::clamp(const double z) const
+{
+  return std::min(std::max(z, z_min_), z_max_);
+}
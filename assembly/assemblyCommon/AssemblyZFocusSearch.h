@@ -0,0 +1,113 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2017 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ASSEMBLYZFOCUSSEARCH_H
+#define ASSEMBLYZFOCUSSEARCH_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+//
+// search strategy of the auto-focus:
+// decides which z-position is measured next, based on the focus values measured so far
+//
+//   - UniformScan   : N equidistant points over [z-range, z+range], best measured point
+//   - CoarseScanFit : coarse equidistant scan, Gaussian (parabola in log(focus)) fit around the best point,
+//                     followed by one measurement at the fitted peak
+//   - GoldenSection : golden-section search of the maximum until the interval is smaller than the precision
+//   - HillClimbing  : steps from the initial position towards increasing focus values,
+//                     the step is halved around the maximum until it is smaller than the precision
+//
+// The golden-section search and the hill climbing assume a single maximum within the z-range.
+//
+class AssemblyZFocusSearch
+{
+ public:
+
+  enum Strategy {
+    UniformScan   = 0,
+    CoarseScanFit = 1,
+    GoldenSection = 2,
+    HillClimbing  = 3
+  };
+
+  static bool        strategy_from_name(const std::string&, Strategy&);
+  static std::string strategy_name(const Strategy);
+
+  explicit AssemblyZFocusSearch();
+  virtual ~AssemblyZFocusSearch() {}
+
+  // starts a new search around z_center; pointN is the number of points of the (coarse) scan, pointN_max the maximum number of measurements
+  void start(const Strategy, const double z_center, const double z_range, const int pointN, const int pointN_max, const double precision);
+  void reset();
+
+  // next z-position to be measured, false when the search is completed
+  bool next(double&);
+
+  // focus value measured at the z-position
+  void add(const double, const double);
+
+  bool completed() const { return completed_; }
+
+  // best-focus z-position
+  double best() const;
+
+  Strategy strategy() const { return strategy_; }
+
+  const std::vector<std::pair<double, double> >& points() const { return points_; }
+
+ protected:
+
+  bool next_UniformScan  (double&);
+  bool next_CoarseScanFit(double&);
+  bool next_GoldenSection(double&);
+  bool next_HillClimbing (double&);
+
+  int  best_index() const;
+  bool fit_peak(double&) const;
+
+  double clamp(const double) const;
+
+  Strategy strategy_;
+
+  double z_center_;
+  double z_min_;
+  double z_max_;
+  int    pointN_;
+  int    pointN_max_;
+  double precision_;
+
+  bool   pending_;
+  double pending_z_;
+  bool   completed_;
+
+  std::vector<std::pair<double, double> > points_;
+
+  // CoarseScanFit
+  bool   fit_requested_;
+  double fit_z_;
+
+  // GoldenSection
+  int    gs_stage_;
+  double gs_a_, gs_b_, gs_c_, gs_d_;
+  double gs_fc_, gs_fd_;
+
+  // HillClimbing
+  double hc_z_;
+  double hc_f_;
+  double hc_step_;
+  int    hc_dir_;
+  bool   hc_tried_[2];
+};
+
+#endif // ASSEMBLYZFOCUSSEARCH_H
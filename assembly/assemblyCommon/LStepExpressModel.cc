@@ -11,6 +11,7 @@
 /////////////////////////////////////////////////////////////////////////////////
 
 #include <LStepExpressModel.h>
+#include <DeviceWatcher.h>
 #include <nqlogger.h>
 
 #include <QFileInfo>
@@ -32,6 +33,8 @@ LStepExpressModel::LStepExpressModel(
  , updateInterval_(updateInterval)
  , motionUpdateInterval_(motionUpdateInterval)
  , updateCount_(0)
+ , motionWatchInterval_(20)
+ , motionSeen_(false)
 {
     const std::vector<int> allZerosI{ 0, 0, 0, 0 };
     const std::vector<double> allZerosD{ 0.0, 0.0, 0.0, 0.0 };
@@ -52,6 +55,8 @@ LStepExpressModel::LStepExpressModel(
     velocity_ = allZerosD;
     position_ = allZerosD;
 
+    parametersChanged_ = true;
+
     inMotion_ = false;
     isUpdating_ = false;
     isPaused_ = false;
@@ -60,6 +65,10 @@ LStepExpressModel::LStepExpressModel(
     timer_ = new QTimer(this);
     timer_->setInterval(motionUpdateInterval_);
     connect(timer_, SIGNAL(timeout()), this, SLOT(updateMotionInformationFromTimer()));
+
+    motionTimer_ = new QTimer(this);
+    motionTimer_->setInterval(motionWatchInterval_);
+    connect(motionTimer_, SIGNAL(timeout()), this, SLOT(updateMotionState()));
 //    connect(this, SIGNAL(informationChanged()), this, SLOT(updateInformation()));
 }
 
@@ -72,6 +81,8 @@ void LStepExpressModel::renewController(const QString& port)
   if(controller_ != nullptr){ delete controller_; }
 
   controller_ = new LStepExpress_t(port.toStdString(), lstep_ver_.toStdString(), lstep_iver_.toStdString());
+
+  parametersChanged_ = true;
 }
 
 void LStepExpressModel::getStatus(bool& status)
@@ -351,6 +362,8 @@ void LStepExpressModel::setAccelerationJerk(const std::vector<double>& values)
      << "(x=" << values[0] << ", y=" << values[1] << ", z=" << values[2] << ", a=" << values[3] << ")";
 
   controller_->SetAccelerationJerk(values);
+
+  parametersChanged_ = true;
 }
 
 void LStepExpressModel::setAccelerationJerk(const double x, const double y, const double z, const double a)
@@ -377,6 +390,8 @@ void LStepExpressModel::setAccelerationJerk(const unsigned int axis, const doubl
   controller_->SetAccelerationJerk((VLStepExpress::Axis)axis, value);
 
   decelerationJerk_[axis] = value;
+
+  parametersChanged_ = true;
 }
 
 void LStepExpressModel::setDecelerationJerk(const std::vector<double>& values)
@@ -402,6 +417,8 @@ void LStepExpressModel::setDecelerationJerk(const std::vector<double>& values)
      << "(x=" << values[0] << ", y=" << values[1] << ", z=" << values[2] << ", a=" << values[3] << ")";
 
   controller_->SetDecelerationJerk(values);
+
+  parametersChanged_ = true;
 }
 
 void LStepExpressModel::setDecelerationJerk(const double x, const double y, const double z, const double a)
@@ -428,6 +445,8 @@ void LStepExpressModel::setDecelerationJerk(const unsigned int axis, const doubl
   controller_->SetDecelerationJerk((VLStepExpress::Axis)axis, value);
 
   decelerationJerk_[axis] = value;
+
+  parametersChanged_ = true;
 }
 
 void LStepExpressModel::setAcceleration(const std::vector<double>& values)
@@ -453,6 +472,8 @@ void LStepExpressModel::setAcceleration(const std::vector<double>& values)
      << "(x=" << values[0] << ", y=" << values[1] << ", z=" << values[2] << ", a=" << values[3] << ")";
 
   controller_->SetAcceleration(values);
+
+  parametersChanged_ = true;
 }
 
 void LStepExpressModel::setAcceleration(const double x, const double y, const double z, const double a)
@@ -479,6 +500,8 @@ void LStepExpressModel::setAcceleration(const unsigned int axis, const double va
   controller_->SetAcceleration((VLStepExpress::Axis)axis, value);
 
   acceleration_[axis] = value;
+
+  parametersChanged_ = true;
 }
 
 void LStepExpressModel::setDeceleration(const std::vector<double>& values)
@@ -504,6 +527,8 @@ void LStepExpressModel::setDeceleration(const std::vector<double>& values)
      << "(x=" << values[0] << ", y=" << values[1] << ", z=" << values[2] << ", a=" << values[3] << ")";
 
   controller_->SetDeceleration(values);
+
+  parametersChanged_ = true;
 }
 
 void LStepExpressModel::setDeceleration(const double x, const double y, const double z, const double a)
@@ -530,6 +555,8 @@ void LStepExpressModel::setDeceleration(const unsigned int axis, const double va
   controller_->SetDeceleration((VLStepExpress::Axis)axis, value);
 
   deceleration_[axis] = value;
+
+  parametersChanged_ = true;
 }
 
 void LStepExpressModel::setVelocity(const std::vector<double>& values)
@@ -555,6 +582,8 @@ void LStepExpressModel::setVelocity(const std::vector<double>& values)
       << "(x=" << values[0] << ", y=" << values[1] << ", z=" << values[2] << ", a=" << values[3] << ")";
 
   controller_->SetVelocity(values);
+
+  parametersChanged_ = true;
 }
 
 void LStepExpressModel::setVelocity(const double x, const double y, const double z, const double a)
@@ -581,6 +610,8 @@ void LStepExpressModel::setVelocity(const unsigned int axis, const double value)
   controller_->SetVelocity((VLStepExpress::Axis)axis, value);
 
   velocity_[axis] = value;
+
+  parametersChanged_ = true;
 }
 
 void LStepExpressModel::moveRelative(const std::vector<double>& values)
@@ -617,6 +648,8 @@ void LStepExpressModel::moveRelative(const std::vector<double>& values)
 
     inMotion_ = true;
 
+    this->startMotionWatch();
+
     NQLog("LStepExpressModel", NQLog::Spam) << "moveRelative"
        << ": emitting signal \"motionStarted\"";
 
@@ -653,6 +686,8 @@ void LStepExpressModel::moveRelative(const unsigned int axis, const double value
 
     inMotion_ = true;
 
+    this->startMotionWatch();
+
     NQLog("LStepExpressModel", NQLog::Spam) << "moveRelative"
        << ": emitting signal \"motionStarted\"";
 
@@ -694,6 +729,8 @@ void LStepExpressModel::moveAbsolute(const std::vector<double>& values)
 
     inMotion_ = true;
 
+    this->startMotionWatch();
+
     NQLog("LStepExpressModel", NQLog::Spam) << "moveAbsolute"
        << ": emitting signal \"motionStarted\"";
 
@@ -730,6 +767,8 @@ void LStepExpressModel::moveAbsolute(const unsigned int axis, const double value
 
     inMotion_ = true;
 
+    this->startMotionWatch();
+
     NQLog("LStepExpressModel", NQLog::Spam) << "moveAbsolute"
        << ": emitting signal \"motionStarted\"";
 
@@ -770,6 +809,8 @@ void LStepExpressModel::calibrate()
 
     finishedCalibrating_ = true;
 
+    this->startMotionWatch();
+
     NQLog("LStepExpressModel", NQLog::Spam) << "calibrate"
        << ": emitting signal \"motionStarted\"";
 
@@ -803,6 +844,8 @@ void LStepExpressModel::emergencyStop()
        << ": emitting signal \"motionFinished\"";
 
     emit motionFinished();
+
+    this->notifyMotionUpdate();
 }
 
 bool LStepExpressModel::getJoystickEnabled()
@@ -842,6 +885,7 @@ void LStepExpressModel::setAxisEnabled(unsigned int axis, bool enabled)
         controller_->SetPowerAmplifierStatus((VLStepExpress::Axis)axis, temp);
         controller_->SetAxisEnabled((VLStepExpress::Axis)axis, temp);
         axis_[axis] = temp;
+        parametersChanged_ = true;
         updateInformation();
 
         NQLog("LStepExpressModel", NQLog::Debug) << "setAxisEnabled(" << axis << ", " << enabled << ")"
@@ -879,6 +923,7 @@ void LStepExpressModel::setJoystickEnabled(bool enabled)
 
       if(temp2 == 1){controller_->SetJoystickAxisEnabled(ivalues); joystickAxisEnabled_ = ivalues;}
 
+      parametersChanged_ = true;
       updateInformation();
 
       NQLog("LStepExpressModel", NQLog::Debug) << "setJoystickEnabled(" << enabled << ")"
@@ -924,6 +969,8 @@ void LStepExpressModel::setValue(const QString & command, const QString & value)
 
     std::string temp;
     controller_->SetValue(command.toStdString(), value.toStdString());
+
+    parametersChanged_ = true;
 }
 
 void LStepExpressModel::getValue(const QString & command, QString & value)
@@ -956,6 +1003,8 @@ void LStepExpressModel::validConfig()
     NQLog("LStepExpressModel", NQLog::Debug) << "validConfig";
 
     controller_->ValidConfig();
+
+    parametersChanged_ = true;
 }
 
 void LStepExpressModel::validParameter()
@@ -971,6 +1020,8 @@ void LStepExpressModel::validParameter()
     NQLog("LStepExpressModel", NQLog::Debug) << "validParameter";
 
     controller_->ValidParameter();
+
+    parametersChanged_ = true;
 }
 
 void LStepExpressModel::saveConfig()
@@ -1001,6 +1052,8 @@ void LStepExpressModel::reset()
     NQLog("LStepExpressModel", NQLog::Debug) << "reset";
 
     controller_->Reset();
+
+    parametersChanged_ = true;
 }
 
 void LStepExpressModel::initialize()
@@ -1058,9 +1111,14 @@ void LStepExpressModel::initialize()
       joystickEnabled_ = false;
       joystickAxisEnabled_ = allZerosI;
 
+      parametersChanged_ = true;
       updateInformation();
 
       setDeviceState(READY);
+
+      DeviceWatcher::instance()->watch(this, port_, QString::fromStdString(controller_->ioPort()),
+                                       [this](){ detachController(); },
+                                       [this](){ return reattachController(); });
     }
     else
     {
@@ -1073,6 +1131,46 @@ void LStepExpressModel::initialize()
     }
 }
 
+/// Drops the controller after its device file vanished, see DeviceWatcher.
+void LStepExpressModel::detachController()
+{
+    NQLog("LStepExpressModel", NQLog::Warning) << "detachController"
+       << ": device file of controller vanished, closing connection";
+
+    // remember the enabled axes, initialize() disables all of them
+    detachedAxis_ = axis_;
+
+    {
+      QMutexLocker locker(&mutex_);
+
+      delete controller_;
+      controller_ = nullptr;
+    }
+
+    setDeviceState(OFF);
+}
+
+/// Connects to the controller again after it reappeared and enables the axes that were enabled before.
+bool LStepExpressModel::reattachController()
+{
+    if(state_ != OFF){ return (state_ == READY); }
+
+    // browses the ports and checks the controller version
+    initialize();
+
+    if(state_ != READY){ return false; }
+
+    for(unsigned int axis=0; axis<detachedAxis_.size(); ++axis)
+    {
+      if(detachedAxis_[axis] == 1){ setAxisEnabled(axis, true); }
+    }
+
+    NQLog("LStepExpressModel", NQLog::Message) << "reattachController"
+       << ": reconnected to controller on port " << controller_->ioPort();
+
+    return true;
+}
+
 void LStepExpressModel::setDeviceState(State state)
 {
     NQLog("LStepExpressModel", NQLog::Debug) << "setDeviceState";
@@ -1082,12 +1180,14 @@ void LStepExpressModel::setDeviceState(State state)
       state_ = state;
 
       if(state_ == READY){ timer_->start(); }
-      else               { timer_->stop (); }
+      else               { timer_->stop (); motionTimer_->stop(); }
 
       NQLog("LStepExpressModel", NQLog::Debug) << "setDeviceState"
          << ": emitting signal \"deviceStateChanged\"";
 
       emit deviceStateChanged(state);
+
+      this->notifyMotionUpdate();
     }
 }
 
@@ -1117,46 +1217,63 @@ void LStepExpressModel::updateInformation()
     std::vector<int> ivalues;
     std::vector<double> dvalues;
 
-    controller_->GetAxisEnabled(ivalues);
-    if (ivalues!=axis_) {
-        axis_ = ivalues;
+    if(parametersChanged_)
+    {
+      parametersChanged_ = false;
+
+      std::vector<int> axis, dim;
+      std::vector<double> acceleration, deceleration, accelerationJerk, decelerationJerk, velocity;
+
+      controller_->GetMotionParameters(axis, dim, acceleration, deceleration, accelerationJerk, decelerationJerk, velocity);
+
+      if (axis!=axis_) {
+        axis_ = axis;
         changed = true;
-    }
+      }
 
-    controller_->GetDimension(ivalues);
-    if (ivalues!=dim_) {
-        dim_ = ivalues;
+      if (dim!=dim_) {
+        dim_ = dim;
         changed = true;
-    }
+      }
 
-    controller_->GetAcceleration(dvalues);
-    if (dvalues!=acceleration_) {
-      acceleration_ = dvalues;
-      changed = true;
-    }
+      if (acceleration!=acceleration_) {
+        acceleration_ = acceleration;
+        changed = true;
+      }
 
-    controller_->GetDeceleration(dvalues);
-    if (dvalues!=deceleration_) {
-      deceleration_ = dvalues;
-      changed = true;
-    }
+      if (deceleration!=deceleration_) {
+        deceleration_ = deceleration;
+        changed = true;
+      }
 
-    controller_->GetAccelerationJerk(dvalues);
-    if (dvalues!=accelerationJerk_) {
-      accelerationJerk_ = dvalues;
-      changed = true;
-    }
+      if (accelerationJerk!=accelerationJerk_) {
+        accelerationJerk_ = accelerationJerk;
+        changed = true;
+      }
 
-    controller_->GetDecelerationJerk(dvalues);
-    if (dvalues!=decelerationJerk_) {
-      decelerationJerk_ = dvalues;
-      changed = true;
-    }
+      if (decelerationJerk!=decelerationJerk_) {
+        decelerationJerk_ = decelerationJerk;
+        changed = true;
+      }
 
-    controller_->GetVelocity(dvalues);
-    if (dvalues!=velocity_) {
-      velocity_ = dvalues;
-      changed = true;
+      if (velocity!=velocity_) {
+        velocity_ = velocity;
+        changed = true;
+      }
+
+      int joystick = controller_->GetJoystickEnabled();
+      if (joystick!=joystickEnabled_) {
+        joystickEnabled_ = joystick;
+        changed = true;
+      }
+
+      if(joystickEnabled_){
+        controller_->GetJoystickAxisEnabled(ivalues);
+        if (ivalues!=joystickAxisEnabled_) {
+          joystickAxisEnabled_ = ivalues;
+          changed = true;
+        }
+      }
     }
 
     controller_->GetPosition(dvalues);
@@ -1165,21 +1282,6 @@ void LStepExpressModel::updateInformation()
       positionChanged = true;
     }
 
-    int joystick = controller_->GetJoystickEnabled();
-    // int joystick_model = this->getJoystickEnabled();
-    if (joystick!=joystickEnabled_) {
-        joystickEnabled_ = joystick;
-        changed = true;
-    }
-
-    if(joystickEnabled_){
-      controller_->GetJoystickAxisEnabled(ivalues);
-      if (ivalues!=joystickAxisEnabled_) {
-        joystickAxisEnabled_ = ivalues;
-        changed = true;
-      }
-    }
-
     if(changed)
     {
         NQLog("LStepExpressModel", NQLog::Debug) << "updateInformation"
@@ -1232,13 +1334,10 @@ void LStepExpressModel::updateMotionInformation()
       bool changed = false;
 
       std::vector<int> ivalues;
-      std::vector<int> pavalues;
-      std::vector<int> evalues;
       std::vector<double> dvalues;
 
-      controller_->GetAxisStatus(ivalues);
-      controller_->GetPowerAmplifierStatus(pavalues);
-      controller_->GetAxisEnabled(evalues);
+      // axis status and position in one batch, everything else is cached
+      controller_->GetMotionStatus(ivalues, dvalues);
 
       if (ivalues!=axisStatus_) {
         axisStatus_ = ivalues;
@@ -1273,7 +1372,6 @@ void LStepExpressModel::updateMotionInformation()
       }
       
       if( (axis_)[0] || (axis_)[1] || (axis_)[2] || (axis_)[3]){
-        controller_->GetPosition(dvalues);
         if (dvalues!=position_) {
           //NQLog("LStepExpressModel", NQLog::Spam)<< "updateMotionInformation() new position values"  ;
           position_ = dvalues;
@@ -1300,6 +1398,8 @@ void LStepExpressModel::updateMotionInformation()
       }
 
       isUpdating_ = false;
+
+      this->notifyMotionUpdate();
     }
 }
 
@@ -1338,13 +1438,10 @@ void LStepExpressModel::updateMotionInformationFromTimer()
       bool changed = false;
 
       std::vector<int> ivalues;
-      std::vector<int> pavalues;
-      std::vector<int> evalues;
       std::vector<double> dvalues;
 
-      controller_->GetAxisStatus(ivalues);
-      controller_->GetPowerAmplifierStatus(pavalues);
-      controller_->GetAxisEnabled(evalues);
+      // axis status and position in one batch, everything else is cached
+      controller_->GetMotionStatus(ivalues, dvalues);
 
       if (ivalues!=axisStatus_) {
         axisStatus_ = ivalues;
@@ -1373,7 +1470,6 @@ void LStepExpressModel::updateMotionInformationFromTimer()
 
       if((axis_)[0] || (axis_)[1] || (axis_)[2] || (axis_)[3])
       {
-        controller_->GetPosition(dvalues);
         if (dvalues!=position_) {
           position_ = dvalues;
           changed = true;
@@ -1398,18 +1494,144 @@ void LStepExpressModel::updateMotionInformationFromTimer()
       }
 
       isUpdating_ = false;
+
+      this->notifyMotionUpdate();
+    }
+}
+
+void LStepExpressModel::setMotionWatchInterval(const int interval)
+{
+    motionWatchInterval_ = interval;
+
+    if(motionWatchInterval_ > 0){ motionTimer_->setInterval(motionWatchInterval_); }
+}
+
+void LStepExpressModel::startMotionWatch()
+{
+    if(motionWatchInterval_ <= 0){ return; }
+
+    motionSeen_ = false;
+    motionClock_.start();
+
+    // moves can be requested from other threads, the timer lives in the thread of the model
+    QMetaObject::invokeMethod(motionTimer_, "start");
+}
+
+void LStepExpressModel::notifyMotionUpdate()
+{
+    QMutexLocker locker(&motionMutex_);
+
+    motionUpdated_.wakeAll();
+}
+
+bool LStepExpressModel::waitForMotionUpdate(const std::function<bool()>& done, const unsigned long timeout)
+{
+    QMutexLocker locker(&motionMutex_);
+
+    if(done()){ return true; }
+
+    motionUpdated_.wait(&motionMutex_, timeout);
+
+    return false;
+}
+
+/// Polls only the axis status while a motion is active, the position is read once the motion is finished.
+void LStepExpressModel::updateMotionState()
+{
+    if((controller_ == nullptr) || (state_ != READY) || (inMotion_ == false))
+    {
+      motionTimer_->stop();
+
+      return;
+    }
+
+    if(isPaused_){ return; }
+
+    NQLog("LStepExpressModel", NQLog::Spam) << "updateMotionState";
+
+    isUpdating_ = true;
+
+    std::vector<int> ivalues;
+    controller_->GetAxisStatus(ivalues);
+
+    bool changed = false;
+
+    if (ivalues!=axisStatus_) {
+      axisStatus_ = ivalues;
+      changed = true;
     }
+
+    bool finished = (ivalues.size() == 4);
+    for(unsigned int i = 0; finished && i < 4; i++)
+    {
+      const bool ifaxisenabled = ( (ivalues)[i] == LStepExpress_t::AXISSTANDSANDREADY || (ivalues)[i] == LStepExpress_t::AXISACKAFTERCALIBRATION) && (axis_)[i] == 1;
+      const bool ifaxisnotenabled = (axis_)[i] == 0;
+      finished = (ifaxisenabled || ifaxisnotenabled);
+    }
+
+    // right after the move command the controller may still report the axes as ready,
+    // the end of the motion is accepted once the motion was seen or after one regular update interval
+    if(!finished){ motionSeen_ = true; }
+    else if(!motionSeen_ && (motionClock_.elapsed() < motionUpdateInterval_)){ finished = false; }
+
+    if(finished)
+    {
+      motionTimer_->stop();
+
+      std::vector<double> dvalues;
+      controller_->GetPosition(dvalues);
+
+      if (dvalues!=position_) {
+        position_ = dvalues;
+        changed = true;
+      }
+
+      inMotion_ = false;
+
+      if(finishedCalibrating_)
+      {
+        std::vector<double> posvalues{0.0, 0.0, 0.0, 0.0};
+        controller_->SetPosition(posvalues);
+        position_ = posvalues;
+        changed = true;
+        finishedCalibrating_ = false;
+      }
+    }
+
+    isUpdating_ = false;
+
+    if(changed)
+    {
+      NQLog("LStepExpressModel", NQLog::Debug) << "updateMotionState"
+          << ": emitting signal \"motionInformationChanged\"";
+
+      emit motionInformationChanged();
+    }
+
+    if(finished)
+    {
+      NQLog("LStepExpressModel", NQLog::Debug) << "updateMotionState"
+          << ": emitting signal \"motionFinished\"";
+
+      emit motionFinished();
+    }
+
+    this->notifyMotionUpdate();
 }
 
 void LStepExpressModel::setDeviceEnabled(bool enabled)
 {
     NQLog("LStepExpressModel", NQLog::Debug) << "setDeviceEnabled(" << enabled << ")";
 
+    if(!enabled){ DeviceWatcher::instance()->unwatch(this); }
+
     if(state_ == READY && !enabled)
     {
       std::vector<int> allZeros{ 0, 0, 0, 0 };
       controller_->SetPowerAmplifierStatus(allZeros);
       controller_->SetAxisEnabled(allZeros);
+
+      parametersChanged_ = true;
     }
 
     AbstractDeviceModel<LStepExpress_t>::setDeviceEnabled(enabled);
@@ -15,11 +15,14 @@
 
 #include <vector>
 #include <string>
+#include <functional>
 
 #include <QString>
 #include <QTimer>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QWaitCondition>
+#include <QElapsedTimer>
 
 #include "DeviceState.h"
 #include "DeviceParameter.h"
@@ -84,6 +87,16 @@ class LStepExpressModel : public QObject, public AbstractDeviceModel<LStepExpres
     int       updateInterval() const { return       updateInterval_; }
     int motionUpdateInterval() const { return motionUpdateInterval_; }
 
+    /// Interval (ms) of the status polling while a motion is active, 0 disables it.
+    void setMotionWatchInterval(const int interval);
+    int motionWatchInterval() const { return motionWatchInterval_; }
+
+    /// Returns true if done() holds, otherwise blocks the calling thread until the motion state
+    /// was updated (or timeout ms passed) and returns false; done() is checked with the motion
+    /// mutex held, so an update between check and wait is not lost.
+    /// Must not be called from the thread of the model.
+    bool waitForMotionUpdate(const std::function<bool()>& done, const unsigned long timeout);
+
   public slots:
 
     void setDeviceEnabled(bool enabled=true);
@@ -132,6 +145,9 @@ class LStepExpressModel : public QObject, public AbstractDeviceModel<LStepExpres
 
     void renewController(const QString& port) override;
 
+    void detachController();
+    bool reattachController();
+
     const QString port_;
 
     const QString lstep_ver_;
@@ -145,9 +161,22 @@ class LStepExpressModel : public QObject, public AbstractDeviceModel<LStepExpres
     QTimer* timer_;
     int updateCount_;
 
+    /// Fast polling of the axis status only while a motion is active.
+    int motionWatchInterval_;
+    QTimer* motionTimer_;
+    QElapsedTimer motionClock_;
+    bool motionSeen_;
+
+    QMutex motionMutex_;
+    QWaitCondition motionUpdated_;
+
+    void startMotionWatch();
+    void notifyMotionUpdate();
+
     void setDeviceState( State state );
 
     std::vector<int> axis_;
+    std::vector<int> detachedAxis_;
     std::vector<int> axisDirection_;
     std::vector<int> dim_;
     std::vector<int> pa_;
@@ -162,6 +191,10 @@ class LStepExpressModel : public QObject, public AbstractDeviceModel<LStepExpres
     std::vector<double> velocity_;
     std::vector<double> position_;
 
+    /// Static parameters (axis, dimension, acceleration, velocity, joystick)
+    /// are re-read on the next update only after they may have changed.
+    bool parametersChanged_;
+
     bool inMotion_;
     bool isPaused_;
     bool isUpdating_;
@@ -172,6 +205,7 @@ class LStepExpressModel : public QObject, public AbstractDeviceModel<LStepExpres
     void updateInformation();
     void updateMotionInformation();
     void updateMotionInformationFromTimer();
+    void updateMotionState();
 
   signals:
 
@@ -16,7 +16,9 @@
 #include <ApplicationConfig.h>
 #include <nqlogger.h>
 
-#include <unistd.h>
+#include <QElapsedTimer>
+
+#include <algorithm>
 
 LStepExpressMotionManager::LStepExpressMotionManager(LStepExpressModel* model, QObject* parent)
  : QObject(parent)
@@ -505,13 +507,33 @@ double LStepExpressMotionManager::get_position(const int axis) const
   // output:
   //  * it is not safe to return if any of the conditions above is not satisfied
   //  * this means the 'while' shoud not be broken or shortcut (a priori, it might never finish)
-  //  * after a certain number of attempts, explicit warnings are printed
+  //  * after a certain time, explicit warnings are printed and the motion is stopped;
+  //    the time is counted in tries of 0.4 times the update interval of the model
+  //  * between checks, the calling thread waits for the next update of the motion state
+  //    (get_position must not be called from the thread of the model)
   //
+  const auto position_valid = [this]()
+  {
+    return !(model()->isUpdating() || model()->isInMotion() || inMotion_ || (this->model()->getPositions().size() != 4));
+  };
+
+  const unsigned long try_interval = std::max(1, int(model()->updateInterval() * 0.4));
+
+  QElapsedTimer clock;
+  clock.start();
+
   uint tries(0);
 
-  while(model()->isUpdating() || model()->isInMotion() || inMotion_ || (this->model()->getPositions().size() != 4))
+  // woken up as soon as the model has updated the motion state (e.g. end of motion),
+  // at the latest after one try interval
+  while(model()->waitForMotionUpdate(position_valid, try_interval) == false)
   {
-    ++tries;
+    // warnings and emergency stop once per try interval, not on every update of the motion state
+    const uint elapsed_tries = clock.elapsed() / try_interval;
+
+    if(elapsed_tries <= tries){ continue; }
+
+    tries = elapsed_tries;
 
     if(tries > 10)
     {
@@ -547,8 +569,6 @@ double LStepExpressMotionManager::get_position(const int axis) const
            << this->model()->getPositions().size() << ")";
       }
     }
-
-    usleep(model()->updateInterval() * 400); // from ms to us, times 0.4
   }
 
   return this->model()->getPosition(axis);
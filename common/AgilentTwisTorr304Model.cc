@@ -27,14 +27,18 @@ AgilentTwisTorr304Model::AgilentTwisTorr304Model(const char* port,
    port_(port),
    updateInterval_(updateInterval)
 {
-  timer_ = new QTimer(this);
-  timer_->setInterval(updateInterval_ * 1000);
-  connect(timer_, SIGNAL(timeout()), this, SLOT(updateInformation()));
-
   pumpState_ = false;
   pumpStatus_ = 0;
   errorCode_ = 0;
 
+  PollScheduler* scheduler = PollScheduler::instance();
+  scheduler->registerParameter(this, port_, "pump status", PollScheduler::Normal,
+                               updateInterval_ * 1000, 6 * updateInterval_ * 1000,
+                               [this]() { return updatePumpStatus(); });
+  scheduler->registerParameter(this, port_, "error code", PollScheduler::Low,
+                               updateInterval_ * 1000, 12 * updateInterval_ * 1000,
+                               [this]() { return updateErrorCode(); });
+
   setDeviceEnabled(true);
   setControlsEnabled(true);
 }
@@ -70,11 +74,13 @@ const std::string AgilentTwisTorr304Model::getPumpStatusText() const
 void AgilentTwisTorr304Model::switchPumpOn()
 {
   controller_->SwitchPumpOn();
+  PollScheduler::instance()->boost(this);
 }
 
 void AgilentTwisTorr304Model::switchPumpOff()
 {
   controller_->SwitchPumpOff();
+  PollScheduler::instance()->boost(this);
 }
 
 void AgilentTwisTorr304Model::setDeviceEnabled(bool enabled)
@@ -90,10 +96,7 @@ void AgilentTwisTorr304Model::setDeviceState(State state)
   if (state_ != state) {
     state_ = state;
 
-    if ( state == READY )
-      timer_->start();
-    else
-      timer_->stop();
+    PollScheduler::instance()->setEnabled(this, state_ == READY);
 
     emit deviceStateChanged(state);
   }
@@ -118,23 +121,49 @@ void AgilentTwisTorr304Model::updateInformation()
     NQLog("AgilentTwisTorr304Model", NQLog::Debug) << " running in dedicated DAQ thread";
   }
 
-  if ( state_ == READY ) {
+  updatePumpStatus();
+  updateErrorCode();
+}
+
+/**
+  Reads pump state and status. Returns true if any of them changed.
+  */
+bool AgilentTwisTorr304Model::updatePumpStatus()
+{
+  if ( state_ != READY ) return false;
+
+  bool newPumpState = controller_->GetPumpState();
+  unsigned int newPumpStatus = controller_->GetPumpStatus();
 
-    bool newPumpState = controller_->GetPumpState();
-    unsigned int newPumpStatus = controller_->GetPumpStatus();
-    unsigned int newErrorCode = controller_->GetErrorCode();
+  if (newPumpState == pumpState_ &&
+      newPumpStatus == pumpStatus_) return false;
 
-    if (newPumpState != pumpState_ ||
-        newPumpStatus != pumpStatus_ ||
-        newErrorCode != errorCode_) {
+  pumpState_ = newPumpState;
+  pumpStatus_ = newPumpStatus;
 
-      pumpState_ = newPumpState;
-      pumpStatus_ = newPumpStatus;
-      errorCode_ = newErrorCode;
+  NQLog("AgilentTwisTorr304Model", NQLog::Spam) << "information changed";
 
-      NQLog("AgilentTwisTorr304Model", NQLog::Spam) << "information changed";
+  emit informationChanged();
 
-      emit informationChanged();
-    }
-  }
+  return true;
+}
+
+/**
+  Reads the error code. Returns true if it changed.
+  */
+bool AgilentTwisTorr304Model::updateErrorCode()
+{
+  if ( state_ != READY ) return false;
+
+  unsigned int newErrorCode = controller_->GetErrorCode();
+
+  if (newErrorCode == errorCode_) return false;
+
+  errorCode_ = newErrorCode;
+
+  NQLog("AgilentTwisTorr304Model", NQLog::Spam) << "information changed";
+
+  emit informationChanged();
+
+  return true;
 }
@@ -23,6 +23,7 @@
 
 #include "DeviceState.h"
 #include "Ringbuffer.h"
+#include "PollScheduler.h"
 
 #ifdef USE_FAKEIO
 #include "devices/Agilent/AgilentTwisTorr304Fake.h"
@@ -69,10 +70,9 @@ protected:
 
   void initialize();
 
-  /// Time interval between cache refreshes; in seconds.
   QString port_;
+  /// Time interval between cache refreshes while values change; in seconds.
   int updateInterval_;
-  QTimer* timer_;
 
   void setDeviceState( State state );
 
@@ -80,6 +80,9 @@ protected:
   unsigned int pumpStatus_;
   unsigned int errorCode_;
 
+  bool updatePumpStatus();
+  bool updateErrorCode();
+
 protected slots:
 
   void updateInformation();
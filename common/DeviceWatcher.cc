@@ -0,0 +1,279 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+#include <nqlogger.h>
+
+#include "DeviceWatcher.h"
+
+DeviceWatcher* DeviceWatcher::instance()
+{
+  static DeviceWatcher* watcher = []() {
+    DeviceWatcher* w = new DeviceWatcher();
+    if (QCoreApplication::instance()) w->moveToThread(QCoreApplication::instance()->thread());
+    return w;
+  }();
+
+  return watcher;
+}
+
+DeviceWatcher::DeviceWatcher()
+  : QObject()
+{
+  watcher_ = new QFileSystemWatcher(this);
+  connect(watcher_, SIGNAL(directoryChanged(QString)), this, SLOT(directoryChanged()));
+
+  settleTimer_ = new QTimer(this);
+  settleTimer_->setSingleShot(true);
+  settleTimer_->setInterval(settleTime_);
+  connect(settleTimer_, SIGNAL(timeout()), this, SLOT(rescan()));
+
+  retryTimer_ = new QTimer(this);
+  retryTimer_->setSingleShot(true);
+  retryTimer_->setInterval(retryInterval_);
+  connect(retryTimer_, SIGNAL(timeout()), this, SLOT(rescan()));
+
+  watchDirectories();
+
+  serialDevices_ = serialDevices();
+}
+
+void DeviceWatcher::watch(QObject* owner,
+                          const QString& port,
+                          std::function<void()> detached,
+                          std::function<bool()> reattached)
+{
+  watch(owner, port, port, detached, reattached);
+}
+
+void DeviceWatcher::watch(QObject* owner,
+                          const QString& port,
+                          const QString& path,
+                          std::function<void()> detached,
+                          std::function<bool()> reattached)
+{
+  QMutexLocker locker(&mutex_);
+
+  if (devices_.find(owner)==devices_.end()) {
+    connect(owner, &QObject::destroyed, this,
+            [this, owner]() { unwatch(owner); }, Qt::DirectConnection);
+  }
+
+  Device device;
+  device.port = port;
+  device.path = path;
+  device.detached = detached;
+  device.reattached = reattached;
+  device.signature = signature(path);
+  device.present = true;
+  device.inFlight = false;
+
+  devices_[owner] = device;
+
+  NQLog("DeviceWatcher", NQLog::Debug) << "watch: " << path << " (" << port << ")";
+}
+
+void DeviceWatcher::unwatch(QObject* owner)
+{
+  QMutexLocker locker(&mutex_);
+
+  auto it = devices_.find(owner);
+  if (it==devices_.end()) return;
+
+  NQLog("DeviceWatcher", NQLog::Debug) << "unwatch: " << it->second.port;
+
+  devices_.erase(it);
+}
+
+bool DeviceWatcher::isPresent(const QString& port)
+{
+  if (port.isEmpty()) return false;
+
+  const QFileInfo info(port);
+
+  QDir dir(info.dir());
+  dir.setNameFilters(QStringList(info.fileName()));
+  dir.setFilter(QDir::System);
+
+  return !dir.entryList().isEmpty();
+}
+
+QString DeviceWatcher::signature(const QString& port)
+{
+  if (port.isEmpty()) return QString();
+
+  const QFileInfo info(port);
+
+  QDir dir(info.dir());
+  dir.setNameFilters(QStringList(info.fileName()));
+  dir.setFilter(QDir::System);
+  dir.setSorting(QDir::Name);
+
+  QStringList files;
+  for (const QFileInfo& file : dir.entryInfoList()) {
+    files << file.canonicalFilePath() + "@"
+             + QString::number(file.metadataChangeTime().toMSecsSinceEpoch());
+  }
+
+  return files.join(";");
+}
+
+//! Serial device files currently present.
+/*!
+  \internal
+  USB serial adapters (ttyUSB, ttyACM), the udev symlinks in /dev and
+  the persistent names in /dev/serial/by-id.
+*/
+QSet<QString> DeviceWatcher::serialDevices() const
+{
+  QSet<QString> devices;
+
+  QDir dev("/dev");
+  dev.setFilter(QDir::System);
+  dev.setNameFilters(QStringList() << "ttyUSB*" << "ttyACM*");
+  for (const QString& name : dev.entryList()) devices.insert(dev.absoluteFilePath(name));
+
+  // udev symlinks like ttyLeybold
+  dev.setNameFilters(QStringList() << "tty*");
+  for (const QFileInfo& info : dev.entryInfoList()) {
+    if (info.isSymLink()) devices.insert(info.absoluteFilePath());
+  }
+
+  QDir byId("/dev/serial/by-id");
+  byId.setFilter(QDir::System);
+  for (const QString& name : byId.entryList()) devices.insert(byId.absoluteFilePath(name));
+
+  return devices;
+}
+
+//! (Re)adds the watched directories, /dev/serial/by-id only exists while an adapter is plugged in.
+/*!
+  \internal
+*/
+void DeviceWatcher::watchDirectories()
+{
+  QStringList directories;
+  directories << "/dev" << "/dev/serial" << "/dev/serial/by-id";
+
+  const QStringList watched = watcher_->directories();
+  for (const QString& directory : directories) {
+    if (!watched.contains(directory) && QFileInfo(directory).isDir()) {
+      watcher_->addPath(directory);
+    }
+  }
+}
+
+void DeviceWatcher::directoryChanged()
+{
+  // wait until udev has finished creating the symlinks
+  settleTimer_->start();
+}
+
+void DeviceWatcher::rescan()
+{
+  watchDirectories();
+
+  QSet<QString> devices = serialDevices();
+
+  for (const QString& path : devices - serialDevices_) {
+    NQLog("DeviceWatcher", NQLog::Message) << "device added: " << path;
+    emit deviceAdded(path);
+  }
+  for (const QString& path : serialDevices_ - devices) {
+    NQLog("DeviceWatcher", NQLog::Message) << "device removed: " << path;
+    emit deviceRemoved(path);
+  }
+
+  serialDevices_ = devices;
+
+  QMutexLocker locker(&mutex_);
+
+  for (auto& d : devices_) {
+    Device& device = d.second;
+    if (device.inFlight) continue;
+
+    if (device.present) {
+      if (signature(device.path)==device.signature) continue;
+
+      // gone or replaced by a new device file, the controller is unusable
+      dispatchDetached(d.first, device);
+    }
+
+    if (isPresent(device.port)) dispatchReattached(d.first, device);
+  }
+}
+
+//! Queues the detached function in the thread of the owner.
+/*!
+  \internal
+  Has to be called with the mutex locked.
+*/
+void DeviceWatcher::dispatchDetached(QObject* owner, Device& device)
+{
+  NQLog("DeviceWatcher", NQLog::Warning) << "device detached: " << device.port;
+
+  device.present = false;
+
+  const std::function<void()> detached = device.detached;
+  QMetaObject::invokeMethod(owner, [detached]() { detached(); }, Qt::QueuedConnection);
+
+  emit deviceDetached(device.port);
+}
+
+//! Queues the reattached function in the thread of the owner.
+/*!
+  \internal
+  Has to be called with the mutex locked.
+*/
+void DeviceWatcher::dispatchReattached(QObject* owner, Device& device)
+{
+  NQLog("DeviceWatcher", NQLog::Message) << "reconnecting " << device.port;
+
+  device.inFlight = true;
+
+  const std::function<bool()> reattached = device.reattached;
+  QMetaObject::invokeMethod(owner, [this, owner, reattached]() {
+      finished(owner, reattached());
+    }, Qt::QueuedConnection);
+}
+
+void DeviceWatcher::finished(QObject* owner, bool reattached)
+{
+  QMutexLocker locker(&mutex_);
+
+  auto it = devices_.find(owner);
+  if (it==devices_.end()) return;
+
+  Device& device = it->second;
+  device.inFlight = false;
+
+  // a successful reattach normally registers the new path again
+  if (reattached) {
+    device.signature = signature(device.path);
+    device.present = true;
+
+    NQLog("DeviceWatcher", NQLog::Message) << "device reconnected: " << device.port;
+
+    emit deviceReattached(device.port);
+  } else {
+    NQLog("DeviceWatcher", NQLog::Warning) << "reconnecting " << device.port
+                                           << " failed, retrying in "
+                                           << retryInterval_ << " ms";
+
+    QMetaObject::invokeMethod(retryTimer_, "start", Qt::QueuedConnection);
+  }
+}
@@ -0,0 +1,143 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DEVICEWATCHER_H
+#define DEVICEWATCHER_H
+
+#include <functional>
+#include <map>
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QSet>
+#include <QTimer>
+#include <QMutex>
+#include <QFileSystemWatcher>
+
+/** @addtogroup common
+ *  @{
+ */
+
+/**
+  \brief Reconnects device models after their serial adapter was unplugged.
+
+  Watches /dev and /dev/serial/by-id (inotify via QFileSystemWatcher) for
+  serial device files being added or removed. A model that is READY
+  registers the device file it is using with watch(), optionally with a
+  port name containing wildcards, like the ports of LStepExpressModel.
+
+  When the device file is gone (the adapter was unplugged) or it was
+  replaced by a new one (the adapter re-enumerated), the detached
+  function of the model is called, which should drop the controller
+  without further device I/O. As soon as a file matching the port is
+  back, the reattached function is called. It should
+  create a new controller, check the identity of the device (e.g. the
+  version check of LStepExpress) and replay the cached settings of the
+  model, returning true on success. A failed reattach is retried.
+
+  Fixed names created by udev rules (see pumpstation/99-usb-serial.rules)
+  come back under the same name, wildcard ports find the device under
+  whatever name it got.
+
+  Both functions are executed in the thread of their owner. Changes are
+  only evaluated after /dev has been quiet for a short time, so the
+  symlinks created by udev are in place.
+  */
+class DeviceWatcher : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  static DeviceWatcher* instance();
+
+  /**
+    Starts watching the device file port of owner. A previous
+    registration of owner is replaced.
+    */
+  void watch(QObject* owner,
+             const QString& port,
+             std::function<void()> detached,
+             std::function<bool()> reattached);
+
+  /**
+    Starts watching the device file path in use by owner. The device is
+    reattached once a file matching port, which may contain wildcards,
+    is present again.
+    */
+  void watch(QObject* owner,
+             const QString& port,
+             const QString& path,
+             std::function<void()> detached,
+             std::function<bool()> reattached);
+
+  /// Stops watching the device of owner, e.g. when it is disabled by the user.
+  void unwatch(QObject* owner);
+
+  /// True if a device file matching port exists.
+  static bool isPresent(const QString& port);
+
+  /**
+    Identifies the device files matching port by their target and the
+    time they were created, empty if there is none. Changes when an
+    adapter re-enumerates under the same name.
+    */
+  static QString signature(const QString& port);
+
+signals:
+
+  void deviceAdded(const QString& path);
+  void deviceRemoved(const QString& path);
+  void deviceDetached(const QString& port);
+  void deviceReattached(const QString& port);
+
+protected slots:
+
+  void directoryChanged();
+  void rescan();
+
+protected:
+
+  explicit DeviceWatcher();
+
+  struct Device {
+    QString port;
+    QString path;
+    std::function<void()> detached;
+    std::function<bool()> reattached;
+    QString signature;
+    bool present;
+    bool inFlight;
+  };
+
+  QSet<QString> serialDevices() const;
+  void watchDirectories();
+  void dispatchDetached(QObject* owner, Device& device);
+  void dispatchReattached(QObject* owner, Device& device);
+  void finished(QObject* owner, bool reattached);
+
+  QMutex mutex_;
+  QFileSystemWatcher* watcher_;
+  QTimer* settleTimer_;
+  QTimer* retryTimer_;
+
+  std::map<QObject*,Device> devices_;
+  QSet<QString> serialDevices_;
+
+  static constexpr int settleTime_ = 500;
+  static constexpr int retryInterval_ = 2000;
+};
+
+/** @} */
+
+#endif // DEVICEWATCHER_H
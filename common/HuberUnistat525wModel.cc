@@ -27,9 +27,14 @@ HuberUnistat525wModel::HuberUnistat525wModel(const char* port,
    HuberUnistat525w_PORT(port),
    updateInterval_(updateInterval)
 {
-  timer_ = new QTimer(this);
-  timer_->setInterval(updateInterval_ * 1000);
-  connect( timer_, SIGNAL(timeout()), this, SLOT(updateInformation()) );
+  const int interval = updateInterval_ * 1000;
+  PollScheduler* scheduler = PollScheduler::instance();
+  scheduler->registerParameter(this, HuberUnistat525w_PORT, "temperatures", PollScheduler::High,
+                               interval, 3 * interval, [this]() { return updateTemperatures(); });
+  scheduler->registerParameter(this, HuberUnistat525w_PORT, "pump", PollScheduler::Normal,
+                               interval, 6 * interval, [this]() { return updatePump(); });
+  scheduler->registerParameter(this, HuberUnistat525w_PORT, "settings", PollScheduler::Low,
+                               interval, 12 * interval, [this]() { return updateSettings(); });
 
   setDeviceEnabled(true);
   setControlsEnabled(true);
@@ -51,6 +56,7 @@ void HuberUnistat525wModel::setTemperatureSetPoint(double temperature)
       if (controller_->SetTemperatureSetPoint(temperature)) {
         temperatureSetPoint_ = temperature;
         emit informationChanged();
+        PollScheduler::instance()->boost(this);
       }
     }
   }
@@ -70,6 +76,7 @@ void HuberUnistat525wModel::setTemperatureControlMode(bool external)
       if (controller_->SetTemperatureControlMode(external)) {
         temperatureControlMode_ = external;
         emit informationChanged();
+        PollScheduler::instance()->boost(this);
       }
     }
   }
@@ -88,6 +95,7 @@ void HuberUnistat525wModel::setTemperatureControlEnabled(bool enabled)
       if (controller_->SetTemperatureControlEnabled(enabled)) {
         temperatureControlEnabled_ = enabled;
         emit informationChanged();
+        PollScheduler::instance()->boost(this);
       }
     }
   }
@@ -107,6 +115,7 @@ void HuberUnistat525wModel::setCirculatorEnabled(bool enabled)
       if (controller_->SetCirculatorEnabled(enabled)) {
         circulatorEnabled_ = enabled;
         emit informationChanged();
+        PollScheduler::instance()->boost(this);
       }
     }
   }
@@ -168,11 +177,8 @@ void HuberUnistat525wModel::setDeviceState( State state )
   if ( state_ != state ) {
     state_ = state;
 
-    // No need to run the timer if the chiller is not ready
-    if ( state_ == READY )
-      timer_->start();
-    else
-      timer_->stop();
+    // No need to poll if the chiller is not ready
+    PollScheduler::instance()->setEnabled(this, state_ == READY);
 
     emit deviceStateChanged(state);
   }
@@ -188,46 +194,93 @@ void HuberUnistat525wModel::updateInformation()
     NQLog("HuberUnistat525wModel", NQLog::Debug) << " running in dedicated DAQ thread";
   }
 
-  if ( state_ == READY ) {
-
-    double newTemperatureSetPoint = controller_->GetTemperatureSetPoint();
-    bool newTemperatureControlMode = controller_->GetTemperatureControlMode();
-    bool newTemperatureControlEnabled = controller_->GetTemperatureControlEnabled();
-    bool newCirculatorEnabled = controller_->GetCirculatorEnabled();
-    double newBathTemperature = controller_->GetBathTemperature();
-    double newReturnTemperature = controller_->GetReturnTemperature();
-    double newCWInletTemperature = controller_->GetCoolingWaterInletTemperature();
-    double newCWOutletTemperature = controller_->GetCoolingWaterOutletTemperature();
-    double newPumpPressure = controller_->GetPumpPressure();
-    int newPower = controller_->GetPower();
-
-    if (newTemperatureSetPoint != temperatureSetPoint_ ||
-        newTemperatureControlMode != temperatureControlMode_ ||
-        newTemperatureControlEnabled != temperatureControlEnabled_ ||
-        newCirculatorEnabled != circulatorEnabled_ ||
-        newBathTemperature != bathTemperature_ ||
-        newReturnTemperature != returnTemperature_ ||
-        newCWInletTemperature != cwInletTemperature_ ||
-        newCWOutletTemperature != cwOutletTemperature_ ||
-        newPumpPressure != pumpPressure_ ||
-        newPower != power_) {
-
-      temperatureSetPoint_ = newTemperatureSetPoint;
-      temperatureControlMode_ = newTemperatureControlMode;
-      temperatureControlEnabled_ = newTemperatureControlEnabled;
-      circulatorEnabled_ = newCirculatorEnabled;
-      bathTemperature_ = newBathTemperature;
-      returnTemperature_ = newReturnTemperature;
-      pumpPressure_ = newPumpPressure;
-      power_ = newPower;
-      cwInletTemperature_ = newCWInletTemperature;
-      cwOutletTemperature_ = newCWOutletTemperature;
-
-      NQLog("HuberUnistat525wModel", NQLog::Spam) << "information changed";
-
-      emit informationChanged();
-    }
-  }
+  updateSettings();
+  updateTemperatures();
+  updatePump();
+}
+
+/**
+  Reads setpoint, control mode and circulator state. Returns true if any
+  of them changed.
+  */
+bool HuberUnistat525wModel::updateSettings()
+{
+  if ( state_ != READY ) return false;
+
+  double newTemperatureSetPoint = controller_->GetTemperatureSetPoint();
+  bool newTemperatureControlMode = controller_->GetTemperatureControlMode();
+  bool newTemperatureControlEnabled = controller_->GetTemperatureControlEnabled();
+  bool newCirculatorEnabled = controller_->GetCirculatorEnabled();
+
+  if (newTemperatureSetPoint == temperatureSetPoint_ &&
+      newTemperatureControlMode == temperatureControlMode_ &&
+      newTemperatureControlEnabled == temperatureControlEnabled_ &&
+      newCirculatorEnabled == circulatorEnabled_) return false;
+
+  temperatureSetPoint_ = newTemperatureSetPoint;
+  temperatureControlMode_ = newTemperatureControlMode;
+  temperatureControlEnabled_ = newTemperatureControlEnabled;
+  circulatorEnabled_ = newCirculatorEnabled;
+
+  NQLog("HuberUnistat525wModel", NQLog::Spam) << "information changed";
+
+  emit informationChanged();
+
+  return true;
+}
+
+/**
+  Reads bath, return and cooling water temperatures. Returns true if any
+  of them changed.
+  */
+bool HuberUnistat525wModel::updateTemperatures()
+{
+  if ( state_ != READY ) return false;
+
+  double newBathTemperature = controller_->GetBathTemperature();
+  double newReturnTemperature = controller_->GetReturnTemperature();
+  double newCWInletTemperature = controller_->GetCoolingWaterInletTemperature();
+  double newCWOutletTemperature = controller_->GetCoolingWaterOutletTemperature();
+
+  if (newBathTemperature == bathTemperature_ &&
+      newReturnTemperature == returnTemperature_ &&
+      newCWInletTemperature == cwInletTemperature_ &&
+      newCWOutletTemperature == cwOutletTemperature_) return false;
+
+  bathTemperature_ = newBathTemperature;
+  returnTemperature_ = newReturnTemperature;
+  cwInletTemperature_ = newCWInletTemperature;
+  cwOutletTemperature_ = newCWOutletTemperature;
+
+  NQLog("HuberUnistat525wModel", NQLog::Spam) << "information changed";
+
+  emit informationChanged();
+
+  return true;
+}
+
+/**
+  Reads pump pressure and heating/cooling power. Returns true if any of
+  them changed.
+  */
+bool HuberUnistat525wModel::updatePump()
+{
+  if ( state_ != READY ) return false;
+
+  double newPumpPressure = controller_->GetPumpPressure();
+  int newPower = controller_->GetPower();
+
+  if (newPumpPressure == pumpPressure_ &&
+      newPower == power_) return false;
+
+  pumpPressure_ = newPumpPressure;
+  power_ = newPower;
+
+  NQLog("HuberUnistat525wModel", NQLog::Spam) << "information changed";
+
+  emit informationChanged();
+
+  return true;
 }
 
 void HuberUnistat525wModel::setDeviceEnabled(bool enabled)
@@ -20,6 +20,7 @@
 
 #include "DeviceState.h"
 #include "DeviceParameter.h"
+#include "PollScheduler.h"
 
 /*
 #ifdef USE_FAKEIO
@@ -76,9 +77,8 @@ protected:
 
   void initialize();
 
-  /// Time interval between cache refreshes; in seconds.
+  /// Time interval between cache refreshes while values change; in seconds.
   const double updateInterval_;
-  QTimer* timer_;
 
   void setDeviceState( State state );
 
@@ -96,6 +96,10 @@ protected:
   double cwInletTemperature_;
   double cwOutletTemperature_;
 
+  bool updateSettings();
+  bool updateTemperatures();
+  bool updatePump();
+
 protected slots:
 
   void updateInformation();
@@ -10,6 +10,8 @@
 //                                                                             //
 /////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <QApplication>
 
 #include <nqlogger.h>
@@ -22,7 +24,13 @@ KeithleyDAQ6510Model::KeithleyDAQ6510Model(const char* port,
 : QObject(),
   AbstractDeviceModel<KeithleyDAQ6510_t>(),
   port_(port),
-  updateInterval_(updateInterval)
+  updateInterval_(updateInterval),
+  streaming_(false),
+  scanRunning_(false),
+  scanPending_(false),
+  scanChanged_(false),
+  scanReadings_(0),
+  readingCount_(0)
 {
   for (int card=0;card<2;++card) {
     for (int channel=0;channel<10;++channel) {
@@ -35,6 +43,10 @@ KeithleyDAQ6510Model::KeithleyDAQ6510Model(const char* port,
   timer_->setInterval(updateInterval_ * 1000);
   connect( timer_, SIGNAL(timeout()), this, SLOT(scanTemperatures()) );
 
+  bufferTimer_ = new QTimer(this);
+  bufferTimer_->setInterval(100);
+  connect( bufferTimer_, SIGNAL(timeout()), this, SLOT(readScanData()) );
+
   setDeviceEnabled(true);
   setControlsEnabled(true);
 }
@@ -88,10 +100,14 @@ void KeithleyDAQ6510Model::setDeviceState(State state)
   if (state_ != state) {
     state_ = state;
 
-    if ( state == READY )
-      timer_->start();
-    else
+    if ( state == READY ) {
+      if (!streaming_) timer_->start();
+    } else {
       timer_->stop();
+      bufferTimer_->stop();
+      scanRunning_ = false;
+      scanPending_ = false;
+    }
 
     emit deviceStateChanged(state);
   }
@@ -124,13 +140,12 @@ void KeithleyDAQ6510Model::setSensorEnabled(unsigned int sensor, bool enabled)
     setSensorState(sensor, INITIALIZING);
     controller_->ActivateChannel(card+1, channel+1, true);
     setSensorState(sensor, READY);
-    scanDuration_ = controller_->GetScanDuration();
+    if (streaming_ && !scanRunning_) scanTemperatures();
   }
   else if (!enabled && sensorStates_[card][channel] == READY) {
     setSensorState(sensor, CLOSING);
     controller_->ActivateChannel(card+1, channel+1, false);
     setSensorState(sensor, OFF);
-    scanDuration_ = controller_->GetScanDuration();
   }
 }
 
@@ -146,6 +161,23 @@ void KeithleyDAQ6510Model::setUpdateInterval(int updateInterval)
   timer_->setInterval(updateInterval_ * 1000);
 }
 
+void KeithleyDAQ6510Model::setStreaming(bool streaming)
+{
+  if (streaming_ == streaming) return;
+  streaming_ = streaming;
+
+  NQLogMessage("KeithleyDAQ6510Model") << "setStreaming(bool streaming) " << streaming_;
+
+  if (state_ != READY) return;
+
+  if (streaming_) {
+    timer_->stop();
+    if (!scanRunning_) scanTemperatures();
+  } else {
+    timer_->start();
+  }
+}
+
 /// Returns the current cached state of the requested sensor.
 const State & KeithleyDAQ6510Model::getSensorState(unsigned int sensor) const
 {
@@ -165,49 +197,101 @@ double KeithleyDAQ6510Model::getTemperature(unsigned int sensor) const
 }
 
 /**
-  Calls the Keithley controller to get the current reading on the temperatures.
-  These are then cached and signals are emitted upon changes.
+  Starts a scan of all active channels. The readings are fetched from the
+  instrument buffer while the scan is running by readScanData(). If a scan
+  is still running the next one is started as soon as it completes.
   */
 void KeithleyDAQ6510Model::scanTemperatures()
 {
   NQLogDebug("KeithleyDAQ6510Model") << "scanTemperatures()";
 
+  if (state_ != READY) return;
+
+  if (scanRunning_) {
+    scanPending_ = true;
+    return;
+  }
+
+  scanReadings_ = controller_->GetActiveChannelCount();
+  if (scanReadings_ == 0) return;
+
   controller_->Scan();
 
-  QTimer::singleShot(500 + scanDuration_*1000, this,
-                     SLOT(scanComplete()));
+  readingCount_ = 0;
+  scanChanged_ = false;
+  scanRunning_ = true;
+  scanTimer_.start();
+
+  bufferTimer_->start();
 }
 
-void KeithleyDAQ6510Model::scanComplete()
+/**
+  Fetches the readings that were added to the instrument buffer since the
+  last call (TRAC:ACT?) and caches the temperatures. Signals are emitted
+  as soon as a reading is available.
+  */
+void KeithleyDAQ6510Model::readScanData()
 {
-  NQLogDebug("KeithleyDAQ6510Model") << "scanComplete() " << controller_->GetScanStatus();
+  if (!scanRunning_) {
+    bufferTimer_->stop();
+    return;
+  }
 
-  reading_t data;
-  controller_->GetScanData(data);
+  unsigned int count = std::min(controller_->GetNumberOfReadings(), scanReadings_);
 
-  NQLogDebug("KeithleyDAQ6510Model") << "data size: " << data.size();
+  if (count > readingCount_) {
+    reading_t data;
+    controller_->GetScanData(readingCount_ + 1, count, data);
+    readingCount_ = count;
 
-  bool changed = false;
+    NQLogDebug("KeithleyDAQ6510Model") << "readScanData() " << data.size() << " new readings";
 
-  for (reading_t::iterator it=data.begin();it!=data.end();++it) {
-    unsigned int sensor;
-    double temperature;
-    double relativeTime;
-    std::tie(sensor, temperature, relativeTime) = *it;
+    for (reading_t::iterator it=data.begin();it!=data.end();++it) {
+      unsigned int sensor;
+      double temperature;
+      double relativeTime;
+      std::tie(sensor, temperature, relativeTime) = *it;
 
-    unsigned int card = sensor / 100 - 1;
-    unsigned int channel = sensor % 100 - 1;
+      unsigned int card = sensor / 100 - 1;
+      unsigned int channel = sensor % 100 - 1;
+      if (card>1 || channel>9) continue;
 
-    NQLogDebug("KeithleyDAQ6510Model") << "data: " << sensor << " " << temperature << " " << relativeTime;
+      NQLogDebug("KeithleyDAQ6510Model") << "data: " << sensor << " " << temperature << " " << relativeTime;
 
-    if (temperatures_[card][channel] != temperature) {
-      temperatures_[card][channel] = temperature;
-      emit temperatureChanged(sensor, temperature);
-      changed = true;
+      if (temperatures_[card][channel] != temperature) {
+        temperatures_[card][channel] = temperature;
+        emit temperatureChanged(sensor, temperature);
+        scanChanged_ = true;
+      }
     }
   }
 
-  if (changed) emit informationChanged();
+  if (readingCount_ >= scanReadings_) {
+    scanComplete();
+    return;
+  }
+
+  // the instrument needs well below a second per channel
+  if (scanTimer_.elapsed() > 2000 + 1000 * scanReadings_) {
+    NQLogWarning("KeithleyDAQ6510Model") << "scan timed out after "
+                                         << readingCount_ << " of " << scanReadings_ << " readings";
+    scanComplete();
+  }
+}
+
+void KeithleyDAQ6510Model::scanComplete()
+{
+  NQLogDebug("KeithleyDAQ6510Model") << "scanComplete() " << scanTimer_.elapsed() << " ms";
+
+  bufferTimer_->stop();
+  scanRunning_ = false;
+
+  if (scanChanged_) emit informationChanged();
+
+  if (streaming_ || scanPending_) {
+    scanPending_ = false;
+    scanTemperatures();
+  }
 }
 
 void KeithleyDAQ6510Model::statusMessage(const QString & text)
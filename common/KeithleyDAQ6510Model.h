@@ -20,6 +20,7 @@
 #include <QObject>
 #include <QString>
 #include <QTimer>
+#include <QElapsedTimer>
 
 #include "DeviceState.h"
 #include "Ringbuffer.h"
@@ -47,6 +48,7 @@ public:
   const State& getSensorState(unsigned int sensor) const;
   double getTemperature(unsigned int sensor) const;
   int getUpdateInterval() const { return updateInterval_; }
+  bool getStreaming() const { return streaming_; }
 
   void statusMessage(const QString & text);
 
@@ -56,16 +58,29 @@ public slots:
   void setSensorEnabled(unsigned int sensor, bool enabled);
   void setControlsEnabled(bool enabled);
   void setUpdateInterval(int updateInterval);
+  void setStreaming(bool streaming);
 
 protected:
 
   void initialize();
 
-  /// Time interval between cache refreshes; in seconds.
   QString port_;
+  /// Time interval between scans; in seconds.
   int updateInterval_;
   QTimer* timer_;
-  unsigned int scanDuration_;
+
+  /// In streaming mode a new scan is started as soon as the previous one
+  /// has completed, otherwise every updateInterval_ seconds.
+  bool streaming_;
+
+  /// Polls the reading buffer of the running scan.
+  QTimer* bufferTimer_;
+  QElapsedTimer scanTimer_;
+  bool scanRunning_;
+  bool scanPending_;
+  bool scanChanged_;
+  unsigned int scanReadings_;
+  unsigned int readingCount_;
 
   // cached config information
   std::array<std::array<State,10>,2> sensorStates_;
@@ -79,6 +94,7 @@ protected:
 protected slots:
 
   virtual void scanTemperatures();
+  virtual void readScanData();
   virtual void scanComplete();
 
 signals:
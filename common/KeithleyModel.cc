@@ -17,6 +17,7 @@
 
 #include <nqlogger.h>
 
+#include "DeviceWatcher.h"
 #include "KeithleyModel.h"
 
 KeithleyModel::KeithleyModel(const char* port,
@@ -26,15 +27,22 @@ KeithleyModel::KeithleyModel(const char* port,
     AbstractDeviceModel<Keithley2700_t>(),
     port_(port),
     updateInterval_(updateInterval),
+    binaryReadout_(false),
+    continuousScan_(false),
     sensorStates_(SENSOR_COUNT, OFF),
     temperatures_(SENSOR_COUNT, 0.0),
     gradients_(SENSOR_COUNT, 0.0),
     temperatureBuffer_(temperatures_),
     absoluteTime_(std::chrono::system_clock::now())
 {
-  timer_ = new QTimer(this);
-  timer_->setInterval(updateInterval_ * 1000);
-  connect( timer_, SIGNAL(timeout()), this, SLOT(scanTemperatures()) );
+  // scanTemperatures is virtual, compare the cache to detect changes
+  pollId_ = PollScheduler::instance()->registerParameter(this, port_, "temperatures", PollScheduler::Normal,
+                                                         updateInterval_ * 1000, 4 * updateInterval_ * 1000,
+                                                         [this]() {
+                                                           std::vector<double> temperatures = temperatures_;
+                                                           scanTemperatures();
+                                                           return temperatures != temperatures_;
+                                                         });
 
   setDeviceEnabled(false);
   setControlsEnabled(true);
@@ -55,6 +63,9 @@ void KeithleyModel::initialize() {
     // commands
     sleep(1);
 
+    controller_->SetBinaryReadout(binaryReadout_);
+    controller_->SetContinuousScan(continuousScan_);
+
     setDeviceState(READY);
 
     // Set empty string to disable all channels
@@ -68,6 +79,17 @@ void KeithleyModel::initialize() {
 
     // scanTemperatures();
 
+    // drop the controller when the adapter vanishes and set the multimeter
+    // up again with the cached sensor states once it is back
+    DeviceWatcher::instance()->watch(this, port_,
+                                     [this]() {
+                                       destroyController();
+                                       setDeviceState(OFF);
+                                     },
+                                     [this]() {
+                                       if (state_ == OFF) initialize();
+                                       return state_ == READY;
+                                     });
   }
   catch (int e) {
     // TODO log failure
@@ -76,7 +98,8 @@ void KeithleyModel::initialize() {
 }
 
 void KeithleyModel::setDeviceEnabled(bool enabled) {
-  // Trivial reimplementation as slot.
+  if (!enabled) DeviceWatcher::instance()->unwatch(this);
+
   AbstractDeviceModel<Keithley2700_t>::setDeviceEnabled(enabled);
 
   // scanTemperatures();
@@ -86,10 +109,7 @@ void KeithleyModel::setDeviceState(State state) {
   if (state_ != state) {
     state_ = state;
 
-    if ( state == READY )
-      timer_->start();
-    else
-      timer_->stop();
+    PollScheduler::instance()->setEnabled(this, state_ == READY);
 
     emit deviceStateChanged(state);
   }
@@ -117,6 +137,7 @@ void KeithleyModel::setSensorEnabled(unsigned int sensor, bool enabled) {
     setSensorState( sensor, INITIALIZING );
     controller_->AddActiveChannels( channel );
     setSensorState( sensor, READY );
+    PollScheduler::instance()->boost(this);
   }
   else if ( !enabled && sensorStates_.at(sensor) == READY ) {
     setSensorState( sensor, CLOSING );
@@ -133,7 +154,21 @@ void KeithleyModel::setUpdateInterval(int updateInterval) {
 
   if (updateInterval<10) return;
   updateInterval_ = updateInterval;
-  timer_->setInterval(updateInterval_ * 1000);
+  PollScheduler::instance()->setIntervals(pollId_, updateInterval_ * 1000, 4 * updateInterval_ * 1000);
+}
+
+/// Transfers the readings in binary instead of ASCII format.
+void KeithleyModel::setBinaryReadout(bool binary) {
+
+  binaryReadout_ = binary;
+  if (state_ == READY) controller_->SetBinaryReadout(binaryReadout_);
+}
+
+/// Keeps the multimeter scanning, a poll only fetches the latest readings.
+void KeithleyModel::setContinuousScan(bool continuous) {
+
+  continuousScan_ = continuous;
+  if (state_ == READY) controller_->SetContinuousScan(continuousScan_);
 }
 
 /// Returns the current cached state of the requested sensor.
@@ -153,6 +188,9 @@ double KeithleyModel::getTemperature(unsigned int sensor) const
   */
 void KeithleyModel::scanTemperatures()
 {
+  // a poll may still be queued when the adapter vanished
+  if (controller_ == NULL) return;
+
   reading_t reading = controller_->Scan();
 
   // Good scan, cache the retrieved temperatures
@@ -203,20 +241,18 @@ void KeithleyModel::scanTemperatures()
     
     NQLog("KeithleyModel", NQLog::Message) << " scanTemperatures failed";
 
-    /*
-    channels_t activeChannels = controller_->GetActiveChannels();
-
-    controller_->Reset();
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-    
-    controller_->SetActiveChannels(activeChannels);
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-
-    */
+    recoverFromFailedScan();
   }
 
+  absoluteTime_ = std::chrono::system_clock::now();
+}
+
+/**
+  Resets the multimeter and restores the scan list. Only done after a
+  failed scan, the reset takes more than a second.
+  */
+void KeithleyModel::recoverFromFailedScan()
+{
   std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
   channels_t activeChannels = controller_->GetActiveChannels();
@@ -230,8 +266,6 @@ void KeithleyModel::scanTemperatures()
   controller_->SetActiveChannels(activeChannels);
   
   std::this_thread::sleep_for(std::chrono::milliseconds(500));
-
-  absoluteTime_ = std::chrono::system_clock::now();
 }
 
 /// Creates a string from sensor number.
@@ -23,6 +23,7 @@
 
 #include "DeviceState.h"
 #include "Ringbuffer.h"
+#include "PollScheduler.h"
 
 #ifdef USE_FAKEIO
 #include "devices/Keithley/Keithley2700Fake.h"
@@ -55,6 +56,8 @@ public:
   const State& getSensorState( unsigned int sensor ) const;
   double getTemperature( unsigned int sensor ) const;
   int getUpdateInterval() const { return updateInterval_; }
+  bool getBinaryReadout() const { return binaryReadout_; }
+  bool getContinuousScan() const { return continuousScan_; }
 
   void statusMessage(const QString & text);
 
@@ -64,6 +67,8 @@ public slots:
   void setSensorEnabled( unsigned int sensor, bool enabled );
   void setControlsEnabled(bool enabled);
   void setUpdateInterval(int updateInterval);
+  void setBinaryReadout(bool binary);
+  void setContinuousScan(bool continuous);
 
 protected:
 
@@ -71,10 +76,12 @@ protected:
 
   void initialize();
 
-  /// Time interval between cache refreshes; in seconds.
   QString port_;
+  /// Time interval between scans while temperatures change; in seconds.
   int updateInterval_;
-  QTimer* timer_;
+  int pollId_;
+  bool binaryReadout_;
+  bool continuousScan_;
 
   // cached config information
   std::vector<State> sensorStates_;
@@ -89,6 +96,7 @@ protected:
   void setSensorState( unsigned int sensor, State state );
 
   static std::string constructString( unsigned int sensor );
+  void recoverFromFailedScan();
 
 protected slots:
 
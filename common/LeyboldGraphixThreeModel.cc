@@ -28,9 +28,12 @@ LeyboldGraphixThreeModel::LeyboldGraphixThreeModel(const char* port,
   for (int i=0;i<3;i++) pressure_[i] = 1.013;
   displayUnit_ = LeyboldGraphixThree_t::DisplayUnit_unknown;
 
-  timer_ = new QTimer(this);
-  timer_->setInterval(updateInterval_ * 1000);
-  connect( timer_, SIGNAL(timeout()), this, SLOT(updateInformation()));
+  const int interval = updateInterval_ * 1000;
+  PollScheduler* scheduler = PollScheduler::instance();
+  scheduler->registerParameter(this, LeyboldGraphixThree_PORT, "pressures", PollScheduler::High,
+                               interval, 4 * interval, [this]() { return updatePressures(); });
+  scheduler->registerParameter(this, LeyboldGraphixThree_PORT, "display unit", PollScheduler::Low,
+                               interval, 12 * interval, [this]() { return updateDisplayUnit(); });
 
   setDeviceEnabled(true);
 
@@ -90,6 +93,7 @@ void LeyboldGraphixThreeModel::setDisplayUnit(LeyboldGraphixThree_t::DisplayUnit
     controller_->SetDisplayUnit(unit);
     displayUnit_ = unit;
     emit informationChanged();
+    PollScheduler::instance()->boost(this);
   }
 }
 
@@ -142,12 +146,8 @@ void LeyboldGraphixThreeModel::setDeviceState( State state )
   if ( state_ != state ) {
     state_ = state;
 
-    // No need to run the timer if the chiller is not ready
-    if ( state_ == READY ) {
-      timer_->start();
-    } else {
-      timer_->stop();
-    }
+    // No need to poll if the controller is not ready
+    PollScheduler::instance()->setEnabled(this, state_ == READY);
 
     emit deviceStateChanged(state);
   }
@@ -163,34 +163,55 @@ void LeyboldGraphixThreeModel::updateInformation()
     // NQLog("LeyboldGraphixThreeModel", NQLog::Debug) << " running in dedicated DAQ thread";
   }
 
-  if ( state_ == READY ) {
+  updatePressures();
+  updateDisplayUnit();
+}
 
-    // unsigned int status = controller_->GetStatus();
+/**
+  Reads status and pressure of all sensors. Returns true if any of them
+  changed.
+  */
+bool LeyboldGraphixThreeModel::updatePressures()
+{
+  if ( state_ != READY ) return false;
 
-    std::array<LeyboldGraphixThree_t::SensorStatus,3> status;
-    std::array<double,3> pressure;
+  std::array<LeyboldGraphixThree_t::SensorStatus,3> status;
+  std::array<double,3> pressure;
 
-    for (int i=0;i<3;++i) {
-      status[i] = controller_->GetSensorStatus(i+1);
-      pressure[i] = controller_->GetPressure(i+1);
-    }
+  for (int i=0;i<3;++i) {
+    status[i] = controller_->GetSensorStatus(i+1);
+    pressure[i] = controller_->GetPressure(i+1);
+  }
 
-    LeyboldGraphixThree_t::DisplayUnit displayUnit = controller_->GetDisplayUnit();
+  if (status == status_ &&
+      pressure == pressure_) return false;
 
-    if (status != status_ ||
-        pressure != pressure_ ||
-        displayUnit != displayUnit_) {
+  status_ = status;
+  pressure_ = pressure;
 
-      status_ = status;
-      pressure_ = pressure;
+  // NQLog("LeyboldGraphixThreeModel", NQLog::Spam) << "information changed";
 
-      displayUnit_ = displayUnit;
+  emit informationChanged();
 
-      // NQLog("LeyboldGraphixThreeModel", NQLog::Spam) << "information changed";
+  return true;
+}
 
-      emit informationChanged();
-    }
-  }
+/**
+  Reads the display unit. Returns true if it changed.
+  */
+bool LeyboldGraphixThreeModel::updateDisplayUnit()
+{
+  if ( state_ != READY ) return false;
+
+  LeyboldGraphixThree_t::DisplayUnit displayUnit = controller_->GetDisplayUnit();
+
+  if (displayUnit == displayUnit_) return false;
+
+  displayUnit_ = displayUnit;
+
+  emit informationChanged();
+
+  return true;
 }
 
 /// Attempts to enable/disable the (communication with) the LeyboldGraphixThree controller.
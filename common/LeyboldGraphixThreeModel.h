@@ -23,6 +23,7 @@
 
 #include "DeviceState.h"
 #include "DeviceParameter.h"
+#include "PollScheduler.h"
 
 #ifdef USE_FAKEIO
 #include "devices/Leybold/LeyboldGraphixThreeFake.h"
@@ -84,12 +85,14 @@ protected:
 
   void initialize();
 
-  /// Time interval between cache refreshes; in seconds.
+  /// Time interval between cache refreshes while values change; in seconds.
   const double updateInterval_;
-  QTimer* timer_;
 
   void setDeviceState(State state);
 
+  bool updatePressures();
+  bool updateDisplayUnit();
+
   std::array<LeyboldGraphixThree_t::SensorStatus,3> status_;
   std::array<double,3> pressure_;
   LeyboldGraphixThree_t::DisplayUnit displayUnit_;
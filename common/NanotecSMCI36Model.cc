@@ -10,6 +10,8 @@
 //                                                                             //
 /////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <QApplication>
 
 #include <nqlogger.h>
@@ -24,7 +26,8 @@ NanotecSMCI36Model::NanotecSMCI36Model(const char* port,
     AbstractDeviceModel<NanotecSMCI36_t>(),
     NanotecSMCI36_PORT(port),
     updateInterval1_(updateInterval1),
-    updateInterval2_(updateInterval2)
+    updateInterval2_(updateInterval2),
+    streamInterval_(0)
 {
   driveAddress_ = 0;
   status_ = 0xffff;
@@ -64,6 +67,9 @@ NanotecSMCI36Model::NanotecSMCI36Model(const char* port,
   timer2_->setInterval(updateInterval2_ * 1000);
   connect( timer2_, SIGNAL(timeout()), this, SLOT(updateInformation2()) );
 
+  streamTimer_ = new QTimer(this);
+  connect( streamTimer_, SIGNAL(timeout()), this, SLOT(updateInformation1()) );
+
   setDeviceEnabled(true);
 
   NQLog("NanotecSMCI36Model") << "constructed";
@@ -430,6 +436,19 @@ void NanotecSMCI36Model::start()
     emit motionStarted();
 
     controller_->Start();
+
+    if (streamInterval_ > 0) streamTimer_->start(streamInterval_);
+  }
+}
+
+void NanotecSMCI36Model::setPositionStreaming(int interval)
+{
+  streamInterval_ = std::max(interval, 0);
+
+  if (streamInterval_ == 0) {
+    streamTimer_->stop();
+  } else if (streamTimer_->isActive()) {
+    streamTimer_->setInterval(streamInterval_);
   }
 }
 
@@ -701,6 +720,7 @@ void NanotecSMCI36Model::setDeviceState( State state )
     } else {
       timer1_->stop();
       timer2_->stop();
+      streamTimer_->stop();
     }
 
     emit deviceStateChanged(state);
@@ -719,11 +739,14 @@ void NanotecSMCI36Model::updateInformation1()
 
   if ( state_ == READY ) {
 
-    unsigned int status = controller_->GetStatus();
-    int controllerSteps = controller_->GetPosition();
-    int encoderSteps = controller_->GetEncoderPosition();
+    unsigned int status;
+    int controllerSteps;
+    int encoderSteps;
+    unsigned int io;
+    controller_->GetMotionStatus(status, controllerSteps, encoderSteps, io);
 
-    unsigned int io = controller_->GetIO();
+    // the motor has stopped, fall back to the regular update interval
+    if (status & VNanotecSMCI36::smciReady) streamTimer_->stop();
 
     if (status != status_ ||
         controllerSteps != controllerSteps_ ||
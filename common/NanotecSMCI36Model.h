@@ -140,6 +140,10 @@ public:
   void setOutputPinFunction(int pin, int function);
   void setOutputPolarity(int pin, bool reverse);
 
+  /// Polls status and position every interval ms while the motor is moving, 0 disables.
+  void setPositionStreaming(int interval);
+  int getPositionStreaming() const { return streamInterval_; }
+
 public slots:
 
   void setDeviceEnabled(bool enabled);
@@ -174,6 +178,8 @@ protected:
   QTimer* timer1_;
   const double updateInterval2_;
   QTimer* timer2_;
+  int streamInterval_;
+  QTimer* streamTimer_;
 
   void setDeviceState( State state );
 
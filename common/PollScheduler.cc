@@ -0,0 +1,296 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <nqlogger.h>
+
+#include "PollScheduler.h"
+
+PollScheduler* PollScheduler::instance()
+{
+  static PollScheduler* scheduler = []() {
+    PollScheduler* s = new PollScheduler();
+    if (QCoreApplication::instance()) s->moveToThread(QCoreApplication::instance()->thread());
+    return s;
+  }();
+
+  return scheduler;
+}
+
+PollScheduler::PollScheduler()
+  : QObject(),
+    nextId_(0)
+{
+  timer_ = new QTimer(this);
+  timer_->setSingleShot(true);
+  connect(timer_, SIGNAL(timeout()), this, SLOT(schedule()));
+
+  clock_.start();
+}
+
+int PollScheduler::registerParameter(QObject* owner,
+                                     const QString& bus,
+                                     const QString& name,
+                                     Priority priority,
+                                     int minInterval,
+                                     int maxInterval,
+                                     std::function<bool()> poll)
+{
+  QMutexLocker locker(&mutex_);
+
+  bool known = std::any_of(parameters_.begin(), parameters_.end(),
+                           [owner](const std::pair<const int,Parameter>& p) { return p.second.owner==owner; });
+  if (!known) {
+    connect(owner, &QObject::destroyed, this,
+            [this, owner]() { unregisterParameters(owner); }, Qt::DirectConnection);
+  }
+
+  Parameter parameter;
+  parameter.owner = owner;
+  parameter.bus = bus;
+  parameter.name = name;
+  parameter.priority = priority;
+  parameter.minInterval = std::max(minInterval, 1);
+  parameter.maxInterval = std::max(maxInterval, parameter.minInterval);
+  parameter.poll = poll;
+  parameter.interval = parameter.minInterval;
+  parameter.due = 0;
+  parameter.enabled = false;
+  parameter.inFlight = false;
+
+  int id = nextId_++;
+  parameters_[id] = parameter;
+
+  NQLog("PollScheduler", NQLog::Debug) << "registerParameter: "
+                                       << bus << " " << name
+                                       << " [" << parameter.minInterval << ", "
+                                       << parameter.maxInterval << "] ms";
+
+  return id;
+}
+
+void PollScheduler::unregisterParameters(QObject* owner)
+{
+  QMutexLocker locker(&mutex_);
+
+  for (auto it = parameters_.begin(); it!=parameters_.end(); ) {
+    if (it->second.owner==owner) {
+      // the reply will never arrive if the owner is being destroyed
+      if (it->second.inFlight) bus(it->second.bus).busy = false;
+      it = parameters_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void PollScheduler::setEnabled(QObject* owner, bool enabled)
+{
+  {
+    QMutexLocker locker(&mutex_);
+
+    qint64 now = clock_.elapsed();
+    for (auto& p : parameters_) {
+      Parameter& parameter = p.second;
+      if (parameter.owner!=owner) continue;
+      if (enabled && !parameter.enabled) {
+        parameter.interval = parameter.minInterval;
+        parameter.due = now;
+      }
+      parameter.enabled = enabled;
+    }
+  }
+
+  requestSchedule();
+}
+
+void PollScheduler::boost(QObject* owner)
+{
+  {
+    QMutexLocker locker(&mutex_);
+
+    qint64 now = clock_.elapsed();
+    for (auto& p : parameters_) {
+      Parameter& parameter = p.second;
+      if (parameter.owner!=owner) continue;
+      parameter.interval = parameter.minInterval;
+      parameter.due = std::min(parameter.due, now);
+    }
+  }
+
+  requestSchedule();
+}
+
+void PollScheduler::setIntervals(int id, int minInterval, int maxInterval)
+{
+  {
+    QMutexLocker locker(&mutex_);
+
+    auto it = parameters_.find(id);
+    if (it==parameters_.end()) return;
+
+    Parameter& parameter = it->second;
+    parameter.minInterval = std::max(minInterval, 1);
+    parameter.maxInterval = std::max(maxInterval, parameter.minInterval);
+    parameter.interval = parameter.minInterval;
+    if (!parameter.inFlight) parameter.due = clock_.elapsed() + parameter.interval;
+  }
+
+  requestSchedule();
+}
+
+void PollScheduler::setBusBudget(const QString& name, double budget)
+{
+  QMutexLocker locker(&mutex_);
+
+  bus(name).budget = std::min(std::max(budget, 0.01), 1.0);
+}
+
+int PollScheduler::interval(int id)
+{
+  QMutexLocker locker(&mutex_);
+
+  auto it = parameters_.find(id);
+  if (it==parameters_.end()) return 0;
+
+  return it->second.interval;
+}
+
+//! Returns the bus, creating it with the default budget if needed.
+/*!
+  \internal
+  Has to be called with the mutex locked.
+*/
+PollScheduler::Bus& PollScheduler::bus(const QString& name)
+{
+  auto it = buses_.find(name);
+  if (it==buses_.end()) {
+    Bus b;
+    b.budget = defaultBusBudget_;
+    b.freeAt = 0;
+    b.busy = false;
+    it = buses_.insert(std::make_pair(name, b)).first;
+  }
+
+  return it->second;
+}
+
+void PollScheduler::requestSchedule()
+{
+  QMetaObject::invokeMethod(this, "schedule", Qt::QueuedConnection);
+}
+
+void PollScheduler::schedule()
+{
+  QMutexLocker locker(&mutex_);
+
+  qint64 now = clock_.elapsed();
+
+  // due parameters by priority, the longest overdue first
+  std::vector<std::tuple<int,qint64,int> > candidates;
+  for (auto& p : parameters_) {
+    const Parameter& parameter = p.second;
+    if (!parameter.enabled || parameter.inFlight || parameter.due>now) continue;
+    candidates.push_back(std::make_tuple(parameter.priority, parameter.due, p.first));
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  for (auto& candidate : candidates) {
+    int id = std::get<2>(candidate);
+    Parameter& parameter = parameters_[id];
+    Bus& b = bus(parameter.bus);
+
+    if (b.busy) continue;
+    if (parameter.priority!=High && now<b.freeAt) continue;
+
+    dispatch(id, parameter);
+  }
+
+  // wake up again when the next parameter can be served; busy buses
+  // trigger a new schedule when their poll has finished
+  qint64 next = std::numeric_limits<qint64>::max();
+  for (auto& p : parameters_) {
+    const Parameter& parameter = p.second;
+    if (!parameter.enabled || parameter.inFlight) continue;
+
+    const Bus& b = bus(parameter.bus);
+    if (b.busy) continue;
+
+    qint64 t = parameter.due;
+    if (parameter.priority!=High) t = std::max(t, b.freeAt);
+    next = std::min(next, t);
+  }
+
+  if (next==std::numeric_limits<qint64>::max()) {
+    timer_->stop();
+  } else {
+    timer_->start(static_cast<int>(std::max<qint64>(next - now, 0)));
+  }
+}
+
+//! Queues the poll of a parameter in the thread of its owner.
+/*!
+  \internal
+  Has to be called with the mutex locked.
+*/
+void PollScheduler::dispatch(int id, Parameter& parameter)
+{
+  parameter.inFlight = true;
+  bus(parameter.bus).busy = true;
+
+  const QString busName = parameter.bus;
+  const std::function<bool()> poll = parameter.poll;
+
+  QMetaObject::invokeMethod(parameter.owner, [this, id, busName, poll]() {
+      QElapsedTimer timer;
+      timer.start();
+      bool changed = poll();
+      finished(id, busName, changed, timer.elapsed());
+    }, Qt::QueuedConnection);
+}
+
+void PollScheduler::finished(int id, const QString& busName, bool changed, qint64 duration)
+{
+  {
+    QMutexLocker locker(&mutex_);
+
+    qint64 now = clock_.elapsed();
+
+    Bus& b = bus(busName);
+    b.busy = false;
+    b.freeAt = now + static_cast<qint64>(duration * (1.0 - b.budget) / b.budget);
+
+    auto it = parameters_.find(id);
+    if (it!=parameters_.end()) {
+      Parameter& parameter = it->second;
+      parameter.inFlight = false;
+
+      if (changed) {
+        parameter.interval = parameter.minInterval;
+      } else {
+        parameter.interval = std::min(parameter.maxInterval,
+                                      parameter.interval + parameter.interval/2 + 1);
+      }
+      parameter.due = now + parameter.interval;
+    }
+  }
+
+  requestSchedule();
+}
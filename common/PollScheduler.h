@@ -0,0 +1,144 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef POLLSCHEDULER_H
+#define POLLSCHEDULER_H
+
+#include <functional>
+#include <map>
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QMutex>
+#include <QElapsedTimer>
+
+/** @addtogroup common
+ *  @{
+ */
+
+/**
+  \brief Central scheduler for the periodic read out of device models.
+
+  Instead of owning a fixed interval timer, a model registers each group
+  of values it caches as a parameter with a poll function. The poll
+  function reads the device, updates the cache and returns true if any
+  value changed.
+
+  The poll interval of a parameter adapts between its minimum and maximum
+  interval: it drops to the minimum whenever the poll reported a change
+  or the owner called boost() (e.g. after a new setpoint was sent), and
+  grows by half after every poll without change.
+
+  Parameters are grouped by bus, normally the device file of the
+  controller. Only one poll per bus is in flight at any time and after
+  each poll the bus is kept idle so that it is busy at most for the
+  fraction given by setBusBudget(). Due parameters are served in order of
+  priority; High priority parameters ignore the budget.
+
+  Poll functions are executed in the thread of their owner, so models
+  moved to a DAQ thread keep doing their device I/O there. The scheduler
+  itself lives in the main application thread and all methods are thread
+  safe.
+  */
+class PollScheduler : public QObject
+{
+  Q_OBJECT
+
+public:
+
+  enum Priority {
+    High   = 0,
+    Normal = 1,
+    Low    = 2
+  };
+
+  static PollScheduler* instance();
+
+  /**
+    Registers a parameter of owner and returns its id. Intervals are given
+    in milliseconds. Polling starts once the owner enables it with
+    setEnabled().
+    */
+  int registerParameter(QObject* owner,
+                        const QString& bus,
+                        const QString& name,
+                        Priority priority,
+                        int minInterval,
+                        int maxInterval,
+                        std::function<bool()> poll);
+
+  /// Removes all parameters of owner.
+  void unregisterParameters(QObject* owner);
+
+  /// Starts or stops polling all parameters of owner.
+  void setEnabled(QObject* owner, bool enabled);
+
+  /// Polls all parameters of owner as soon as possible at their minimum interval.
+  void boost(QObject* owner);
+
+  /// Changes the interval range of a parameter, e.g. on a new update interval.
+  void setIntervals(int id, int minInterval, int maxInterval);
+
+  /// Maximum fraction of time (0..1] the bus may be busy with polling.
+  void setBusBudget(const QString& bus, double budget);
+
+  /// Current poll interval of a parameter in milliseconds.
+  int interval(int id);
+
+protected slots:
+
+  void schedule();
+
+protected:
+
+  explicit PollScheduler();
+
+  struct Parameter {
+    QObject* owner;
+    QString bus;
+    QString name;
+    Priority priority;
+    int minInterval;
+    int maxInterval;
+    std::function<bool()> poll;
+    int interval;
+    qint64 due;
+    bool enabled;
+    bool inFlight;
+  };
+
+  struct Bus {
+    double budget;
+    qint64 freeAt;
+    bool busy;
+  };
+
+  Bus& bus(const QString& name);
+  void dispatch(int id, Parameter& parameter);
+  void finished(int id, const QString& bus, bool changed, qint64 duration);
+  void requestSchedule();
+
+  QMutex mutex_;
+  QElapsedTimer clock_;
+  QTimer* timer_;
+
+  int nextId_;
+  std::map<int,Parameter> parameters_;
+  std::map<QString,Bus> buses_;
+
+  static constexpr double defaultBusBudget_ = 0.5;
+};
+
+/** @} */
+
+#endif // POLLSCHEDULER_H
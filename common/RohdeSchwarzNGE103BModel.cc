@@ -41,9 +41,12 @@ RohdeSchwarzNGE103BModel::RohdeSchwarzNGE103BModel(const char* port,
     measuredCurrentHistory_[i] = ValueHistory<float>(updateInterval_, 2*60.*60.);
   }
 
-  timer_ = new QTimer(this);
-  timer_->setInterval(updateInterval_ * 1000);
-  connect( timer_, SIGNAL(timeout()), this, SLOT(updateInformation()) );
+  const int interval = updateInterval_ * 1000;
+  PollScheduler* scheduler = PollScheduler::instance();
+  scheduler->registerParameter(this, RohdeSchwarzNGE103B_PORT, "measurements", PollScheduler::High,
+                               interval, interval, [this]() { return updateMeasurements(); });
+  scheduler->registerParameter(this, RohdeSchwarzNGE103B_PORT, "settings", PollScheduler::Low,
+                               interval, 12 * interval, [this]() { return updateSettings(); });
 
   setDeviceEnabled(true);
 }
@@ -70,7 +73,9 @@ void RohdeSchwarzNGE103BModel::setOutputState(int channel, bool state)
 
   outputState_[channel-1] = state;
 
-  updateInformation();
+  emit informationChanged();
+
+  PollScheduler::instance()->boost(this);
 
   if (easyRampState_[channel-1]) {
     QTimer::singleShot(1000*easyRampDuration_[channel-1], this,
@@ -109,7 +114,9 @@ void RohdeSchwarzNGE103BModel::setVoltage(int channel, float voltage)
 
   voltage_[channel-1] = voltage;
 
-  updateInformation();
+  emit informationChanged();
+
+  PollScheduler::instance()->boost(this);
 }
 
 float RohdeSchwarzNGE103BModel::getMeasuredVoltage(int channel) const
@@ -149,7 +156,9 @@ void RohdeSchwarzNGE103BModel::setCurrent(int channel, float current)
 
   current_[channel-1] = current;
 
-  updateInformation();
+  emit informationChanged();
+
+  PollScheduler::instance()->boost(this);
 }
 
 float RohdeSchwarzNGE103BModel::getMeasuredCurrent(int channel) const
@@ -190,6 +199,8 @@ void RohdeSchwarzNGE103BModel::setEasyRampDuration(int channel, float duration)
   easyRampDuration_[channel-1] = duration;
 
   emit informationChanged();
+
+  PollScheduler::instance()->boost(this);
 }
 
 bool RohdeSchwarzNGE103BModel::getEasyRampState(int channel) const
@@ -215,6 +226,8 @@ void RohdeSchwarzNGE103BModel::setEasyRampState(int channel, bool state)
   easyRampState_[channel-1] = state;
 
   emit informationChanged();
+
+  PollScheduler::instance()->boost(this);
 }
 
 /**
@@ -246,11 +259,8 @@ void RohdeSchwarzNGE103BModel::setDeviceState( State state )
   if ( state_ != state ) {
     state_ = state;
 
-    // No need to run the timer if the chiller is not ready
-    if ( state_ == READY )
-      timer_->start();
-    else
-      timer_->stop();
+    // No need to poll if the power supply is not ready
+    PollScheduler::instance()->setEnabled(this, state_ == READY);
 
     emit deviceStateChanged(state);
   }
@@ -270,58 +280,93 @@ void RohdeSchwarzNGE103BModel::updateInformation()
     NQLogDebug("RohdeSchwarzNGE103BModel") << "running in dedicated DAQ thread";
   }
 
-  if (state_ == READY) {
-
-    std::array<bool,3> newOutputState;
-    std::array<unsigned int,3> newOutputMode;
-    std::array<float,3> newVoltage;
-    std::array<float,3> newMeasuredVoltage;
-    std::array<float,3> newCurrent;
-    std::array<float,3> newMeasuredCurrent;
-    std::array<float,3> newEasyRampDuration;
-    std::array<bool,3> newEasyRampState;
-
-    for (unsigned int c=0;c<3;++c) {
-      controller_->SelectChannel(c+1);
-
-      newOutputState[c] = controller_->GetOutputState();
-      newOutputMode[c] = controller_->GetOutputMode();
-      newVoltage[c] = controller_->GetVoltage();
-      newMeasuredVoltage[c] = controller_->MeasureVoltage();
-      newCurrent[c] = controller_->GetCurrent();
-      newMeasuredCurrent[c] = controller_->MeasureCurrent();
-      newEasyRampDuration[c] = controller_->GetEasyRampDuration();
-      newEasyRampState[c] = controller_->GetEasyRampState();
-    }
-
-    if (newOutputState!=outputState_ ||
-        newOutputMode!=outputMode_ ||
-        newVoltage!=voltage_ ||
-        newMeasuredVoltage!=measuredVoltage_ ||
-        newCurrent!=current_ ||
-        newMeasuredCurrent!=measuredCurrent_ ||
-        newEasyRampDuration!=easyRampDuration_ ||
-        newEasyRampState!=easyRampState_) {
-
-      outputState_ = newOutputState;
-      outputMode_ = newOutputMode;
-      voltage_ = newVoltage;
-      measuredVoltage_ = newMeasuredVoltage;
-      current_ = newCurrent;
-      measuredCurrent_ = newMeasuredCurrent;
-      easyRampDuration_ = newEasyRampDuration;
-      easyRampState_ = newEasyRampState;
-
-      NQLogDebug("RohdeSchwarzNGE103BModel") << "information changed";
-
-      emit informationChanged();
-    }
-
-    for (unsigned int c=0;c<3;++c) {
-      measuredVoltageHistory_[c].push(measuredVoltage_[c]);
-      measuredCurrentHistory_[c].push(measuredCurrent_[c]);
-    }
+  updateSettings();
+  updateMeasurements();
+}
+
+/**
+  Reads output state, mode, setpoints and ramp settings of all channels.
+  Returns true if any of them changed.
+  */
+bool RohdeSchwarzNGE103BModel::updateSettings()
+{
+  if (state_ != READY) return false;
+
+  std::array<bool,3> newOutputState;
+  std::array<unsigned int,3> newOutputMode;
+  std::array<float,3> newVoltage;
+  std::array<float,3> newCurrent;
+  std::array<float,3> newEasyRampDuration;
+  std::array<bool,3> newEasyRampState;
+
+  for (unsigned int c=0;c<3;++c) {
+    controller_->SelectChannel(c+1);
+
+    newOutputState[c] = controller_->GetOutputState();
+    newOutputMode[c] = controller_->GetOutputMode();
+    newVoltage[c] = controller_->GetVoltage();
+    newCurrent[c] = controller_->GetCurrent();
+    newEasyRampDuration[c] = controller_->GetEasyRampDuration();
+    newEasyRampState[c] = controller_->GetEasyRampState();
+  }
+
+  if (newOutputState==outputState_ &&
+      newOutputMode==outputMode_ &&
+      newVoltage==voltage_ &&
+      newCurrent==current_ &&
+      newEasyRampDuration==easyRampDuration_ &&
+      newEasyRampState==easyRampState_) return false;
+
+  outputState_ = newOutputState;
+  outputMode_ = newOutputMode;
+  voltage_ = newVoltage;
+  current_ = newCurrent;
+  easyRampDuration_ = newEasyRampDuration;
+  easyRampState_ = newEasyRampState;
+
+  NQLogDebug("RohdeSchwarzNGE103BModel") << "information changed";
+
+  emit informationChanged();
+
+  return true;
+}
+
+/**
+  Reads the measured voltage and current of all channels and appends them
+  to the histories. Returns true if any of them changed.
+  */
+bool RohdeSchwarzNGE103BModel::updateMeasurements()
+{
+  if (state_ != READY) return false;
+
+  std::array<float,3> newMeasuredVoltage;
+  std::array<float,3> newMeasuredCurrent;
+
+  for (unsigned int c=0;c<3;++c) {
+    controller_->SelectChannel(c+1);
+
+    newMeasuredVoltage[c] = controller_->MeasureVoltage();
+    newMeasuredCurrent[c] = controller_->MeasureCurrent();
+  }
+
+  bool changed = (newMeasuredVoltage!=measuredVoltage_ ||
+                  newMeasuredCurrent!=measuredCurrent_);
+
+  measuredVoltage_ = newMeasuredVoltage;
+  measuredCurrent_ = newMeasuredCurrent;
+
+  for (unsigned int c=0;c<3;++c) {
+    measuredVoltageHistory_[c].push(measuredVoltage_[c]);
+    measuredCurrentHistory_[c].push(measuredCurrent_[c]);
   }
+
+  if (changed) {
+    NQLogDebug("RohdeSchwarzNGE103BModel") << "information changed";
+
+    emit informationChanged();
+  }
+
+  return changed;
 }
 
 /// Attempts to enable/disable the (communication with) the RohdeSchwarzNGE103B power supply.
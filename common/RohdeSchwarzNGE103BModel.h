@@ -22,6 +22,7 @@
 #include "DeviceState.h"
 #include "DeviceParameter.h"
 #include "ValueHistory.h"
+#include "PollScheduler.h"
 
 #ifdef USE_FAKEIO
 #include "devices/RohdeSchwarz/RohdeSchwarzNGE103BFake.h"
@@ -71,12 +72,15 @@ protected:
 
   void initialize();
 
-  /// Time interval between cache refreshes; in seconds.
+  /// Time interval between cache refreshes; in seconds. Measured values
+  /// are read at this fixed rate to keep the histories equidistant.
   const double updateInterval_;
-  QTimer* timer_;
 
   void setDeviceState( State state );
 
+  bool updateSettings();
+  bool updateMeasurements();
+
   DeviceParameterFloat voltageParameter_;
   DeviceParameterFloat currentParameter_;
   DeviceParameterFloat easyRampDurationParameter_;
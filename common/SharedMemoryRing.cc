@@ -0,0 +1,254 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include "SharedMemoryRing.h"
+
+struct SharedMemoryRing::Header
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t recordSize;
+  uint64_t capacity;
+  std::atomic<uint64_t> sequence;
+  std::atomic<uint32_t> futex;
+};
+
+namespace {
+
+const uint32_t SharedMemoryRingMagic = 0x544B4D4C; // "TKML"
+const uint32_t SharedMemoryRingVersion = 1;
+
+// every slot starts with its sequence number, followed by the record
+std::atomic<uint64_t>* slotSequence(char* slot)
+{
+  return reinterpret_cast<std::atomic<uint64_t>*>(slot);
+}
+
+char* slotData(char* slot)
+{
+  return slot + sizeof(std::atomic<uint64_t>);
+}
+
+#ifdef __linux__
+long futex(std::atomic<uint32_t>* addr, int op, uint32_t val, const struct timespec* timeout)
+{
+  return syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr), op, val, timeout, nullptr, 0);
+}
+#endif
+
+}
+
+SharedMemoryRing::SharedMemoryRing(const std::string& name,
+                                   std::size_t recordSize,
+                                   std::size_t capacity,
+                                   Mode mode)
+  : name_(name),
+    recordSize_(recordSize),
+    capacity_(capacity),
+    mode_(mode),
+    mappedSize_(0),
+    header_(nullptr),
+    slots_(nullptr)
+{
+  const std::size_t align = alignof(std::atomic<uint64_t>);
+  slotSize_ = sizeof(std::atomic<uint64_t>) + recordSize_;
+  slotSize_ = (slotSize_ + align - 1) / align * align;
+
+  std::size_t headerSize = (sizeof(Header) + 63) / 64 * 64;
+  mappedSize_ = headerSize + capacity_ * slotSize_;
+
+  int fd;
+  if (mode_==Writer) {
+    // a stale segment of a previous writer is replaced, readers still
+    // attached to it notice via their wait() timeout and reattach
+    shm_unlink(name_.c_str());
+    fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+    if (fd<0) return;
+    fchmod(fd, 0666);
+    if (ftruncate(fd, mappedSize_)!=0) {
+      close(fd);
+      shm_unlink(name_.c_str());
+      return;
+    }
+  } else {
+    fd = shm_open(name_.c_str(), O_RDONLY, 0);
+    if (fd<0) return;
+    struct stat st;
+    if (fstat(fd, &st)!=0 || (std::size_t)st.st_size<mappedSize_) {
+      close(fd);
+      return;
+    }
+  }
+
+  void* addr = mmap(nullptr, mappedSize_,
+                    mode_==Writer ? PROT_READ | PROT_WRITE : PROT_READ,
+                    MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr==MAP_FAILED) return;
+
+  Header* header = static_cast<Header*>(addr);
+
+  if (mode_==Writer) {
+    std::memset(addr, 0, mappedSize_);
+    header->recordSize = recordSize_;
+    header->capacity = capacity_;
+    header->version = SharedMemoryRingVersion;
+    header->sequence.store(0);
+    header->futex.store(0);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = SharedMemoryRingMagic;
+  } else {
+    if (header->magic!=SharedMemoryRingMagic ||
+        header->version!=SharedMemoryRingVersion ||
+        header->recordSize!=recordSize_ ||
+        header->capacity!=capacity_) {
+      munmap(addr, mappedSize_);
+      return;
+    }
+  }
+
+  header_ = header;
+  slots_ = static_cast<char*>(addr) + headerSize;
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+  if (!header_) return;
+
+  munmap(header_, mappedSize_);
+  if (mode_==Writer) shm_unlink(name_.c_str());
+}
+
+uint64_t SharedMemoryRing::sequence() const
+{
+  if (!header_) return 0;
+  return header_->sequence.load(std::memory_order_acquire);
+}
+
+bool SharedMemoryRing::write(const void* record)
+{
+  if (!header_ || mode_!=Writer) return false;
+
+  uint64_t seq = header_->sequence.load(std::memory_order_relaxed) + 1;
+  char* slot = slots_ + (seq % capacity_) * slotSize_;
+
+  // odd slot sequence marks a write in progress
+  slotSequence(slot)->store(2*seq-1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(slotData(slot), record, recordSize_);
+  slotSequence(slot)->store(2*seq, std::memory_order_release);
+
+  header_->sequence.store(seq, std::memory_order_release);
+
+  header_->futex.fetch_add(1, std::memory_order_release);
+#ifdef __linux__
+  futex(&header_->futex, FUTEX_WAKE, INT_MAX, nullptr);
+#endif
+
+  return true;
+}
+
+bool SharedMemoryRing::readSlot(uint64_t seq, void* record) const
+{
+  char* slot = slots_ + (seq % capacity_) * slotSize_;
+
+  uint64_t before = slotSequence(slot)->load(std::memory_order_acquire);
+  if (before!=2*seq) return false;
+
+  std::memcpy(record, slotData(slot), recordSize_);
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  uint64_t after = slotSequence(slot)->load(std::memory_order_relaxed);
+  return after==before;
+}
+
+bool SharedMemoryRing::read(void* record, uint64_t& cursor) const
+{
+  if (!header_) return false;
+
+  uint64_t seq = sequence();
+
+  while (cursor<seq) {
+    uint64_t next = cursor + 1;
+
+    // skip records that have already been overwritten
+    if (seq-next>=capacity_) next = seq - capacity_ + 1;
+
+    if (readSlot(next, record)) {
+      cursor = next;
+      return true;
+    }
+
+    // overwritten while copying, retry with the newest state
+    cursor = next;
+    seq = sequence();
+  }
+
+  return false;
+}
+
+bool SharedMemoryRing::readLatest(void* record) const
+{
+  if (!header_) return false;
+
+  for (int i=0;i<3;++i) {
+    uint64_t seq = sequence();
+    if (seq==0) return false;
+    if (readSlot(seq, record)) return true;
+  }
+
+  return false;
+}
+
+bool SharedMemoryRing::wait(uint64_t cursor, int timeout) const
+{
+  if (!header_) return false;
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+  while (true) {
+    uint32_t word = header_->futex.load(std::memory_order_acquire);
+
+    if (sequence()>cursor) return true;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now>=deadline) return false;
+
+#ifdef __linux__
+    auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+    struct timespec ts;
+    ts.tv_sec = remaining.count() / 1000000000;
+    ts.tv_nsec = remaining.count() % 1000000000;
+    futex(&header_->futex, FUTEX_WAIT, word, &ts);
+#else
+    (void)word;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+  }
+}
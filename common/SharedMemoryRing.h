@@ -0,0 +1,96 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SHAREDMEMORYRING_H
+#define SHAREDMEMORYRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/** @addtogroup common
+ *  @{
+ */
+
+/**
+  \brief Single producer, multiple consumer ring of fixed size records in
+  POSIX shared memory.
+
+  Used as a local transport between a DAQ daemon and display clients on
+  the same host. The writer never blocks; readers that fall behind by more
+  than the ring capacity skip to the oldest record still available. Every
+  slot is protected by a sequence number (seqlock), so readers detect
+  records that were overwritten while being copied. On Linux readers sleep
+  on a futex in the shared segment and are woken by the writer, elsewhere
+  wait() falls back to polling.
+
+  Clients are expected to keep their existing network path as fallback if
+  isValid() returns false, i.e. if no writer has created the segment.
+  */
+class SharedMemoryRing
+{
+public:
+
+  enum Mode {
+    Reader = 0,
+    Writer = 1
+  };
+
+  SharedMemoryRing(const std::string& name,
+                   std::size_t recordSize,
+                   std::size_t capacity,
+                   Mode mode);
+  ~SharedMemoryRing();
+
+  bool isValid() const { return header_!=nullptr; }
+  const std::string& name() const { return name_; }
+
+  /// Number of records written since the segment was created.
+  uint64_t sequence() const;
+
+  /// Appends a record (writer only) and wakes all waiting readers.
+  bool write(const void* record);
+
+  /**
+    Copies the record following cursor into record and advances cursor.
+    Returns false if no new record is available.
+    */
+  bool read(void* record, uint64_t& cursor) const;
+
+  /// Copies the most recent record into record.
+  bool readLatest(void* record) const;
+
+  /**
+    Blocks until a record newer than cursor is available or timeout
+    milliseconds have passed. Returns true if new data is available.
+    */
+  bool wait(uint64_t cursor, int timeout) const;
+
+protected:
+
+  struct Header;
+
+  bool readSlot(uint64_t seq, void* record) const;
+
+  std::string name_;
+  std::size_t recordSize_;
+  std::size_t slotSize_;
+  std::size_t capacity_;
+  Mode mode_;
+  std::size_t mappedSize_;
+  Header* header_;
+  char* slots_;
+};
+
+/** @} */
+
+#endif // SHAREDMEMORYRING_H
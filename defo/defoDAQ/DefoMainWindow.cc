@@ -27,6 +27,8 @@ DefoMainWindow::DefoMainWindow(QWidget *parent) :
   // KEITHLEY MODEL
   keithleyModel_ = new DefoKeithleyModel(config->getValue<std::string>("KeithleyDevice").c_str(),
 					 20, this);
+  keithleyModel_->setBinaryReadout(config->getValue<int>("KeithleyBinaryReadout", 0));
+  keithleyModel_->setContinuousScan(config->getValue<int>("KeithleyContinuousScan", 0));
 
   daqModel_ = new DefoDAQModel(conradModel_,
 			       julaboModel_,
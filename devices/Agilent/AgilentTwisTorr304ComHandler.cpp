@@ -12,6 +12,7 @@
 
 #include <string.h>
 
+#include "SerialTransport.h"
 #include "AgilentTwisTorr304ComHandler.h"
 
 AgilentTwisTorr304ComHandler::AgilentTwisTorr304ComHandler( const ioport_t ioPort )
@@ -29,74 +30,37 @@ AgilentTwisTorr304ComHandler::AgilentTwisTorr304ComHandler( const ioport_t ioPor
 ///
 AgilentTwisTorr304ComHandler::~AgilentTwisTorr304ComHandler( void )
 {
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
 void AgilentTwisTorr304ComHandler::SendCommand( const char *commandString )
 {
-  char singleCharacter = 0; 
+  // command and feed character ( <NL> ) in a single write
+  std::string command = commandString;
+  command += "\n";
 
-  for ( unsigned int i = 0; i < strlen( commandString ); i++ ) {
-    
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
-  }
-
-//   std::cout << "write: " << commandString << std::endl;
-
-  // send feed characters
-  SendFeedString();
+  fTransport->Write( command );
 }
 
 //! flush the IO memory
 void AgilentTwisTorr304ComHandler::flush(void)
 {
-  sleep(2);
-  if(tcflush(fIoPortFileDescriptor, TCIOFLUSH)==0)
-    printf("The input and output queues have been flushed\n\n");
-    else{
-      perror("tcflush error");
-    }
-    sleep(1);
+  fTransport->Flush();
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
-
-  This function must be placed right in time before
-  the device starts sending.
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  See example program in class description.
+  Waits until the device has sent a complete telegram (<ETX> followed
+  by the two CRC characters) or the timeout has expired.
 */
 void AgilentTwisTorr304ComHandler::ReceiveString( char *receiveString )
 {
-  usleep( ComHandlerDelay );
-
-  int timeout = 0, readResult = 0;
-
-  while ( timeout < 10 )  {
-
-    usleep( 100000 );
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-
-    if ( readResult > 0 ) {
-      receiveString[readResult] = 0;
-//       std::cout << "read: " << readResult << " " << receiveString << std::endl;
-      return;
-    }
-    timeout++;
-  }
-
-  //std::cout << "timeout" << std::endl;
+  fTransport->Read( receiveString, 1000 );
 }
 
 //! Open I/O port.
@@ -105,19 +69,16 @@ void AgilentTwisTorr304ComHandler::ReceiveString( char *receiveString )
 */
 void AgilentTwisTorr304ComHandler::OpenIoPort( void ) noexcept(false)
 {
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
 
   // check if successful
-  if ( fIoPortFileDescriptor == -1 ) {
-    std::cerr << "[Iota300ComHandler::OpenIoPort] ** ERROR: could not open device file "
+  if ( !fTransport->Open() ) {
+    std::cerr << "[AgilentTwisTorr304ComHandler::OpenIoPort] ** ERROR: could not open device file "
 	      << fIoPort << "." << std::endl;
     std::cerr << "                               (probably it's not user-writable)."
           << std::endl;
+    delete fTransport;
     throw int(-1);
-  } else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
   }
 }
 
@@ -127,10 +88,10 @@ void AgilentTwisTorr304ComHandler::OpenIoPort( void ) noexcept(false)
 */
 void AgilentTwisTorr304ComHandler::InitializeIoPort( void )
 {
-#ifndef USE_FAKEIO
+  // telegrams end with <ETX> and two CRC characters
+  fTransport->SetTerminator( "\x03", 2 );
 
-  // get and save current ioport settings for later restoring
-  tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
+#ifndef USE_FAKEIO
 
   // CONFIGURE NEW SETTINGS
 
@@ -156,35 +117,7 @@ void AgilentTwisTorr304ComHandler::InitializeIoPort( void )
   fThisTermios.c_lflag &= ~(ICANON | ECHO | ISIG);
 
   // commit changes
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fThisTermios );
+  fTransport->Configure( fThisTermios );
 
 #endif
 }
-
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void AgilentTwisTorr304ComHandler::RestoreIoPort( void )
-{
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void AgilentTwisTorr304ComHandler::CloseIoPort( void )
-{
-  close( fIoPortFileDescriptor );
-}
-
-//! Send command termination string (<CR><NL>).
-/*!
-  \internal
-*/
-void AgilentTwisTorr304ComHandler::SendFeedString( void )
-{
-  write(fIoPortFileDescriptor, "\n", 1);
-}
@@ -47,6 +47,8 @@
 typedef const char* ioport_t;
 typedef struct termios termios_t;
 
+class SerialTransport;
+
 class AgilentTwisTorr304ComHandler
 {
  public:
@@ -71,14 +73,11 @@ class AgilentTwisTorr304ComHandler
 
   void OpenIoPort() noexcept(false);
   void InitializeIoPort();
-  void RestoreIoPort();
-  void CloseIoPort();
-  void SendFeedString();
 
-  int fIoPortFileDescriptor;
+  SerialTransport* fTransport;
 
   ioport_t fIoPort;
-  termios_t fCurrentTermios, fThisTermios;
+  termios_t fThisTermios;
 };
 
 /** @} */
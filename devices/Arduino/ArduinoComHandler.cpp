@@ -2,6 +2,7 @@
 
 #include <iostream>
 
+#include "SerialTransport.h"
 #include "ArduinoComHandler.h"
 
 // SETTINGS ON THE DEVICE:
@@ -34,11 +35,8 @@ ArduinoComHandler::ArduinoComHandler( const ioport_t ioPort ) {
 ///
 ArduinoComHandler::~ArduinoComHandler( void ) {
 
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
@@ -46,30 +44,20 @@ void ArduinoComHandler::SendCommand( const char *commandString ) {
 
   if (!fDeviceAvailable) return;
 
-  char singleCharacter = 0; 
+  // command and feed character ( <NL> ) in a single write
+  std::string command = commandString;
+  command += "\n";
 
-  for ( unsigned int i = 0; i < strlen( commandString ); i++ ) {
-    
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
-  }
-
-//   std::cout << "write: -" << commandString <<"-"<< std::endl;
-
-  // send feed characters
-  SendFeedString();
+  fTransport->Write( command );
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  This function must be placed right in time before
-  the device starts sending.
-
-  See example program in class description.
+  Waits until the device has sent a complete line or the timeout has
+  expired.
 */
 void ArduinoComHandler::ReceiveString( char *receiveString ) {
 
@@ -78,26 +66,7 @@ void ArduinoComHandler::ReceiveString( char *receiveString ) {
     return;
   }
 
-  usleep( ComHandlerDelay );
-
-  int timeout = 0, readResult = 0;
-
-  while ( timeout < 10 )  {
-
-    usleep( 100000 );
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 12 );
-    // std::cout << "read: -" << readResult << "- -" << receiveString <<"-"<< std::endl;
-
-    if ( readResult > 0 ) {
-      receiveString[readResult] = 0;
-      // std::cout << "read: -" << readResult << "- -" << receiveString <<"-"<< std::endl;
-      return;
-    }
-    timeout++;
-  }
-
-  //std::cout << "timeout" << std::endl;
+  fTransport->Read( receiveString, 1000 );
 }
 
 //! Open I/O port.
@@ -106,20 +75,16 @@ void ArduinoComHandler::ReceiveString( char *receiveString ) {
 */
 void ArduinoComHandler::OpenIoPort( void ) noexcept(false) {
 
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
 
   // check if successful
-  if ( fIoPortFileDescriptor == -1 ) {
+  if ( !fTransport->Open() ) {
     std::cerr << "[ArduinoComHandler::OpenIoPort] ** ERROR: could not open device file "
 	          << fIoPort << "." << std::endl;
     std::cerr << "                               (probably it's not user-writable)."
               << std::endl;
     fDeviceAvailable = false;
     return;
-  } else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
   }
 
   fDeviceAvailable = true;
@@ -133,11 +98,11 @@ void ArduinoComHandler::InitializeIoPort( void ) {
 
   if (!fDeviceAvailable) return;
 
+  // the firmware terminates replies with println()
+  fTransport->SetTerminator( "\n" );
+
 #ifndef USE_FAKEIO
  
-  // get and save current ioport settings for later restoring
-  tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
-
   // CONFIGURE NEW SETTINGS
 
   // clear new settings struct
@@ -170,43 +135,11 @@ void ArduinoComHandler::InitializeIoPort( void ) {
   fThisTermios.c_cc[VTIME] = 0;
 
   // commit changes
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fThisTermios );
+  fTransport->Configure( fThisTermios );
 
 #endif
 }
 
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void ArduinoComHandler::RestoreIoPort( void ) {
-
-  if (!fDeviceAvailable) return;
-
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void ArduinoComHandler::CloseIoPort( void ) {
-
-  if (!fDeviceAvailable) return;
-
-  close( fIoPortFileDescriptor );
-}
-
-//! Send command termination string (<NL>).
-/*!
-  \internal
-*/
-void ArduinoComHandler::SendFeedString( void )
-{
-  write( fIoPortFileDescriptor, "\n", 1 );
-}
-
 bool ArduinoComHandler::DeviceAvailable()
 {
   return fDeviceAvailable;
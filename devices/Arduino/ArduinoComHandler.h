@@ -11,6 +11,8 @@
 typedef const char* ioport_t;
 typedef struct termios termios_t;
 
+class SerialTransport;
+
 class ArduinoComHandler {
 
  public:
@@ -35,15 +37,12 @@ class ArduinoComHandler {
 
   void OpenIoPort( void ) noexcept(false);
   void InitializeIoPort( void );
-  void RestoreIoPort( void );
-  void CloseIoPort( void );
-  void SendFeedString( void );
 
   bool fDeviceAvailable;
-  int fIoPortFileDescriptor;
+  SerialTransport* fTransport;
 
   ioport_t fIoPort;
-  termios_t fCurrentTermios, fThisTermios;
+  termios_t fThisTermios;
 };
 
 #endif
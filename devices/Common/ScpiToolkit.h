@@ -0,0 +1,251 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SCPITOOLKIT_H_
+#define _SCPITOOLKIT_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/** @addtogroup devices
+ *  @{
+ */
+
+/**
+  \brief Allocation free formatting and parsing of ASCII device protocols.
+
+  Header only helpers for the SCPI and SCPI-like command sets of the
+  device drivers. Commands are assembled in a fixed size buffer on the
+  stack and replies are parsed in place with std::from_chars, so a poll
+  does not touch the heap.
+
+  \code
+  Scpi::Command<64> command;
+  command << "TRAC:DATA? " << first << ", " << last;
+  comHandler_->SendCommand( command.c_str() );
+
+  Scpi::Tokenizer tokens( buffer, "," );
+  unsigned int channel;
+  double value;
+  while (tokens.Next( channel ) && tokens.Next( value )) { ... }
+  \endcode
+*/
+namespace Scpi {
+
+/**
+  \brief Command string in a fixed size buffer.
+
+  Numbers are formatted with std::to_chars. A double is written like
+  std::ostream does by default (6 significant digits, %g), so the bytes
+  sent to a device do not change when a driver is ported from
+  std::stringstream. Text that does not fit is dropped and flagged.
+*/
+template <size_t N>
+class Command
+{
+ public:
+
+  Command() : fLength( 0 ), fOverflow( false ) { fBuffer[0] = 0; }
+  explicit Command( std::string_view text ) : Command() { Append( text ); }
+
+  Command& Append( std::string_view text )
+  {
+    size_t length = text.length();
+    if (fLength + length > N - 1) {
+      length = N - 1 - fLength;
+      fOverflow = true;
+    }
+    memcpy( fBuffer + fLength, text.data(), length );
+    fLength += length;
+    fBuffer[fLength] = 0;
+    return *this;
+  }
+
+  Command& Append( const char* text ) { return Append( std::string_view( text ) ); }
+  Command& Append( char c ) { return Append( std::string_view( &c, 1 ) ); }
+
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value && !std::is_same<T,char>::value && !std::is_same<T,bool>::value, Command&>::type
+  Append( T value )
+  {
+    return Finish( std::to_chars( fBuffer + fLength, fBuffer + N - 1, value ) );
+  }
+
+  Command& Append( double value )
+  {
+    return Finish( std::to_chars( fBuffer + fLength, fBuffer + N - 1, value,
+                                  std::chars_format::general, 6 ) );
+  }
+
+  //! Appends value with a fixed number of decimals (%.*f).
+  Command& Append( double value, int decimals )
+  {
+    return Finish( std::to_chars( fBuffer + fLength, fBuffer + N - 1, value,
+                                  std::chars_format::fixed, decimals ) );
+  }
+
+  template <typename T>
+  Command& operator<<( const T& value ) { return Append( value ); }
+
+  void Clear( void ) { fLength = 0; fOverflow = false; fBuffer[0] = 0; }
+
+  const char* c_str( void ) const { return fBuffer; }
+  const char* data( void ) const { return fBuffer; }
+  size_t length( void ) const { return fLength; }
+  bool empty( void ) const { return fLength == 0; }
+  std::string_view View( void ) const { return std::string_view( fBuffer, fLength ); }
+
+  //! True if some of the appended text did not fit into the buffer.
+  bool Overflow( void ) const { return fOverflow; }
+
+ protected:
+
+  Command& Finish( const std::to_chars_result& result )
+  {
+    if (result.ec == std::errc()) {
+      fLength = result.ptr - fBuffer;
+    } else {
+      fOverflow = true;
+    }
+    fBuffer[fLength] = 0;
+    return *this;
+  }
+
+  char fBuffer[N];
+  size_t fLength;
+  bool fOverflow;
+};
+
+//! Removes leading and trailing white space including <CR> and <LF>.
+inline std::string_view Trim( std::string_view text )
+{
+  const char* whitespace = " \t\r\n";
+  size_t begin = text.find_first_not_of( whitespace );
+  if (begin == std::string_view::npos) return std::string_view();
+  size_t end = text.find_last_not_of( whitespace );
+  return text.substr( begin, end - begin + 1 );
+}
+
+/**
+  Parses the number at the beginning of text. Leading white space and a
+  '+' sign are skipped, trailing characters (e.g. a unit) are ignored.
+  Returns false if text does not start with a number. If end is given it
+  points to the first character after the number.
+*/
+template <typename T>
+bool ParseNumber( std::string_view text, T& value, const char** end = nullptr )
+{
+  const char* first = text.data();
+  const char* last = first + text.length();
+
+  while (first != last && (*first == ' ' || *first == '\t')) ++first;
+  if (first != last && *first == '+') ++first;
+
+  std::from_chars_result result = std::from_chars( first, last, value );
+  if (end) *end = result.ptr;
+
+  return result.ec == std::errc();
+}
+
+//! Like atof/atoi: the number at the beginning of text or 0.
+template <typename T>
+T ToNumber( std::string_view text )
+{
+  T value = 0;
+  if (!ParseNumber( text, value )) return 0;
+  return value;
+}
+
+/**
+  \brief Splits text into tokens without copying.
+
+  Consecutive delimiters are treated as one and leading delimiters are
+  skipped, like VKeithley2700::Tokenize.
+*/
+class Tokenizer
+{
+ public:
+
+  Tokenizer( std::string_view text, std::string_view delimiters )
+    : fText( text ), fDelimiters( delimiters ), fPosition( 0 ) { }
+
+  bool Next( std::string_view& token )
+  {
+    size_t begin = fText.find_first_not_of( fDelimiters, fPosition );
+    if (begin == std::string_view::npos) {
+      fPosition = fText.length();
+      return false;
+    }
+
+    size_t end = fText.find_first_of( fDelimiters, begin );
+    if (end == std::string_view::npos) end = fText.length();
+
+    token = fText.substr( begin, end - begin );
+    fPosition = end;
+
+    return true;
+  }
+
+  //! Parses the next token as a number, see ParseNumber.
+  template <typename T>
+  bool Next( T& value )
+  {
+    std::string_view token;
+    return Next( token ) && ParseNumber( token, value );
+  }
+
+  //! Skips count tokens.
+  bool Skip( unsigned int count = 1 )
+  {
+    std::string_view token;
+    while (count-- > 0) {
+      if (!Next( token )) return false;
+    }
+    return true;
+  }
+
+  std::string_view Rest( void ) const { return fText.substr( std::min( fPosition, fText.length() ) ); }
+
+ protected:
+
+  std::string_view fText;
+  std::string_view fDelimiters;
+  size_t fPosition;
+};
+
+/**
+  Replaces the content of values by the numbers in text, stopping at the
+  first token that is not a number. The vector keeps its capacity, so
+  refilling it on every poll does not allocate. Returns the number of
+  values.
+*/
+template <typename T>
+size_t ParseList( std::string_view text, std::string_view delimiters, std::vector<T>& values )
+{
+  values.clear();
+
+  Tokenizer tokens( text, delimiters );
+  T value;
+  while (tokens.Next( value )) values.push_back( value );
+
+  return values.size();
+}
+
+}
+
+/** @} */
+
+#endif // _SCPITOOLKIT_H_
@@ -0,0 +1,293 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+
+#include "SerialTransport.h"
+#include "SerialBroker.h"
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+std::mutex gRegistryMutex;
+std::map<std::string,std::weak_ptr<SerialBroker> > gRegistry;
+
+// ttyUSB0 and /dev/serial/by-id/... links name the same port
+std::string CanonicalName( const std::string& ioPort )
+{
+  char path[PATH_MAX];
+  if (realpath( ioPort.c_str(), path ) == nullptr) return ioPort;
+  return path;
+}
+
+}
+
+std::shared_ptr<SerialBroker> SerialBroker::Instance( const std::string& ioPort )
+{
+  std::string name = CanonicalName( ioPort );
+
+  std::lock_guard<std::mutex> lock( gRegistryMutex );
+
+  std::shared_ptr<SerialBroker> broker = gRegistry[name].lock();
+  if (!broker) {
+    broker = std::shared_ptr<SerialBroker>( new SerialBroker( name ) );
+    gRegistry[name] = broker;
+  }
+
+  return broker;
+}
+
+SerialBroker::SerialBroker( const std::string& ioPort )
+  : fIoPort( ioPort ),
+    fBusy( false ),
+    fJoinable( false ),
+    fReplies( 0 ),
+    fGeneration( 0 ),
+    fWaiters( 0 ),
+    fTimeout( 5000 ),
+    fResetThreshold( 3 ),
+    fFailures( 0 ),
+    fTransactions( 0 ),
+    fCoalesced( 0 ),
+    fResets( 0 )
+{
+
+}
+
+SerialBroker::~SerialBroker()
+{
+  std::lock_guard<std::mutex> lock( gRegistryMutex );
+
+  auto it = gRegistry.find( fIoPort );
+  if (it != gRegistry.end() && it->second.expired()) gRegistry.erase( it );
+}
+
+int SerialBroker::Query( SerialTransport* transport, const char* command, const char* feed,
+                         char* reply, size_t size, unsigned int replies )
+{
+  return Transaction( transport, command, feed, reply, size, replies, true );
+}
+
+int SerialBroker::Execute( SerialTransport* transport, const char* command, const char* feed,
+                           char* reply, size_t size, unsigned int replies )
+{
+  return Transaction( transport, command, feed, reply, size, replies, false );
+}
+
+bool SerialBroker::Send( SerialTransport* transport, const char* command, const char* feed )
+{
+  std::unique_lock<std::mutex> lock( fMutex );
+
+  if (!Acquire( lock, fTimeout )) {
+    std::cerr << "[SerialBroker::Send] ** ERROR: port " << fIoPort
+              << " busy, dropping command " << command << std::endl;
+    return false;
+  }
+
+  lock.unlock();
+
+  bool result = transport->WriteCommand( command, feed );
+
+  lock.lock();
+
+  fTransactions++;
+
+  Release();
+
+  return result;
+}
+
+//! Writes a command and reads its replies with the port taken.
+/*!
+  \internal
+  A joinable transaction can be joined by identical queries issued while
+  it is in flight, a non-joinable one neither joins nor can be joined.
+*/
+int SerialBroker::Transaction( SerialTransport* transport, const char* command, const char* feed,
+                               char* reply, size_t size, unsigned int replies, bool joinable )
+{
+  if (size == 0) return 0;
+  reply[0] = 0;
+
+  std::unique_lock<std::mutex> lock( fMutex );
+
+  auto deadline = clock_type::now() + std::chrono::milliseconds( fTimeout );
+
+  while (fBusy) {
+
+    // the same query is in flight, wait for its reply instead of asking again
+    if (joinable && fJoinable && fReplies == replies && fCommand == command && fFeed == feed) {
+
+      unsigned long generation = fGeneration;
+
+      fWaiters++;
+      bool done = fCondition.wait_until( lock, deadline,
+                                         [&]() { return fGeneration != generation; } );
+      fWaiters--;
+
+      if (!done) return 0;
+
+      size_t length = std::min( fReply.length(), size - 1 );
+      memcpy( reply, fReply.data(), length );
+      reply[length] = 0;
+
+      fCoalesced++;
+
+      // the port is kept until the last waiter has its copy of the reply
+      if (fWaiters == 0) Release();
+
+      return length;
+    }
+
+    if (fCondition.wait_until( lock, deadline ) == std::cv_status::timeout && fBusy) {
+      std::cerr << "[SerialBroker::Transaction] ** ERROR: port " << fIoPort
+                << " busy, dropping command " << command << std::endl;
+      return 0;
+    }
+  }
+
+  fBusy = true;
+  fJoinable = joinable;
+  fCommand.assign( command );
+  fFeed.assign( feed );
+  fReplies = replies;
+
+  lock.unlock();
+
+  size_t length = 0;
+  if (transport->WriteCommand( command, feed )) {
+    for (unsigned int i=0;i<replies && length < size - 1;++i) {
+      int count = transport->Read( reply + length, size - length );
+      if (count == 0) {
+        length = 0;
+        break;
+      }
+      length += count;
+    }
+  }
+  reply[length] = 0;
+
+  Recover( transport, length > 0 );
+
+  lock.lock();
+
+  if (fWaiters > 0) fReply.assign( reply, length );
+
+  fJoinable = false;
+  fGeneration++;
+  fTransactions++;
+
+  if (fWaiters == 0) Release();
+  fCondition.notify_all();
+
+  return length;
+}
+
+void SerialBroker::SetTimeout( int timeout )
+{
+  std::lock_guard<std::mutex> lock( fMutex );
+  fTimeout = timeout;
+}
+
+void SerialBroker::SetResetThreshold( unsigned int failures )
+{
+  std::lock_guard<std::mutex> lock( fMutex );
+  fResetThreshold = std::max( failures, 1u );
+}
+
+unsigned long SerialBroker::Transactions( void ) const
+{
+  std::lock_guard<std::mutex> lock( fMutex );
+  return fTransactions;
+}
+
+unsigned long SerialBroker::Coalesced( void ) const
+{
+  std::lock_guard<std::mutex> lock( fMutex );
+  return fCoalesced;
+}
+
+unsigned long SerialBroker::Resets( void ) const
+{
+  std::lock_guard<std::mutex> lock( fMutex );
+  return fResets;
+}
+
+//! Waits until the port is free and takes it.
+/*!
+  \internal
+  Has to be called with the mutex locked. Returns false on timeout.
+*/
+bool SerialBroker::Acquire( std::unique_lock<std::mutex>& lock, int timeout )
+{
+  auto deadline = clock_type::now() + std::chrono::milliseconds( timeout );
+
+  while (fBusy) {
+    if (fCondition.wait_until( lock, deadline ) == std::cv_status::timeout && fBusy) return false;
+  }
+
+  fBusy = true;
+
+  return true;
+}
+
+//! Frees the port and wakes up the callers waiting for it.
+/*!
+  \internal
+  Has to be called with the mutex locked.
+*/
+void SerialBroker::Release( void )
+{
+  fBusy = false;
+  fCondition.notify_all();
+}
+
+//! Brings the port back into a known state after an unanswered query.
+/*!
+  \internal
+  Called while the port is taken but without the mutex locked, so other
+  callers can still join or give up. A late reply is flushed so that it
+  is not taken for the reply of the next query. After fResetThreshold
+  consecutive failures the port is closed and opened again, which also
+  recovers a USB serial adapter that was re-enumerated.
+*/
+void SerialBroker::Recover( SerialTransport* transport, bool answered )
+{
+  if (answered) {
+    fFailures = 0;
+    return;
+  }
+
+  transport->Flush();
+
+  if (++fFailures < fResetThreshold) return;
+  fFailures = 0;
+
+  std::cerr << "[SerialBroker::Recover] ** ERROR: no reply from " << fIoPort
+            << ", reopening port" << std::endl;
+
+  bool reopened = transport->Reopen();
+
+  std::lock_guard<std::mutex> lock( fMutex );
+  fResets++;
+  if (!reopened) {
+    std::cerr << "[SerialBroker::Recover] ** ERROR: could not reopen " << fIoPort << std::endl;
+  }
+}
@@ -0,0 +1,124 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SERIALBROKER_H_
+#define _SERIALBROKER_H_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class SerialTransport;
+
+/** @addtogroup devices
+ *  @{
+ */
+
+/**
+  \brief Serialises the transactions on one serial port.
+
+  There is one broker per device file, shared by everybody talking to
+  that port (e.g. the DAQ model, the motion manager and the script
+  globals all reading the same LStep controller). A transaction (command
+  plus its replies) is executed as a whole, so replies can no longer be
+  picked up by the wrong caller.
+
+  A query that is identical to the query currently in flight on the port
+  is not sent again: the caller waits for the running transaction and
+  gets a copy of its reply. Commands that change the state of the device
+  have to be sent with Execute() or Send(), which are never coalesced.
+
+  Waiting for the port is limited by a timeout, a caller gives up instead
+  of queueing behind a hung device forever. Unanswered queries flush the
+  port, after a number of consecutive ones the port is closed and opened
+  again. Each port has its own broker and lock, a hung device does not
+  block the other ports.
+*/
+class SerialBroker
+{
+ public:
+
+  //! Returns the broker of ioPort, creating it on first use.
+  static std::shared_ptr<SerialBroker> Instance( const std::string& ioPort );
+
+  ~SerialBroker();
+
+  /**
+    Writes command and feed and reads the given number of terminated
+    replies into reply, which is null terminated. Returns the number of
+    bytes stored, 0 if the device did not answer or the port could not
+    be acquired.
+    */
+  int Query( SerialTransport* transport, const char* command, const char* feed,
+             char* reply, size_t size, unsigned int replies = 1 );
+
+  /**
+    Same as Query(), but the transaction is never merged with an identical
+    one: every call reaches the device. Used for commands that change the
+    state of the device and are acknowledged with a reply.
+    */
+  int Execute( SerialTransport* transport, const char* command, const char* feed,
+               char* reply, size_t size, unsigned int replies = 1 );
+
+  //! Writes a command that has no reply.
+  bool Send( SerialTransport* transport, const char* command, const char* feed );
+
+  //! Sets the maximum time in ms a caller waits for the port.
+  void SetTimeout( int timeout );
+
+  //! Sets the number of consecutive unanswered queries after which the port is reopened.
+  void SetResetThreshold( unsigned int failures );
+
+  const std::string& IoPort( void ) const { return fIoPort; }
+
+  unsigned long Transactions( void ) const;
+  unsigned long Coalesced( void ) const;
+  unsigned long Resets( void ) const;
+
+ protected:
+
+  SerialBroker( const std::string& ioPort );
+
+  int Transaction( SerialTransport* transport, const char* command, const char* feed,
+                   char* reply, size_t size, unsigned int replies, bool joinable );
+
+  bool Acquire( std::unique_lock<std::mutex>& lock, int timeout );
+  void Release( void );
+  void Recover( SerialTransport* transport, bool answered );
+
+  std::string fIoPort;
+
+  mutable std::mutex fMutex;
+  std::condition_variable fCondition;
+
+  bool fBusy;
+  bool fJoinable;
+  std::string fCommand;
+  std::string fFeed;
+  unsigned int fReplies;
+  std::string fReply;
+  unsigned long fGeneration;
+  unsigned int fWaiters;
+
+  int fTimeout;
+  unsigned int fResetThreshold;
+  unsigned int fFailures;
+
+  unsigned long fTransactions;
+  unsigned long fCoalesced;
+  unsigned long fResets;
+};
+
+/** @} */
+
+#endif // _SERIALBROKER_H_
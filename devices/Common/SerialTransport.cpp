@@ -0,0 +1,318 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "SerialTransport.h"
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+int RemainingTime( const clock_type::time_point& deadline )
+{
+  auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock_type::now());
+  return std::max<int>(remaining.count(), 0);
+}
+
+}
+
+SerialTransport::SerialTransport( const std::string& ioPort )
+  : fIoPort( ioPort ),
+    fFileDescriptor( -1 ),
+    fExclusive( false ),
+    fRestoreSettings( false ),
+    fConfigured( false ),
+    fTrailer( 0 ),
+    fTimeout( 1000 ),
+    fIdleTimeout( 50 )
+{
+
+}
+
+SerialTransport::~SerialTransport()
+{
+  Close();
+}
+
+bool SerialTransport::Open( bool exclusive )
+{
+  if (IsOpen()) return true;
+
+  // open io port ( read/write | no term control | non-blocking )
+  fFileDescriptor = open( fIoPort.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC );
+  if (fFileDescriptor == -1) return false;
+
+  if (exclusive && ioctl( fFileDescriptor, TIOCEXCL ) == -1) {
+    close( fFileDescriptor );
+    fFileDescriptor = -1;
+    return false;
+  }
+  fExclusive = exclusive;
+
+  return true;
+}
+
+bool SerialTransport::Configure( const struct termios& settings )
+{
+  if (!IsOpen()) return false;
+
+  // save the settings found on the first call for later restoring
+  if (!fRestoreSettings) {
+    if (tcgetattr( fFileDescriptor, &fSavedSettings ) != 0) return false;
+    fRestoreSettings = true;
+  }
+
+  fSettings = settings;
+  fConfigured = true;
+
+  // framing is done here, poll() must not wait for VMIN characters
+  struct termios thisSettings = settings;
+  if (!(thisSettings.c_lflag & ICANON)) {
+    thisSettings.c_cc[VMIN] = 0;
+    thisSettings.c_cc[VTIME] = 0;
+  }
+
+  tcflush( fFileDescriptor, TCIOFLUSH );
+
+  return tcsetattr( fFileDescriptor, TCSANOW, &thisSettings ) == 0;
+}
+
+void SerialTransport::Close( void )
+{
+  if (!IsOpen()) return;
+
+  if (fRestoreSettings) {
+    tcsetattr( fFileDescriptor, TCSANOW, &fSavedSettings );
+    fRestoreSettings = false;
+  }
+
+  // the flag stays on the tty as long as any other descriptor is open
+  if (fExclusive) {
+    ioctl( fFileDescriptor, TIOCNXCL );
+    fExclusive = false;
+  }
+
+  close( fFileDescriptor );
+  fFileDescriptor = -1;
+
+  fPending.clear();
+}
+
+bool SerialTransport::Reopen( void )
+{
+  bool exclusive = fExclusive;
+
+  Close();
+  if (!Open( exclusive )) return false;
+
+  if (!fConfigured) return true;
+
+  return Configure( fSettings );
+}
+
+void SerialTransport::SetTerminator( const std::string& terminator, unsigned int trailer )
+{
+  fTerminator = terminator;
+  fTrailer = trailer;
+}
+
+bool SerialTransport::Write( const char* data, size_t length )
+{
+  if (!IsOpen()) return false;
+
+  auto deadline = clock_type::now() + std::chrono::milliseconds( fTimeout );
+
+  size_t written = 0;
+  while (written < length) {
+
+    ssize_t result = write( fFileDescriptor, data + written, length - written );
+
+    if (result > 0) {
+      written += result;
+      continue;
+    }
+
+    if (result < 0 && errno == EINTR) continue;
+    if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK) return false;
+
+    // output queue is full, wait until it drains
+    struct pollfd pfd = { fFileDescriptor, POLLOUT, 0 };
+    if (poll( &pfd, 1, RemainingTime( deadline ) ) <= 0) return false;
+  }
+
+  return true;
+}
+
+bool SerialTransport::Write( const std::string& data )
+{
+  return Write( data.c_str(), data.length() );
+}
+
+//! Assembles short commands on the stack, so sending a command does not allocate.
+bool SerialTransport::WriteCommand( const char* command, const char* feed )
+{
+  size_t commandLength = strlen( command );
+  size_t feedLength = strlen( feed );
+
+  char buffer[256];
+  if (commandLength + feedLength > sizeof(buffer)) {
+    std::string data( command, commandLength );
+    data.append( feed, feedLength );
+    return Write( data );
+  }
+
+  memcpy( buffer, command, commandLength );
+  memcpy( buffer + commandLength, feed, feedLength );
+
+  return Write( buffer, commandLength + feedLength );
+}
+
+//! Waits up to timeout ms for data and appends everything available.
+/*!
+  \internal
+  Returns 1 if data was received, 0 on timeout and -1 if the port
+  reported an error or was hung up.
+*/
+int SerialTransport::Receive( int timeout )
+{
+  struct pollfd pfd = { fFileDescriptor, POLLIN, 0 };
+
+  int result = poll( &pfd, 1, timeout );
+  if (result == 0) return 0;
+  if (result < 0) return errno == EINTR ? 0 : -1;
+  if (!(pfd.revents & POLLIN)) return -1;
+
+  char buffer[1024];
+  bool received = false;
+
+  while (true) {
+    ssize_t count = read( fFileDescriptor, buffer, sizeof(buffer) );
+    if (count > 0) {
+      fPending.append( buffer, count );
+      received = true;
+      continue;
+    }
+    if (count < 0 && errno == EINTR) continue;
+    if (count == 0 && !received) return -1;
+    break;
+  }
+
+  return received ? 1 : 0;
+}
+
+//! Length of the first complete frame in the pending data, 0 if there is none.
+/*!
+  \internal
+*/
+size_t SerialTransport::FrameLength( void ) const
+{
+  if (fTerminator.empty()) return 0;
+
+  size_t idx = fPending.find( fTerminator );
+  if (idx == std::string::npos) return 0;
+
+  size_t length = idx + fTerminator.length() + fTrailer;
+  if (fPending.length() < length) return 0;
+
+  return length;
+}
+
+int SerialTransport::Read( char* buffer, size_t size )
+{
+  return Read( buffer, size, fTimeout );
+}
+
+int SerialTransport::Read( char* buffer, size_t size, int timeout )
+{
+  if (size == 0) return 0;
+  buffer[0] = 0;
+
+  if (!IsOpen()) return 0;
+
+  auto deadline = clock_type::now() + std::chrono::milliseconds( timeout );
+
+  size_t length = 0;
+  while (true) {
+
+    length = FrameLength();
+    if (length > 0) break;
+
+    if (fPending.length() >= size - 1) {
+      length = size - 1;
+      break;
+    }
+
+    int remaining = RemainingTime( deadline );
+    if (remaining == 0) {
+      length = fPending.length();
+      break;
+    }
+
+    // without a terminator the reply ends when the line becomes idle
+    bool idle = fTerminator.empty() && !fPending.empty();
+    if (idle) remaining = std::min( remaining, fIdleTimeout );
+
+    int result = Receive( remaining );
+    if (result < 0 || (result == 0 && idle)) {
+      length = fPending.length();
+      break;
+    }
+  }
+
+  length = std::min( length, size - 1 );
+  memcpy( buffer, fPending.data(), length );
+  buffer[length] = 0;
+  fPending.erase( 0, length );
+
+  return length;
+}
+
+int SerialTransport::ReadBytes( char* buffer, size_t length, int timeout )
+{
+  if (!IsOpen()) return 0;
+
+  auto deadline = clock_type::now() + std::chrono::milliseconds( timeout );
+
+  while (fPending.length() < length) {
+    int remaining = RemainingTime( deadline );
+    if (remaining == 0) break;
+    if (Receive( remaining ) < 0) break;
+  }
+
+  length = std::min( length, fPending.length() );
+  memcpy( buffer, fPending.data(), length );
+  fPending.erase( 0, length );
+
+  return length;
+}
+
+void SerialTransport::Flush( void )
+{
+  fPending.clear();
+
+  if (!IsOpen()) return;
+
+  tcflush( fFileDescriptor, TCIOFLUSH );
+
+  // devices that are not a tty (e.g. usbtmc) ignore tcflush
+  char buffer[1024];
+  while (read( fFileDescriptor, buffer, sizeof(buffer) ) > 0) { }
+}
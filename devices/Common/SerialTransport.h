@@ -0,0 +1,122 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SERIALTRANSPORT_H_
+#define _SERIALTRANSPORT_H_
+
+#include <string>
+
+#include <termios.h>
+
+/** @addtogroup devices
+ *  @{
+ */
+
+/**
+  \brief Event driven access to a serial (tty) device.
+
+  Shared by the device ComHandlers. The port is opened non-blocking and all
+  waiting is done in poll(), so a pending request does not consume CPU
+  time and returns as soon as the reply is complete.
+
+  A command is written with a single write() call. A reply is complete
+  once the terminator (plus an optional number of trailer bytes, e.g. a
+  checksum) has been received. Without a terminator a reply is complete
+  once the line has been idle for the idle timeout. Every read has a
+  deadline after which it returns whatever has been received so far.
+  Bytes received after a terminator are kept for the next read.
+*/
+class SerialTransport
+{
+ public:
+
+  //! Constructor.
+  SerialTransport( const std::string& ioPort );
+
+  //! Destructor. Restores the port settings and closes the port.
+  ~SerialTransport();
+
+  //! Opens the port. An exclusive port cannot be opened a second time.
+  bool Open( bool exclusive = false );
+
+  /**
+    Applies the port settings. The previous settings are restored on
+    Close(). In non-canonical mode VMIN and VTIME are ignored.
+    */
+  bool Configure( const struct termios& settings );
+
+  void Close( void );
+
+  //! Closes and opens the port again with the last settings, e.g. after a device hung.
+  bool Reopen( void );
+
+  bool IsOpen( void ) const { return fFileDescriptor != -1; }
+  int FileDescriptor( void ) const { return fFileDescriptor; }
+  const std::string& IoPort( void ) const { return fIoPort; }
+
+  //! Sets the reply terminator and the number of bytes following it.
+  void SetTerminator( const std::string& terminator, unsigned int trailer = 0 );
+
+  //! Sets the default deadline of a read in ms.
+  void SetTimeout( int timeout ) { fTimeout = timeout; }
+
+  //! Sets the time in ms the line has to be idle to complete an unterminated reply.
+  void SetIdleTimeout( int timeout ) { fIdleTimeout = timeout; }
+
+  bool Write( const char* data, size_t length );
+  bool Write( const std::string& data );
+
+  //! Writes command followed by the feed characters in a single write.
+  bool WriteCommand( const char* command, const char* feed );
+
+  /**
+    Reads one reply including its terminator into buffer and terminates
+    it with a null character. At most size-1 bytes are stored. Returns
+    the number of bytes stored.
+    */
+  int Read( char* buffer, size_t size );
+  int Read( char* buffer, size_t size, int timeout );
+
+  /**
+    Reads exactly length bytes unless the deadline passes first. Returns
+    the number of bytes read.
+    */
+  int ReadBytes( char* buffer, size_t length, int timeout );
+
+  //! Discards all received but unread data.
+  void Flush( void );
+
+ protected:
+
+  int Receive( int timeout );
+  size_t FrameLength( void ) const;
+
+  std::string fIoPort;
+  int fFileDescriptor;
+  bool fExclusive;
+
+  bool fRestoreSettings;
+  struct termios fSavedSettings;
+  bool fConfigured;
+  struct termios fSettings;
+
+  std::string fTerminator;
+  unsigned int fTrailer;
+  int fTimeout;
+  int fIdleTimeout;
+
+  std::string fPending;
+};
+
+/** @} */
+
+#endif // _SERIALTRANSPORT_H_
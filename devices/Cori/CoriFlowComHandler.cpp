@@ -12,6 +12,7 @@
 
 #include <string.h>
 
+#include "SerialTransport.h"
 #include "CoriFlowComHandler.h"
 
 // SETTINGS ON THE DEVICE:
@@ -44,74 +45,37 @@ CoriFlowComHandler::CoriFlowComHandler( const ioport_t ioPort ) {
 ///
 CoriFlowComHandler::~CoriFlowComHandler( void ) {
 
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
 void CoriFlowComHandler::SendCommand( const char *commandString ) {
 
-  char singleCharacter = 0; 
+  // command and feed characters ( <CR><NL> ) in a single write
+  std::string command = commandString;
+  command += "\r\n";
 
-  for ( unsigned int i = 0; i < strlen( commandString ); i++ ) {
-    
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
-  }
-
-//   std::cout << "write: " << commandString << std::endl;
-
-  // send feed characters
-  SendFeedString();
+  fTransport->Write( command );
 }
 
 //! flush the IO memory
 void CoriFlowComHandler::flush(void) {
 
-  sleep(2);
-  if(tcflush(fIoPortFileDescriptor, TCIOFLUSH)==0)
-    printf("The input and output queues have been flushed\n\n");
-    else{
-      perror("tcflush error");
-    }
-    sleep(1);
+  fTransport->Flush();
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
-
-  This function must be placed right in time before
-  the device starts sending.
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  See example program in class description.
+  Waits until the device has sent a complete line or the timeout has
+  expired.
 */
 void CoriFlowComHandler::ReceiveString( char *receiveString ) {
 
-  usleep( ComHandlerDelay );
-
-  int timeout = 0, readResult = 0;
-
-  while ( timeout < 10 )  {
-
-    usleep( 100000 );
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-
-    if ( readResult > 0 ) {
-      receiveString[readResult] = 0;
-//       std::cout << "read: " << readResult << " " << receiveString << std::endl;
-      return;
-    }
-    timeout++;
-  }
-
-  //std::cout << "timeout" << std::endl;
+  fTransport->Read( receiveString, 1000 );
 }
 
 //! Open I/O port.
@@ -120,19 +84,16 @@ void CoriFlowComHandler::ReceiveString( char *receiveString ) {
 */
 void CoriFlowComHandler::OpenIoPort( void ) noexcept(false) {
 
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
 
   // check if successful
-  if ( fIoPortFileDescriptor == -1 ) {
+  if ( !fTransport->Open() ) {
     std::cerr << "[CoriFlowComHandler::OpenIoPort] ** ERROR: could not open device file "
 	      << fIoPort << "." << std::endl;
     std::cerr << "(probably it's not user-writable)."
           << std::endl;
+    delete fTransport;
     throw int(-1);
-  } else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
   }
 }
 
@@ -142,10 +103,10 @@ void CoriFlowComHandler::OpenIoPort( void ) noexcept(false) {
 */
 void CoriFlowComHandler::InitializeIoPort( void ) {
 
-#ifndef USE_FAKEIO
+  // replies are terminated by <CR><NL>
+  fTransport->SetTerminator( "\n" );
 
-  // get and save current ioport settings for later restoring
-  tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
+#ifndef USE_FAKEIO
 
   // CONFIGURE NEW SETTINGS
 
@@ -173,35 +134,7 @@ void CoriFlowComHandler::InitializeIoPort( void ) {
 
 
   // commit changes
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fThisTermios );
+  fTransport->Configure( fThisTermios );
 
 #endif
 }
-
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void CoriFlowComHandler::RestoreIoPort( void ) {
-
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void CoriFlowComHandler::CloseIoPort( void ) {
-
-  close( fIoPortFileDescriptor );
-}
-
-//! Send command termination string (<CR><NL>).
-/*!
-  \internal
-*/
-void CoriFlowComHandler::SendFeedString( void )
-{
-  write( fIoPortFileDescriptor, "\r\n", 4 ); // /r nicht noetig?
-}
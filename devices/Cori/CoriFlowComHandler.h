@@ -39,6 +39,8 @@
 typedef const char* ioport_t;
 typedef struct termios termios_t;
 
+class SerialTransport;
+
 class CoriFlowComHandler {
 
  public:
@@ -63,15 +65,12 @@ class CoriFlowComHandler {
 
   void OpenIoPort( void ) noexcept(false);
   void InitializeIoPort( void );
-  void RestoreIoPort( void );
-  void CloseIoPort( void );
-  void SendFeedString( void );
 
 
-  int fIoPortFileDescriptor;
+  SerialTransport* fTransport;
 
   ioport_t fIoPort;
-  termios_t fCurrentTermios, fThisTermios;
+  termios_t fThisTermios;
 };
 
 #endif
@@ -15,6 +15,7 @@
 
 #include <iostream>
 
+#include "SerialTransport.h"
 #include "GMH3750ComHandler.h"
 
 // SETTINGS ON THE DEVICE:
@@ -46,62 +47,31 @@ GMH3750ComHandler::GMH3750ComHandler( ioport_t ioPort )
 ///
 GMH3750ComHandler::~GMH3750ComHandler( void )
 {
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
 void GMH3750ComHandler::SendCommand( const char *commandString, int length )
 {
-  char singleCharacter = 0; 
   int size = length;
   if (length==-1) size = strlen( commandString );
 
-  for ( unsigned int i = 0; i < size; i++ ) {
-    
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
-  }
-  
-  // send feed characters
-  //SendFeedString();
+  // binary protocol, no feed characters
+  fTransport->Write( commandString, size );
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  This function must be placed right in time before
-  the device starts sending.
-
-  See example program in class description.
+  The protocol is binary and has no terminator. Waits until the line
+  has been idle after the reply or the timeout has expired.
 */
 void GMH3750ComHandler::ReceiveString( char *receiveString )
 {
-  usleep( _COMHANDLER_DELAY );
-
-  int timeout = 0, readResult = 0;
-
-  while ( timeout < 500000 )  {
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-
-    if ( readResult > 0 )   {
-    
-      receiveString[readResult] = 0;
-      break;
-    }
-    
-    timeout++;
-  }
-  
-  std::cout << "TO: " << timeout << std::endl; /////////////////////////////////
+  fTransport->Read( receiveString, 1000 );
 }
 
 //! Open I/O port.
@@ -110,43 +80,24 @@ void GMH3750ComHandler::ReceiveString( char *receiveString )
 */
 void GMH3750ComHandler::OpenIoPort( void )
 {
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
 
   // check if successful
-  if ( fIoPortFileDescriptor == -1 ) {
+  if ( !fTransport->Open() ) {
     
     std::cerr << "[GMH3750ComHandler::OpenIoPort] ** ERROR: could not open device file "
               << fIoPort << "." << std::endl;
     std::cerr << "                               (probably it's not user-writable)."
               << std::endl;
     throw;
-  
-  } else {
-  
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
-  
   }
 
   int status;
 
-  ioctl( fIoPortFileDescriptor, TIOCMGET, &status );
+  ioctl( fTransport->FileDescriptor(), TIOCMGET, &status );
   if (status & TIOCM_RTS) status &= ~TIOCM_RTS;
   if (!(status & TIOCM_DTR)) status |= TIOCM_DTR;
-  ioctl( fIoPortFileDescriptor, TIOCMSET, &status );
-
-  // ioctl( fIoPortFileDescriptor, TIOCMGET, &status );
-  // if (status & TIOCM_RTS) {
-  //   std::cout << "RTS is set" << std::endl;
-  // } else {
-  //   std::cout << "RTS is not set" << std::endl;
-  // }
-  // if (status & TIOCM_DTR) {
-  //   std::cout << "DTR is set" << std::endl;
-  // } else {
-  //   std::cout << "DTR is not set" << std::endl;
-  // }  
+  ioctl( fTransport->FileDescriptor(), TIOCMSET, &status );
 }
 
 //! Initialize I/O port.
@@ -155,9 +106,6 @@ void GMH3750ComHandler::OpenIoPort( void )
 */
 void GMH3750ComHandler::InitializeIoPort( void )
 {
-  // get and save current ioport settings for later restoring
-  tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
-
   // CONFIGURE NEW SETTINGS
 
   // clear new settings struct
@@ -180,37 +128,5 @@ void GMH3750ComHandler::InitializeIoPort( void )
   fThisTermios.c_cflag   |=  CS8;
   
   // commit changes
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fThisTermios );
-}
-
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void GMH3750ComHandler::RestoreIoPort( void )
-{
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void GMH3750ComHandler::CloseIoPort( void )
-{
-  close( fIoPortFileDescriptor );
-}
-
-//! Send command termination string (<CR><NL>).
-/*!
-  \internal
-*/
-void GMH3750ComHandler::SendFeedString( void )
-{
-  // feed string is <NL>
-  char feedString = 10;
-
-  // write <CR> and get echo
-  write( fIoPortFileDescriptor, &feedString, 1 );
+  fTransport->Configure( fThisTermios );
 }
@@ -43,6 +43,8 @@
 typedef const char* ioport_t;
 typedef struct termios termios_t;
 
+class SerialTransport;
+
 class GMH3750ComHandler
 {
  public:
@@ -64,14 +66,11 @@ class GMH3750ComHandler
 
   void OpenIoPort( void );
   void InitializeIoPort( void );
-  void RestoreIoPort( void );
-  void CloseIoPort( void );
-  void SendFeedString( void );
 
-  int fIoPortFileDescriptor;
+  SerialTransport* fTransport;
 
   ioport_t fIoPort;
-  termios_t fCurrentTermios, fThisTermios;
+  termios_t fThisTermios;
 };
 
 /** @} */
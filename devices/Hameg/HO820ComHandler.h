@@ -30,6 +30,8 @@
 typedef const char* ioport_t;
 typedef struct termios termios_t;
 
+class SerialTransport;
+
 class HO820ComHandler {
 
  public:
@@ -52,15 +54,12 @@ class HO820ComHandler {
 
   void OpenIoPort( void );
   void InitializeIoPort( void );
-  void RestoreIoPort( void );
-  void CloseIoPort( void );
-  void SendFeedString( void );
 
   bool fDeviceAvailable;
-  int fIoPortFileDescriptor;
+  SerialTransport* fTransport;
 
   ioport_t fIoPort;
-  termios_t fCurrentTermios, fThisTermios;
+  termios_t fThisTermios;
 };
 
 /** @} */
@@ -22,6 +22,8 @@
 // query error codes
 //#####################
 
+#include "ScpiToolkit.h"
+
 #include "PetiteFleurComHandler.h"
 
 #include "HuberPetiteFleur.h"
@@ -59,10 +61,10 @@ bool HuberPetiteFleur::SetWorkingTemperature( const float workingTemp ) const {
   int iTemp = workingTemp * 100.;
   sprintf(buffer, "%+06d", iTemp);
 
-  std::stringstream theCommand;
+  Scpi::Command<32> theCommand;
   theCommand << "SP@ " << buffer;
 
-  comHandler_->SendCommand( theCommand.str().c_str() );
+  comHandler_->SendCommand( theCommand.c_str() );
   usleep( uDelay_ );
 
   memset( buffer, 0, sizeof( buffer ) );
@@ -238,20 +240,21 @@ void HuberPetiteFleur::StripBuffer( char* buffer ) const {
   }
 }
 
+// replies start with the three character command echo, e.g. "TI +02050"
 int HuberPetiteFleur::ToInteger(const char* buffer) const
 {
-  std::string temp(buffer);
-  temp.erase(0, 3);
+  std::string_view temp(buffer);
+  if (temp.length()<3) return 0;
 
-  return std::atoi( temp.c_str() );
+  return Scpi::ToNumber<int>( temp.substr(3) );
 }
 
 float HuberPetiteFleur::ToFloat(const char* buffer) const
 {
-  std::string temp(buffer);
-  temp.erase(0, 3);
+  std::string_view temp(buffer);
+  if (temp.length()<3) return 0;
 
-  return std::atof( temp.c_str() )/100.;
+  return Scpi::ToNumber<double>( temp.substr(3) )/100.;
 }
 
 ///
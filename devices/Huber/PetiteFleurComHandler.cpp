@@ -14,6 +14,7 @@
 
 #include <iostream>
 
+#include "SerialTransport.h"
 #include "PetiteFleurComHandler.h"
 
 // SETTINGS ON THE DEVICE:
@@ -46,62 +47,28 @@ PetiteFleurComHandler::PetiteFleurComHandler( const ioport_t ioPort ) {
 ///
 PetiteFleurComHandler::~PetiteFleurComHandler( void ) {
 
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
 void PetiteFleurComHandler::SendCommand( const char *commandString ) {
 
-  char singleCharacter = 0; 
-
-  for ( unsigned int i = 0; i < strlen( commandString ); i++ ) {
-    
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
-  }
-
-  //std::cout << "write: " << commandString << std::endl;
-
-  // send feed characters
-  SendFeedString();
+  // command and feed characters ( <NL><CR> ) in a single write
+  fTransport->WriteCommand( commandString, "\n\r" );
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
-
-  This function must be placed right in time before
-  the device starts sending.
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  See example program in class description.
+  Waits until the device has sent a complete line or the timeout has
+  expired.
 */
 void PetiteFleurComHandler::ReceiveString( char *receiveString ) {
 
-  usleep( ComHandlerDelay );
-
-  int timeout = 0, readResult = 0;
-
-  while ( timeout < 10 )  {
-
-    usleep( 100000 );
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-
-    if ( readResult > 0 ) {
-      receiveString[readResult] = 0;
-      //std::cout << "read: " << readResult << " " << receiveString << std::endl;
-      return;
-    }
-    timeout++;
-  }
-
-  //std::cout << "timeout" << std::endl;
+  fTransport->Read( receiveString, 1000 );
 }
 
 //! Open I/O port.
@@ -110,19 +77,16 @@ void PetiteFleurComHandler::ReceiveString( char *receiveString ) {
 */
 void PetiteFleurComHandler::OpenIoPort( void ) noexcept(false) {
 
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
 
   // check if successful
-  if ( fIoPortFileDescriptor == -1 ) {
+  if ( !fTransport->Open() ) {
     std::cerr << "[PetiteFleurComHandler::OpenIoPort] ** ERROR: could not open device file "
-	          << fIoPort << "." << std::endl;
+              << fIoPort << "." << std::endl;
     std::cerr << "                               (probably it's not user-writable)."
               << std::endl;
+    delete fTransport;
     throw int(-1);
-  } else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
   }
 }
 
@@ -132,10 +96,10 @@ void PetiteFleurComHandler::OpenIoPort( void ) noexcept(false) {
 */
 void PetiteFleurComHandler::InitializeIoPort( void ) {
 
+  // replies are terminated by <NL>
+  fTransport->SetTerminator( "\n" );
+
 #ifndef USE_FAKEIO
- 
-  // get and save current ioport settings for later restoring
-  tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
 
   // CONFIGURE NEW SETTINGS
 
@@ -203,35 +167,7 @@ void PetiteFleurComHandler::InitializeIoPort( void ) {
 //   fThisTermios.c_cflag   |=  FF0;
 
   // commit changes
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fThisTermios );
+  fTransport->Configure( fThisTermios );
 
 #endif
 }
-
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void PetiteFleurComHandler::RestoreIoPort( void ) {
-
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void PetiteFleurComHandler::CloseIoPort( void ) {
-
-  close( fIoPortFileDescriptor );
-}
-
-//! Send command termination string (<CR><NL>).
-/*!
-  \internal
-*/
-void PetiteFleurComHandler::SendFeedString( void )
-{
-  write( fIoPortFileDescriptor, "\n\r", 2 );
-}
@@ -23,6 +23,8 @@
 typedef const char* ioport_t;
 typedef struct termios termios_t;
 
+class SerialTransport;
+
 class PetiteFleurComHandler {
 
  public:
@@ -45,14 +47,11 @@ class PetiteFleurComHandler {
 
   void OpenIoPort( void ) noexcept(false);
   void InitializeIoPort( void );
-  void RestoreIoPort( void );
-  void CloseIoPort( void );
-  void SendFeedString( void );
 
-  int fIoPortFileDescriptor;
+  SerialTransport* fTransport;
 
   ioport_t fIoPort;
-  termios_t fCurrentTermios, fThisTermios;
+  termios_t fThisTermios;
 };
 
 #endif
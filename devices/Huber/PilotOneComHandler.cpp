@@ -14,6 +14,7 @@
 
 #include <iostream>
 
+#include "SerialTransport.h"
 #include "PilotOneComHandler.h"
 
 /*!
@@ -33,33 +34,29 @@ PilotOneComHandler::PilotOneComHandler(ioport_t ioPort)
 
 PilotOneComHandler::~PilotOneComHandler( void )
 {
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
-void PilotOneComHandler::SendCommand(const char *commandString)
+void PilotOneComHandler::SendCommand( const char *commandString )
 {
   if (!fDeviceAvailable) return;
 
-  std::string theCommand = commandString;
-  theCommand += "\r\n";
+  // command and feed characters in a single write; feed string is <CR><NL>
+  std::string command = commandString;
+  command += "\r\n";
 
-  write( fIoPortFileDescriptor, theCommand.c_str(), theCommand.length());
+  fTransport->Write( command );
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  This function must be placed right in time before
-  the device starts sending.
-
-  See example program in class description.
+  Waits until the device has sent a complete reply or the timeout has
+  expired.
 */
 void PilotOneComHandler::ReceiveString( char *receiveString )
 {
@@ -68,21 +65,7 @@ void PilotOneComHandler::ReceiveString( char *receiveString )
     return;
   }
 
-  usleep( 10000 );
-
-  int timeout = 0, readResult = 0;
-
-  while ( timeout < 100000 )  {
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-
-    if ( readResult > 0 ) {
-      receiveString[readResult] = 0;
-      break;
-    }
-    
-    timeout++;
-  }
+  fTransport->Read( receiveString, 1000 );
 }
 
 //! Open I/O port.
@@ -91,20 +74,16 @@ void PilotOneComHandler::ReceiveString( char *receiveString )
 */
 void PilotOneComHandler::OpenIoPort( void )
 {
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
 
-  // check if successful
-  if ( fIoPortFileDescriptor == -1 ) {
+  // open io port ( read/write | no term control | non-blocking )
+  if ( !fTransport->Open() ) {
     std::cerr << "[PilotOneComHandler::OpenIoPort] ** ERROR: could not open device file "
               << fIoPort << "." << std::endl;
     std::cerr << "                               (probably it's not user-writable)."
               << std::endl;
     fDeviceAvailable = false;
     return;
-  } else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
   }
 
   fDeviceAvailable = true;
@@ -118,31 +97,10 @@ void PilotOneComHandler::InitializeIoPort( void )
 {
   if (!fDeviceAvailable) return;
 
-  // get and save current ioport settings for later restoring
-  tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
-}
-
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void PilotOneComHandler::RestoreIoPort( void )
-{
-  if (!fDeviceAvailable) return;
-
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void PilotOneComHandler::CloseIoPort( void )
-{
-  if (!fDeviceAvailable) return;
+  // the port is used with the settings of the USB serial driver
 
-  close( fIoPortFileDescriptor );
+  // replies are terminated by <CR><NL>
+  fTransport->SetTerminator( "\n" );
 }
 
 bool PilotOneComHandler::DeviceAvailable()
@@ -22,6 +22,8 @@
 typedef const char* ioport_t;
 typedef struct termios termios_t;
 
+class SerialTransport;
+
 class PilotOneComHandler {
 
  public:
@@ -44,14 +46,12 @@ class PilotOneComHandler {
 
   void OpenIoPort( void );
   void InitializeIoPort( void );
-  void RestoreIoPort( void );
-  void CloseIoPort( void );
 
   bool fDeviceAvailable;
-  int fIoPortFileDescriptor;
+  SerialTransport* fTransport;
 
   ioport_t fIoPort;
-  termios_t fCurrentTermios, fThisTermios;
+  termios_t fThisTermios;
 };
 
 #endif // _PILOTONECOMHANDLER_H_
@@ -10,6 +10,7 @@
 //                                                                             //
 /////////////////////////////////////////////////////////////////////////////////
 
+#include "SerialTransport.h"
 #include "FP50ComHandler.h"
 
 // SETTINGS ON THE DEVICE:
@@ -41,58 +42,28 @@ FP50ComHandler::FP50ComHandler( const ioport_t ioPort ) {
 ///
 FP50ComHandler::~FP50ComHandler( void ) {
 
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
 void FP50ComHandler::SendCommand( const char *commandString ) {
 
-  char singleCharacter = 0; 
-
-  for ( unsigned int i = 0; i < strlen( commandString ); i++ ) {
-    
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
-
-  }
-
-  // send feed characters
-  SendFeedString();
+  // command and feed character ( <NL> ) in a single write
+  fTransport->WriteCommand( commandString, "\n" );
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
+  <br><b>Receive string must be at least 200 characters long.</b>
 
-  This function must be placed right in time before
-  the device starts sending.
-
-  See example program in class description.
+  Waits until the device has sent a complete line or the timeout has
+  expired.
 */
 void FP50ComHandler::ReceiveString( char *receiveString ) {
 
-  usleep( ComHandlerDelay );
-
-  int timeout = 0, readResult = 0;
-
-  while ( timeout < 100000 )  {
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-
-    if ( readResult > 0 )   {
-      receiveString[readResult] = 0;
-      break;
-    }
-    
-    timeout++;
-
-  }
+  fTransport->Read( receiveString, 200 );
 }
 
 //! Open I/O port.
@@ -101,20 +72,16 @@ void FP50ComHandler::ReceiveString( char *receiveString ) {
 */
 void FP50ComHandler::OpenIoPort( void ) noexcept(false) {
 
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
 
   // check if successful
-  if ( fIoPortFileDescriptor == -1 ) {
+  if ( !fTransport->Open() ) {
     std::cerr << "[FP50ComHandler::OpenIoPort] ** ERROR: could not open device file "
               << fIoPort << "." << std::endl;
     std::cerr << "                               (probably it's not user-writable)."
               << std::endl;
+    delete fTransport;
     throw int(-1);
-
-  } else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
   }
 }
 
@@ -124,10 +91,10 @@ void FP50ComHandler::OpenIoPort( void ) noexcept(false) {
 */
 void FP50ComHandler::InitializeIoPort( void ) {
 
-#ifndef USE_FAKEIO
+  // replies are terminated by <CR><NL>
+  fTransport->SetTerminator( "\n" );
 
-  // get and save current ioport settings for later restoring
-  tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
+#ifndef USE_FAKEIO
 
   // CONFIGURE NEW SETTINGS
 
@@ -195,41 +162,7 @@ void FP50ComHandler::InitializeIoPort( void ) {
 //   fThisTermios.c_cflag   |=  FF0;
 
   // commit changes
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fThisTermios );
+  fTransport->Configure( fThisTermios );
 
 #endif
 }
-
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void FP50ComHandler::RestoreIoPort( void ) {
-
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void FP50ComHandler::CloseIoPort( void ) {
-
-  close( fIoPortFileDescriptor );
-}
-
-//! Send command termination string (<CR><NL>).
-/*!
-  \internal
-*/
-void FP50ComHandler::SendFeedString( void ) {
-
-  // feed string is <NL>
-  char feedString = 10;
-
-  // write <CR> and get echo
-  write( fIoPortFileDescriptor, &feedString, 1 );
-}
-
-
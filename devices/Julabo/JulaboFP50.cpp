@@ -12,11 +12,12 @@
 
 #include <iostream>
 #include <string>
-#include <sstream>
 #include <cstdlib>
 #include <utility>
 #include <fstream>
 
+#include "ScpiToolkit.h"
+
 #include "FP50ComHandler.h"
 
 #include "JulaboFP50.h"
@@ -55,16 +56,16 @@ bool JulaboFP50::SetWorkingTemperature( const float workingTemp ) const {
 
   char buffer[1000];
 
-  std::stringstream theCommand;
+  Scpi::Command<32> theCommand;
   theCommand << "out_sp_00 " << workingTemp;
-  comHandler_->SendCommand( theCommand.str().c_str() );
+  comHandler_->SendCommand( theCommand.c_str() );
   usleep( 20000 );
   comHandler_->SendCommand( "in_sp_00" );
   usleep( 10000 );
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  if( fabs( workingTemp - atof( buffer ) ) > 1.e-3 ) {
+  if( fabs( workingTemp - Scpi::ToNumber<float>( buffer ) ) > 1.e-3 ) {
     std::cerr << " [JulaboFP50::SetWorkingTemp] ** ERROR: check failed." << std::endl;
     std::cerr << "  > Expected: T=" << workingTemp << " but received (string):"
               << buffer << "." << std::endl;
@@ -92,16 +93,16 @@ bool JulaboFP50::SetPumpPressure( const unsigned int pressureStage ) const {
   
   char buffer[1000];
 
-  std::stringstream theCommand;
+  Scpi::Command<32> theCommand;
   theCommand << "out_sp_07 " << pressureStage;
-  comHandler_->SendCommand( theCommand.str().c_str() );
+  comHandler_->SendCommand( theCommand.c_str() );
   usleep( 20000 );
   comHandler_->SendCommand( "in_sp_07" );
   usleep( 10000 );
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  if( static_cast<unsigned int>( atoi( buffer ) ) != pressureStage ) {
+  if( Scpi::ToNumber<unsigned int>( buffer ) != pressureStage ) {
     std::cerr << " [JulaboFP50::SetPumpPressure] ** ERROR: check failed." << std::endl;
     std::cerr << "  > Expected: P=" << pressureStage << " but received (string):"
               << buffer << "." << std::endl;
@@ -129,7 +130,7 @@ bool JulaboFP50::SetCirculatorOn( void ) const {
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  if( static_cast<unsigned int>( atoi( buffer ) ) != 1 ) {
+  if( Scpi::ToNumber<unsigned int>( buffer ) != 1 ) {
     std::cerr << " [JulaboFP50::SetCirculatorOn] ** ERROR: check failed." << std::endl;
     std::cerr << "  > Expected: ON (1) but received (string):" << buffer << "." << std::endl;
     return false;
@@ -156,7 +157,7 @@ bool JulaboFP50::SetCirculatorOff( void ) const {
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  if( static_cast<unsigned int>( atoi( buffer ) ) != 0 ) {
+  if( Scpi::ToNumber<unsigned int>( buffer ) != 0 ) {
     std::cerr << " [JulaboFP50::SetCirculatorOff] ** ERROR: check failed." << std::endl;
     std::cerr << "  > Expected: OFF (0) but received (string):" << buffer << "." << std::endl;
     return false;
@@ -194,12 +195,12 @@ bool JulaboFP50::SetControlParameters( float xp, int tn, int tv ) const {
     return false;
   }
 
-  std::stringstream theCommand;
+  Scpi::Command<32> theCommand;
   char buffer[200];
 
   // proportional
   theCommand << "out_par_06 " << xp;
-  comHandler_->SendCommand( theCommand.str().c_str() );
+  comHandler_->SendCommand( theCommand.c_str() );
   usleep( 10000 );
 
   // verify
@@ -208,7 +209,7 @@ bool JulaboFP50::SetControlParameters( float xp, int tn, int tv ) const {
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  if( fabs( atof( buffer ) - xp ) > 1.e-3 ) {
+  if( fabs( Scpi::ToNumber<float>( buffer ) - xp ) > 1.e-3 ) {
     std::cerr << " [JulaboFP50::SetControlParameters] ** ERROR: check failed." << std::endl;
     std::cerr << "  > Expected: xp=" << xp << " but received (string):"
               << buffer << "." << std::endl;
@@ -216,9 +217,9 @@ bool JulaboFP50::SetControlParameters( float xp, int tn, int tv ) const {
   }
 
   // integral
-  theCommand.str( "" );
+  theCommand.Clear();
   theCommand << "out_par_07 " << tn;
-  comHandler_->SendCommand( theCommand.str().c_str() );
+  comHandler_->SendCommand( theCommand.c_str() );
   usleep( 10000 );
 
   // verify
@@ -227,7 +228,7 @@ bool JulaboFP50::SetControlParameters( float xp, int tn, int tv ) const {
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  if( atoi( buffer ) !=  tn ) {
+  if( Scpi::ToNumber<int>( buffer ) !=  tn ) {
     std::cerr << " [JulaboFP50::SetControlParameters] ** ERROR: check failed." << std::endl;
     std::cerr << "  > Expected: tn=" << tn << " but received (string):"
               << buffer << "." << std::endl;
@@ -235,9 +236,9 @@ bool JulaboFP50::SetControlParameters( float xp, int tn, int tv ) const {
   }
 
   // differential
-  theCommand.str( "" );
+  theCommand.Clear();
   theCommand << "out_par_08 " << tv;
-  comHandler_->SendCommand( theCommand.str().c_str() );
+  comHandler_->SendCommand( theCommand.c_str() );
   usleep( 10000 );
 
   // verify
@@ -246,7 +247,7 @@ bool JulaboFP50::SetControlParameters( float xp, int tn, int tv ) const {
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  if( atoi( buffer ) !=  tv ) {
+  if( Scpi::ToNumber<int>( buffer ) !=  tv ) {
     std::cerr << " [JulaboFP50::SetControlParameters] ** ERROR: check failed." << std::endl;
     std::cerr << "  > Expected: tv=" << tv << " but received (string):"
               << buffer << "." << std::endl;
@@ -271,7 +272,7 @@ float JulaboFP50::GetBathTemperature( void ) const {
   usleep( 10000 );
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
-  return( atof( buffer ) );
+  return( Scpi::ToNumber<float>( buffer ) );
 }
 
 ///
@@ -290,7 +291,7 @@ float JulaboFP50::GetSafetySensorTemperature( void ) const {
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  return( atof( buffer ) );
+  return( Scpi::ToNumber<float>( buffer ) );
 }
 
 ///
@@ -309,7 +310,7 @@ float JulaboFP50::GetWorkingTemperature( void ) const {
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  return( atof( buffer ) );
+  return( Scpi::ToNumber<float>( buffer ) );
 }
 
 ///
@@ -328,7 +329,7 @@ int JulaboFP50::GetHeatingPower( void ) const
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  return( atoi( buffer ) );
+  return( Scpi::ToNumber<int>( buffer ) );
 }
 
 ///
@@ -347,7 +348,7 @@ unsigned int JulaboFP50::GetPumpPressure( void ) const {
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  return( atoi( buffer ) );
+  return( Scpi::ToNumber<int>( buffer ) );
 }
 
 ///
@@ -366,7 +367,7 @@ bool JulaboFP50::GetCirculatorStatus( void ) const {
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  unsigned int status = atoi( buffer );
+  unsigned int status = Scpi::ToNumber<int>( buffer );
 
   if( status ) return true;
   else return false;
@@ -400,13 +401,13 @@ std::pair<int,std::string> JulaboFP50::GetStatus( void ) const {
 
   // error type messages begin with "-" (negative number)
   if( std::string( "-" ) == message.substr( 0, 1 ) ) {
-    returnValue.first  = atoi( message.substr( 0, 3 ).c_str() );
+    returnValue.first  = Scpi::ToNumber<int>( message.substr( 0, 3 ) );
     returnValue.second = message.substr( 4, 100 );
   }
 
   // normal (non-error) message, positive number
   else {
-    returnValue.first  = atoi( message.substr( 0, 2 ).c_str() );
+    returnValue.first  = Scpi::ToNumber<int>( message.substr( 0, 2 ) );
     returnValue.second = message.substr( 3, 100 );
   }
 
@@ -429,7 +430,7 @@ float JulaboFP50::GetProportionalParameter( void ) const {
   usleep( 10000 );
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
-  return( atof( buffer ) );
+  return( Scpi::ToNumber<float>( buffer ) );
 }
 
 ///
@@ -448,7 +449,7 @@ int JulaboFP50::GetIntegralParameter( void ) const {
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  return( atoi( buffer ) );
+  return( Scpi::ToNumber<int>( buffer ) );
 }
 
 ///
@@ -467,7 +468,7 @@ int JulaboFP50::GetDifferentialParameter( void ) const {
   comHandler_->ReceiveString( buffer );
   StripBuffer( buffer );
 
-  return( atoi( buffer ) );
+  return( Scpi::ToNumber<int>( buffer ) );
 }
 
 ///
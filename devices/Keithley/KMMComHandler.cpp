@@ -13,7 +13,9 @@
 #include <string.h>
 
 #include <iostream>
+#include <string>
 
+#include "SerialTransport.h"
 #include "KMMComHandler.h"
 
 // SETTINGS ON THE DEVICE:
@@ -45,63 +47,49 @@ KMMComHandler::KMMComHandler( ioport_t ioPort ) {
 ///
 KMMComHandler::~KMMComHandler( void ) {
 
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
 void KMMComHandler::SendCommand( const char *commandString )
 {
-  if (fIoPortFileDescriptor != -1 ) {
+  if (!fTransport->IsOpen()) return;
 
-    char singleCharacter = 0; 
-    
-    for ( unsigned int i = 0; i < strlen( commandString ); i++ ) {
-      
-      // scan command string character wise & write
-      singleCharacter = commandString[i];
-      write( fIoPortFileDescriptor, &singleCharacter, 1 );
-    }
-    
-    // send feed characters ( <CR> <LF> )
-    SendFeedString();
-  }
+  // command and feed character ( <LF> ) in a single write
+  fTransport->WriteCommand( commandString, "\n" );
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  This function must be placed right in time before
-  the device starts sending.
-
-  See example program in class description.
+  Waits until the device has sent a complete line (TX TERM: LF) or the
+  timeout has expired.
 */
 void KMMComHandler::ReceiveString( char *receiveString ) {
 
-  usleep( 1000000 );
+  fTransport->Read( receiveString, 1000 );
+}
+
+//! Read a string from device, waiting at most &lt;timeout&gt; ms.
+/*!
+  Used for scans, where the reply is sent once the last channel was
+  measured.
+*/
+void KMMComHandler::ReceiveString( char *receiveString, int timeout ) {
 
-  if (fIoPortFileDescriptor != -1 ) {
-    int timeout = 0, readResult = 0;
-    
-    while ( timeout < 100000 )  {
-      
-      readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-      
-      if ( readResult > 0 )   {
-	receiveString[readResult] = 0;
-	break;
-      }
-      
-      timeout++;
-    }
-  } else {
-    receiveString[0] = 0;
-  }
+  fTransport->Read( receiveString, 1000, timeout );
+}
+
+//! Read exactly &lt;length&gt; bytes of binary data from device.
+/*!
+  Returns the number of bytes received before the timeout (ms) expired.
+*/
+int KMMComHandler::ReceiveBytes( char *buffer, size_t length, int timeout ) {
+
+  return fTransport->ReadBytes( buffer, length, timeout );
 }
 
 //! Open I/O port.
@@ -110,21 +98,15 @@ void KMMComHandler::ReceiveString( char *receiveString ) {
 */
 void KMMComHandler::OpenIoPort( void ) noexcept(false)
 {
-
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
 
   // check if successful
-  if ( fIoPortFileDescriptor == -1 ) {
+  if ( !fTransport->Open() ) {
     std::cerr << "[KMMComHandler::OpenIoPort] ** ERROR: could not open device file "
               << fIoPort << "." << std::endl;
     std::cerr << "                               (probably it's not user-writable)."
               << std::endl;
     //throw 1;
-
-  } else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
   }
 }
 
@@ -134,71 +116,35 @@ void KMMComHandler::OpenIoPort( void ) noexcept(false)
 */
 void KMMComHandler::InitializeIoPort( void )
 {
-  if (fIoPortFileDescriptor != -1 ) {
+  if (!fTransport->IsOpen()) return;
 
-    // get and save current ioport settings for later restoring
-    tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
-
-    // CONFIGURE NEW SETTINGS
+  // CONFIGURE NEW SETTINGS
     
-    // clear new settings struct
-    bzero( &fThisTermios, sizeof( fThisTermios ) );
+  // clear new settings struct
+  bzero( &fThisTermios, sizeof( fThisTermios ) );
     
-    // baud rate
-    cfsetispeed( &fThisTermios, B19200 );  // input speed
-    cfsetospeed( &fThisTermios, B19200 );  // output speed
+  // baud rate
+  cfsetispeed( &fThisTermios, B19200 );  // input speed
+  cfsetospeed( &fThisTermios, B19200 );  // output speed
     
-    // enable the receiver and disable modem control signals
-    fThisTermios.c_cflag   |=  CREAD;
-    fThisTermios.c_cflag   |=  CLOCAL;
+  // enable the receiver and disable modem control signals
+  fThisTermios.c_cflag   |=  CREAD;
+  fThisTermios.c_cflag   |=  CLOCAL;
     
-    // set 8 bits per character, no parity, 1 stop bit (8N1)
-    fThisTermios.c_cflag   &=  ~PARENB;
-    fThisTermios.c_cflag   &=  ~CSTOPB;
-    fThisTermios.c_cflag   &=  ~CSIZE; 
-    fThisTermios.c_cflag   |=  CS8;    
+  // set 8 bits per character, no parity, 1 stop bit (8N1)
+  fThisTermios.c_cflag   &=  ~PARENB;
+  fThisTermios.c_cflag   &=  ~CSTOPB;
+  fThisTermios.c_cflag   &=  ~CSIZE; 
+  fThisTermios.c_cflag   |=  CS8;    
     
-    // enable hardware flow control (RTS/CTS)
-    // DOCU !!
-    //  fThisTermios.c_cflag        |=  CRTSCTS;
+  // enable hardware flow control (RTS/CTS)
+  // DOCU !!
+  //  fThisTermios.c_cflag        |=  CRTSCTS;
     
-    // commit changes
-    tcsetattr( fIoPortFileDescriptor, TCSANOW, &fThisTermios );
-  }
-}
-
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void KMMComHandler::RestoreIoPort( void )
-{
-  if (fIoPortFileDescriptor != -1 ) {
-    // restore old com port settings
-    tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-  }
-}
+  // commit changes
+  fTransport->Configure( fThisTermios );
 
-//! Close I/O port.
-/*!
-  \internal
-*/
-void KMMComHandler::CloseIoPort( void )
-{
-  if (fIoPortFileDescriptor != -1 ) {
-    close( fIoPortFileDescriptor );
-  }
-}
-
-//! Send command termination string (<CR><NL>).
-/*!
-  \internal
-*/
-void KMMComHandler::SendFeedString( void )
-{
-  // feed string is <NL>
-  char feedString = 10;
-  
-  // write <CR> and get echo
-  write( fIoPortFileDescriptor, &feedString, 1 );
+  // replies are terminated by <LF>, a full scan may take a while
+  fTransport->SetTerminator( "\n" );
+  fTransport->SetTimeout( 5000 );
 }
@@ -40,6 +40,8 @@
 typedef const char* ioport_t;
 typedef struct termios termios_t;
 
+class SerialTransport;
+
 class KMMComHandler
 {
  public:
@@ -55,19 +57,18 @@ class KMMComHandler
 
   void SendCommand( const char *commandString );
   void ReceiveString( char *receiveString );
+  void ReceiveString( char *receiveString, int timeout );
+  int ReceiveBytes( char *buffer, size_t length, int timeout );
 
  private:
 
   void OpenIoPort( void ) noexcept(false);
   void InitializeIoPort( void );
-  void RestoreIoPort( void );
-  void CloseIoPort( void );
-  void SendFeedString( void );
 
-  int fIoPortFileDescriptor;
+  SerialTransport* fTransport;
 
   ioport_t fIoPort;
-  termios_t fCurrentTermios, fThisTermios;
+  termios_t fThisTermios;
 };
 
 /** @} */
@@ -17,6 +17,10 @@
 #include <cstdlib>
 #include <algorithm>
 #include <sstream>
+#include <cstring>
+#include <cstdint>
+
+#include "ScpiToolkit.h"
 
 #include "Keithley2700.h"
 
@@ -30,6 +34,9 @@ Keithley2700::Keithley2700( ioport_t port )
 
   isDebug_ = false;
   isScanOk_ = false;
+  isBinary_ = false;
+  isContinuous_ = false;
+  uSecDelay_ = DelayMax;
 
   #ifdef __DEBUG
   isDebug_ = true;
@@ -112,61 +119,137 @@ void Keithley2700::DisableActiveChannels( std::string channelString ) {
 const reading_t Keithley2700::Scan( void ) {
 
   reading_t theReading(0);
-  char buffer[1000];
+  std::vector<double> values;
+  theReading.reserve( enabledChannels_.size() );
+  values.reserve( enabledChannels_.size() );
 
   // presume that it will work..
   isScanOk_ = true;
 
-  // clear buffer
-  comHandler_->SendCommand( "TRAC:CLE" );
+  if( isContinuous_ ) {
 
-  // enable scan
-  comHandler_->SendCommand( "ROUT:SCAN:LSEL INT" );
-  
-  // go!
-  comHandler_->SendCommand( "READ?" );
+    // the instrument keeps scanning, get the readings of the last scan
+    comHandler_->SendCommand( "FETC?" );
 
-  // wait until scanned
-  usleep( uSecDelay_ );
+    isScanOk_ = ReceiveReadings( values );
 
-  // get output
-  comHandler_->ReceiveString( buffer );
+  } else {
 
-  // disable scan
-  comHandler_->SendCommand( "ROUT:SCAN:LSEL NONE" );
+    // clear buffer
+    comHandler_->SendCommand( "TRAC:CLE" );
+
+    // enable scan
+    comHandler_->SendCommand( "ROUT:SCAN:LSEL INT" );
 
-  // tokenize output
-  std::vector<std::string> tokens(0);
-  Tokenize( std::string( buffer ), tokens, "," );
+    // go!
+    comHandler_->SendCommand( "READ?" );
+
+    // the reply is sent as soon as the scan is complete
+    isScanOk_ = ReceiveReadings( values );
+
+    // disable scan
+    comHandler_->SendCommand( "ROUT:SCAN:LSEL NONE" );
+  }
 
   if( isDebug_ ) {
     std::cout << " [Keithley2700::Scan] -- DEBUG: Received "
-              <<  tokens.size() / 3 << " reading(s)" << std::endl;
-    std::string bufferStr( buffer );
-    bufferStr.erase( std::remove( bufferStr.begin(), bufferStr.end(), '\n' ), bufferStr.end() );
-    std::cout << " [Keithley2700::Scan] -- DEBUG: <RAWOUTPUT.BEGIN> "
-              << bufferStr << " <RAWOUTPUT.END>" << std::endl;;
+              <<  values.size() << " reading(s)" << std::endl;
   }
 
-  if( tokens.size() / 3 != enabledChannels_.size() ) {
+  if( values.size() != enabledChannels_.size() ) {
     std::cerr << " [Keithley2700::Scan] ** ERROR: expect "
               << enabledChannels_.size() << " reading(s) but received "
-              << tokens.size() / 3 << "." << std::endl;
+              << values.size() << "." << std::endl;
     std::cerr << "                         Probably a timing problem.." << std::endl;
     isScanOk_ = false;
     if( isDebug_ ) throw;
   }
   
-  std::vector<std::string>::const_iterator tokensIt = tokens.begin();
+  std::vector<double>::const_iterator valuesIt = values.begin();
   channels_t::const_iterator channelsIt = enabledChannels_.begin();
-  for( ; tokensIt < tokens.end(); tokensIt += 3, ++channelsIt ) {
-    const double convertedReading = atof( tokensIt->c_str() );
-    theReading.push_back( std::pair<unsigned int, double>( *channelsIt, convertedReading ) );
+  for( ; valuesIt < values.end() && channelsIt < enabledChannels_.end(); ++valuesIt, ++channelsIt ) {
+    theReading.push_back( std::pair<unsigned int, double>( *channelsIt, *valuesIt ) );
   }
 
   return theReading;
 }
 
+///
+/// switches between ASCII and binary (IEEE-754 single precision)
+/// transfer of the readings
+///
+void Keithley2700::SetBinaryReadout( bool binary ) {
+
+  isBinary_ = binary;
+
+  Device_SetFormat();
+}
+
+///
+/// enables or disables continuous scanning;
+/// while enabled Scan() does not trigger but fetches the last readings
+///
+void Keithley2700::SetContinuousScan( bool continuous ) {
+
+  if( isContinuous_ == continuous ) return;
+
+  isContinuous_ = continuous;
+
+  Device_SetTrigger( isContinuous_ );
+}
+
+///
+/// reads the reply to READ? or FETC?, waiting at most for the
+/// scan time of the enabled channels
+///
+bool Keithley2700::ReceiveReadings( std::vector<double>& values ) {
+
+  const int timeout = uSecDelay_ / 1000;
+
+  values.clear();
+
+  if( isBinary_ ) {
+
+    // #0 header, 4 bytes big endian per reading, <LF>
+    char buffer[2 + 4 * ( RangeMax + 1 ) + 1];
+    const size_t length = std::min( 2 + 4 * enabledChannels_.size() + 1, sizeof( buffer ) );
+
+    int count = comHandler_->ReceiveBytes( buffer, length, timeout );
+
+    if( count < 2 || buffer[0] != '#' || buffer[1] != '0' ) {
+      std::cerr << " [Keithley2700::ReceiveReadings] ** ERROR: malformed binary block ("
+                << count << " bytes)." << std::endl;
+      return false;
+    }
+
+    const unsigned char* data = reinterpret_cast<const unsigned char*>( &buffer[2] );
+    for( int idx = 0; idx + 4 <= count - 2; idx += 4 ) {
+      uint32_t bits = ( uint32_t( data[idx] ) << 24 ) | ( uint32_t( data[idx+1] ) << 16 )
+        | ( uint32_t( data[idx+2] ) << 8 ) | uint32_t( data[idx+3] );
+      float value;
+      memcpy( &value, &bits, sizeof(value) );
+      values.push_back( value );
+    }
+
+    return count == static_cast<int>( length );
+  }
+
+  char buffer[1000];
+  comHandler_->ReceiveString( buffer, timeout );
+
+  if( isDebug_ ) {
+    std::string bufferStr( buffer );
+    bufferStr.erase( std::remove( bufferStr.begin(), bufferStr.end(), '\n' ), bufferStr.end() );
+    std::cout << " [Keithley2700::ReceiveReadings] -- DEBUG: <RAWOUTPUT.BEGIN> "
+              << bufferStr << " <RAWOUTPUT.END>" << std::endl;;
+  }
+
+  // one element (the reading, possibly followed by its unit) per channel
+  Scpi::ParseList( buffer, ",\r\n", values );
+
+  return true;
+}
+
 ///
 ///
 ///
@@ -190,6 +273,9 @@ void Keithley2700::Device_SetChannels( void ) const {
 
   std::stringstream theCommand;
 
+  // the scan list cannot be changed while scanning (ERR -221)
+  if( isContinuous_ ) Device_SetTrigger( false );
+
   // build rout:scan command
   theCommand << "ROUT:SCAN (@";
   
@@ -226,10 +312,47 @@ void Keithley2700::Device_SetChannels( void ) const {
               << theCommand.str() << "\"" << std::endl;
   }
   comHandler_->SendCommand( theCommand.str().c_str() );
+
+  if( isContinuous_ ) Device_SetTrigger( true );
+}
+
+///
+/// reading elements and data format
+///
+void Keithley2700::Device_SetFormat( void ) const {
+
+  // compact readout, the reading only (no timestamp and reading number)
+  comHandler_->SendCommand( "FORM:ELEM READ" );
+
+  if( isBinary_ ) {
+    // single precision real, big endian
+    comHandler_->SendCommand( "FORM:DATA SRE" );
+    comHandler_->SendCommand( "FORM:BORD NORM" );
+  } else {
+    comHandler_->SendCommand( "FORM:DATA ASC" );
+  }
+}
+
+///
+/// trigger model for single scans on READ? or continuous scanning
+///
+void Keithley2700::Device_SetTrigger( bool continuous ) const {
+
+  if( continuous ) {
+    comHandler_->SendCommand( "TRIG:COUN INF" );
+    comHandler_->SendCommand( "ROUT:SCAN:LSEL INT" );
+    comHandler_->SendCommand( "INIT:CONT ON" );
+  } else {
+    comHandler_->SendCommand( "INIT:CONT OFF" );
+    comHandler_->SendCommand( "ABOR" );
+    comHandler_->SendCommand( "ROUT:SCAN:LSEL NONE" );
+    comHandler_->SendCommand( "TRIG:COUN 1" );
+  }
 }
   
 void Keithley2700::Reset()
 {
+  if( isContinuous_ ) comHandler_->SendCommand( "INIT:CONT OFF" );
   comHandler_->SendCommand( "ROUT:SCAN:LSEL NONE" );
   comHandler_->SendCommand( "TRAC:CLE" );
   comHandler_->SendCommand( "ROUT:OPEN:ALL" );
@@ -280,6 +403,11 @@ void Keithley2700::Device_Init( void ) const {
   // scanning trigger source = immediate
   comHandler_->SendCommand( "ROUT:SCAN:TSO IMM" );
 
+  Device_SetFormat();
+
+  // resume continuous scanning after a reset
+  if( isContinuous_ ) Device_SetTrigger( true );
+
   // open all channels
   //  comHandler_->SendCommand( "ROUT:OPEN:ALL" );
 }
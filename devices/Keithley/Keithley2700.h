@@ -30,9 +30,11 @@ class Keithley2700 : public VKeithley2700
   void Dump( void ) const;
   bool IsScanOk( void ) { return isScanOk_; }
   void Reset();
+  void SetBinaryReadout( bool );
+  void SetContinuousScan( bool );
 
   // delay time constants (usec)
-  // delay for 1 channel scan -- delay for 10 channel scan
+  // upper bound of the scan time for 1 channel -- for 10 channels
   static constexpr int DelayMin = 1700000;
   static constexpr int DelayMax = 7000000;
 
@@ -41,11 +43,16 @@ class Keithley2700 : public VKeithley2700
   KMMComHandler* comHandler_;
   bool isDebug_;
   bool isScanOk_;
+  bool isBinary_;
+  bool isContinuous_;
   unsigned int uSecDelay_;
   
   void Device_SetChannels( void ) const;
+  void Device_SetFormat( void ) const;
+  void Device_SetTrigger( bool ) const;
   void Device_Init( void ) const;
   void CalculateDelay( void );
+  bool ReceiveReadings( std::vector<double>& );
 };
 
 #endif
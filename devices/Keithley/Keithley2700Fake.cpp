@@ -20,7 +20,8 @@ using namespace std;
 ///
 ///
 Keithley2700Fake::Keithley2700Fake( ioport_t port )
-    : VKeithley2700(port)
+    : VKeithley2700(port),
+      isContinuous_(false)
 {
 
 }
@@ -88,7 +89,8 @@ const reading_t Keithley2700Fake::Scan( void )
        channelsIt != enabledChannels_.end();
        ++channelsIt) {
     theReading.push_back( std::pair<unsigned int, double>( *channelsIt, 10.0 + *channelsIt + (std::rand() % 100)/100. ) );
-    usleep(500);
+    // a continuous scan has the readings ready
+    if (!isContinuous_) usleep(500);
   }
 
   return theReading;
@@ -36,9 +36,13 @@ class Keithley2700Fake : public VKeithley2700
   void Dump( void ) const;
   bool IsScanOk( void );
   void Reset() { }
+  void SetBinaryReadout( bool ) { }
+  void SetContinuousScan( bool continuous ) { isContinuous_ = continuous; }
 
 protected:
 
+  bool isContinuous_;
+
   std::vector<int> activeChannels_;
 };
 
@@ -20,6 +20,8 @@
 #include <sstream>
 #include <chrono>
 
+#include "ScpiToolkit.h"
+
 #include "KeithleyDAQ6510.h"
 
 ///
@@ -45,17 +47,17 @@ KeithleyDAQ6510::KeithleyDAQ6510(ioport_t port)
 void KeithleyDAQ6510::SetTime(int year, int month, int day,
                               int hour, int minute, int second)
 {
-  std::stringstream ss;
+  Scpi::Command<64> command;
 
-  ss << "SYST:TIME ";
-  ss << year << ", ";
-  ss << month << ", ";
-  ss << day << ", ";
-  ss << hour << ", ";
-  ss << minute << ", ";
-  ss << second;
+  command << "SYST:TIME ";
+  command << year << ", ";
+  command << month << ", ";
+  command << day << ", ";
+  command << hour << ", ";
+  command << minute << ", ";
+  command << second;
 
-  comHandler_->SendCommand(ss.str().c_str());
+  comHandler_->SendCommand(command.c_str());
 }
 
 void KeithleyDAQ6510::ActivateChannel(unsigned int card, unsigned int channel,
@@ -94,31 +96,45 @@ void KeithleyDAQ6510::Scan()
 
 void KeithleyDAQ6510::GetScanData(reading_t & data)
 {
-  char buffer[1000];
-  std::string buf;
+  GetScanData(1, GetActiveChannelCount(), data);
+}
 
-  std::stringstream ss;
-  ss << "TRAC:DATA? 1, ";
-  ss << GetActiveChannelCount();
-  ss << ", 'defbuffer1', CHAN, READ, REL";
+unsigned int KeithleyDAQ6510::GetNumberOfReadings()
+{
+  char buffer[1000];
 
-  comHandler_->SendCommand(ss.str().c_str());
+  comHandler_->SendCommand("TRAC:ACT?");
   comHandler_->ReceiveString(buffer);
   StripBuffer(buffer);
-  buf = buffer;
-  std::cout << buf << std::endl;
 
-  std::vector<std::string> tokens(0);
-  Tokenize(buf, tokens, ",");
+  return Scpi::ToNumber<unsigned int>(buffer);
+}
+
+void KeithleyDAQ6510::GetScanData(unsigned int first, unsigned int last,
+                                  reading_t & data)
+{
+  char buffer[1000];
+
+  while (first<=last) {
+    unsigned int end = std::min(last, first + MaxReadingsPerQuery - 1);
+
+    Scpi::Command<96> command;
+    command << "TRAC:DATA? " << first << ", " << end;
+    command << ", 'defbuffer1', CHAN, READ, REL";
 
-  for (std::vector<std::string>::iterator it=tokens.begin();
-       it!=tokens.end();
-       ++it) {
-    unsigned int sensor = std::atoi(it->c_str()); ++it;
-    double temperature = std::atof(it->c_str()); ++it;
-    double relTime = std::atof(it->c_str());
+    comHandler_->SendCommand(command.c_str());
+    comHandler_->ReceiveString(buffer);
+    StripBuffer(buffer);
+
+    // <channel>,<reading>,<relative time>,...
+    Scpi::Tokenizer tokens(buffer, ",");
+    unsigned int sensor;
+    double temperature, relTime;
+    while (tokens.Next(sensor) && tokens.Next(temperature) && tokens.Next(relTime)) {
+      data.push_back(std::tuple<unsigned int,double,double>(sensor,temperature,relTime));
+    }
 
-    data.push_back(std::tuple<unsigned int,double,double>(sensor,temperature,relTime));
+    first = end + 1;
   }
 }
 
@@ -145,12 +161,14 @@ void KeithleyDAQ6510::DeviceSetChannels()
     ss << CreateChannelString(1, activeChannels_[0]);
   }
 
+  bool card1 = count>0;
+
   count = 0;
   for (unsigned int channel = 1;channel<=10;++channel) {
-    if (activeChannels_[0][channel-1]) count++;
+    if (activeChannels_[1][channel-1]) count++;
   }
   if (count) {
-    ss << ",";
+    if (card1) ss << ",";
     ss << CreateChannelString(2, activeChannels_[1]);
   }
 
@@ -38,6 +38,10 @@ class KeithleyDAQ6510 : public VKeithleyDAQ6510
   void Scan();
   void GetScanData(reading_t & data);
 
+  unsigned int GetNumberOfReadings();
+  void GetScanData(unsigned int first, unsigned int last,
+                   reading_t & data);
+
   /*
   void SetActiveChannels( std::string );
   void SetActiveChannels( channels_t );
@@ -60,6 +64,10 @@ class KeithleyDAQ6510 : public VKeithleyDAQ6510
 
   KeithleyUSBTMCComHandler* comHandler_;
   bool isDeviceAvailable_;
+
+  // maximum number of readings per TRAC:DATA? query, keeps the
+  // reply well within the receive buffer
+  static constexpr unsigned int MaxReadingsPerQuery = 16;
   
   void StripBuffer(char*) const;
   void DeviceInit();
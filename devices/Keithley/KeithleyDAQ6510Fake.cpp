@@ -42,6 +42,7 @@ void KeithleyDAQ6510Fake::ActivateChannel(unsigned int card, unsigned int channe
 void KeithleyDAQ6510Fake::Scan()
 {
   data_.clear();
+  scanStart_ = std::chrono::steady_clock::now();
 
   unsigned int i = 0;
   for (unsigned int card = 1;card<=2;++card) {
@@ -64,6 +65,23 @@ void KeithleyDAQ6510Fake::GetScanData(reading_t & data)
   data = data_;
 }
 
+unsigned int KeithleyDAQ6510Fake::GetNumberOfReadings()
+{
+  // readings become available one after the other like on the device
+  std::chrono::duration<double> dt = std::chrono::steady_clock::now() - scanStart_;
+  unsigned int count = dt.count() / 0.2;
+
+  return std::min<unsigned int>(count, data_.size());
+}
+
+void KeithleyDAQ6510Fake::GetScanData(unsigned int first, unsigned int last,
+                                      reading_t & data)
+{
+  for (unsigned int i=first;i<=last && i<=data_.size();++i) {
+    data.push_back(data_[i-1]);
+  }
+}
+
 float KeithleyDAQ6510Fake::GetScanDuration() const
 {
   return 0.2 * GetActiveChannelCount();
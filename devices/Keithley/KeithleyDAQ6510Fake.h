@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <sstream>
 #include <random>
+#include <chrono>
 
 #include "VKeithleyDAQ6510.h"
 
@@ -41,6 +42,10 @@ class KeithleyDAQ6510Fake : public VKeithleyDAQ6510
   void Scan();
   void GetScanData(reading_t & data);
 
+  unsigned int GetNumberOfReadings();
+  void GetScanData(unsigned int first, unsigned int last,
+                   reading_t & data);
+
   /*
   void SetActiveChannels( std::string );
   void SetActiveChannels( channels_t );
@@ -61,6 +66,7 @@ protected:
   std::normal_distribution<> normalDistribution_{0,0.025};
 
   reading_t data_;
+  std::chrono::steady_clock::time_point scanStart_;
 };
 
 #endif
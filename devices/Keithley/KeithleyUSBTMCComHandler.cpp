@@ -14,6 +14,8 @@
 
 #include <iostream>
 
+#include "ScpiToolkit.h"
+
 #include "KeithleyUSBTMCComHandler.h"
 
 /*!
@@ -43,14 +45,10 @@ KeithleyUSBTMCComHandler::~KeithleyUSBTMCComHandler( void )
 //! Send the command string &lt;commandString&gt; to device.
 void KeithleyUSBTMCComHandler::SendCommand( const char *commandString )
 {
-  std::cout << "void KeithleyUSBTMCComHandler::SendCommand( const char *commandString )" << std::endl;
-  
   if (!fDeviceAvailable) return;
 
-  std::cout << "void KeithleyUSBTMCComHandler::SendCommand( const char *commandString ) " << commandString << std::endl;
-  
-  std::string theCommand = commandString;
-  theCommand += "\n";
+  Scpi::Command<1024> theCommand( commandString );
+  theCommand << '\n';
   
   write( fIoPortFileDescriptor, theCommand.c_str(), theCommand.length());
 }
@@ -58,12 +56,11 @@ void KeithleyUSBTMCComHandler::SendCommand( const char *commandString )
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  This function must be placed right in time before
-  the device starts sending.
-
-  See example program in class description.
+  The usbtmc driver completes a read once the device has sent a full
+  message or its own timeout has expired, so a single blocking read is
+  sufficient.
 */
 void KeithleyUSBTMCComHandler::ReceiveString( char *receiveString )
 {
@@ -72,25 +69,10 @@ void KeithleyUSBTMCComHandler::ReceiveString( char *receiveString )
     return;
   }
 
-  std::cout << "void KeithleyUSBTMCComHandler::ReceiveString( char *receiveString )" << std::endl;
-  
-  usleep(10000);
+  int readResult = read( fIoPortFileDescriptor, receiveString, 999 );
 
-  int timeout = 0, readResult = 0;
-
-  while (timeout < 100000)  {
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-
-    std::cout << "receiveString: " << readResult << " " << receiveString << std::endl;
-    
-    if ( readResult > 0 ) {
-      receiveString[readResult] = 0;
-      break;
-    }
-    
-    timeout++;
-  }
+  if (readResult < 0) readResult = 0;
+  receiveString[readResult] = 0;
 }
 
 //! Open I/O port.
@@ -99,8 +81,8 @@ void KeithleyUSBTMCComHandler::ReceiveString( char *receiveString )
 */
 void KeithleyUSBTMCComHandler::OpenIoPort( void )
 {
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR);
+  // open io port ( read/write, blocking )
+  fIoPortFileDescriptor = open( fIoPort, O_RDWR );
 
   // check if successful
   if ( fIoPortFileDescriptor == -1 ) {
@@ -110,9 +92,6 @@ void KeithleyUSBTMCComHandler::OpenIoPort( void )
               << std::endl;
     fDeviceAvailable = false;
     return;
-  } else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
   }
 
   fDeviceAvailable = true;
@@ -37,6 +37,11 @@ class VKeithley2700
   virtual bool IsScanOk( void ) = 0;
   virtual void Reset() = 0;
 
+  // readings as IEEE-754 single precision (FORM:DATA SRE) instead of ASCII
+  virtual void SetBinaryReadout( bool ) = 0;
+  // keep the instrument scanning (INIT:CONT ON), Scan() fetches the latest readings
+  virtual void SetContinuousScan( bool ) = 0;
+
   const channels_t GetActiveChannels() { return enabledChannels_; }
 
   // the number of channels available to the device,
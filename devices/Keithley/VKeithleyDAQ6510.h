@@ -50,6 +50,11 @@ class VKeithleyDAQ6510
   virtual void Scan() = 0;
   virtual void GetScanData(reading_t & data) = 0;
 
+  // streaming read out of a running scan
+  virtual unsigned int GetNumberOfReadings() = 0;
+  virtual void GetScanData(unsigned int first, unsigned int last,
+                           reading_t & data) = 0;
+
   /*
   virtual void SetActiveChannels( std::string ) = 0;
   virtual void SetActiveChannels( channels_t ) = 0;
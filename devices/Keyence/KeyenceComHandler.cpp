@@ -14,6 +14,7 @@
 
 #include <iostream>
 
+#include "SerialTransport.h"
 #include "KeyenceComHandler.h"
 
 //#define KEYENCEDEBUG 1
@@ -35,11 +36,8 @@ KeyenceComHandler::KeyenceComHandler(ioport_t ioPort)
 
 KeyenceComHandler::~KeyenceComHandler( void )
 {
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
@@ -47,29 +45,22 @@ void KeyenceComHandler::SendCommand( const char *commandString )
 {
   if (!fDeviceAvailable) return;
 
-  char singleCharacter = 0; 
-
-  for ( unsigned int i = 0; i < strlen( commandString ); i++ ) {
-    
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
-  }
+  // command and feed character in a single write;
+  // feed string is <CR> ; see documentation page 4.1
+  std::string command = commandString;
+  command += '\r';
 
-  // send feed characters
-  SendFeedString();
+  fTransport->Write( command );
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
+  <br><b>temp_output must be at least 1024 characters long.</b>
 
-  This function must be placed right in time before
-  the device starts sending.
-
-
-  See example program in class description.
+  Appends the reply up to and including the terminating <CR> to
+  receiveString. The deadline grows with the sampling and averaging
+  rates, since the device only answers once the measurement is done.
 */
 void KeyenceComHandler::ReceiveString(std::string & receiveString, char *temp_output, int samplingRate, int averagingRate )
 {
@@ -79,38 +70,23 @@ void KeyenceComHandler::ReceiveString(std::string & receiveString, char *temp_ou
 
   temp_output[0] = 0;
 
-  usleep( 5000 );
+  // rates are given in us, the timeout is in ms
+  int timeout = 1000 + (2*samplingRate*averagingRate)/1000;
 
-  int timeout = 0;
-  size_t readResult = 0;
-  int limit = 1000 + 2*samplingRate*averagingRate;
-  while ( timeout < limit)  {
-
-    readResult = read( fIoPortFileDescriptor, temp_output, 1024 );
-    if ( readResult > 0 ) {
-      receiveString += std::string(temp_output, readResult);
-      if(receiveString.find(13) != std::string::npos){
-	break;
-      }
-    }
-    usleep ( 5 );
-    readResult = 0;
-    temp_output[0] = 0;
-    timeout++;
-  }
+  int readResult = fTransport->Read( temp_output, 1024, timeout );
+  receiveString += std::string(temp_output, readResult);
 
 #ifdef KEYENCEDEBUG
-  std::cout<<"[KeyenceComHandler::ReceiveString] waited for "<<timeout<<" microseconds"<<std::endl;
+  std::cout<<"[KeyenceComHandler::ReceiveString] received "<<readResult<<" bytes"<<std::endl;
 #endif
 
-  if ( timeout == limit ) {
+  if ( receiveString.find(13) == std::string::npos ) {
     //      std::cerr << "[KeyenceComHandler::ReceiveString] ** ERROR: command timed out! "
     //	    << std::endl;
       std::cout << "[KeyenceComHandler::ReceiveString] ** ERROR: command timed out! "
 	    << std::endl;
       return;
   }
-
 }
 
 //! Open I/O port.
@@ -119,25 +95,18 @@ void KeyenceComHandler::ReceiveString(std::string & receiveString, char *temp_ou
 */
 void KeyenceComHandler::OpenIoPort( void )
 {
-    // open io port ( read/write | no term control | no DCD line check )
-    fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
-    
+    fTransport = new SerialTransport( fIoPort );
+
     // check if successful
-    if ( fIoPortFileDescriptor == -1 ) {
+    if ( !fTransport->Open() ) {
         std::cerr << "[KeyenceComHandler::OpenIoPort] ** ERROR: could not open device file "
 	      << fIoPort << "." << std::endl;
         std::cerr << "                               (probably it's not user-writable)."
 	      << std::endl;
         fDeviceAvailable = false;
         return;
-    } else {
-        // configure port with no delay
-        int flags = fcntl(fIoPortFileDescriptor, F_GETFL, 0);
-        flags |= O_NONBLOCK;
-        flags |= FNDELAY;
-        fcntl( fIoPortFileDescriptor, F_SETFL, flags );
     }
-    
+
     fDeviceAvailable = true;
 }
 
@@ -148,23 +117,23 @@ void KeyenceComHandler::OpenIoPort( void )
 void KeyenceComHandler::InitializeIoPort( void )
 {
     if (!fDeviceAvailable) return;
-    
-    // get and save current ioport settings for later restoring
-    tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
-    
+
+    // replies are terminated by <CR>
+    fTransport->SetTerminator( "\r" );
+
 #ifndef USE_FAKEIO
-    
+
     // CONFIGURE NEW SETTINGS
-    
+
     // clear new settings struct
     bzero( &fThisTermios, sizeof( fThisTermios ) );
-    
+
     // all these settings copied from stty output..
-    
+
     // baud rate
     cfsetispeed( &fThisTermios, B115200 );  // input speed
     cfsetospeed( &fThisTermios, B115200 );  // output speed
-    
+
     // various settings, 8N1 (no parity, 1 stopbit)
     fThisTermios.c_cflag   &= ~PARENB;
     fThisTermios.c_cflag   &= ~PARODD;
@@ -174,50 +143,11 @@ void KeyenceComHandler::InitializeIoPort( void )
     fThisTermios.c_cflag   |=  CREAD;
     fThisTermios.c_cflag   |=  CLOCAL;
     fThisTermios.c_cflag   &= ~CRTSCTS;
-    
-    // commit changes
-    tcsetattr( fIoPortFileDescriptor, TCSANOW, &fThisTermios );
-    
-#endif
-
-}
 
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void KeyenceComHandler::RestoreIoPort( void )
-{
-  if (!fDeviceAvailable) return;
-
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void KeyenceComHandler::CloseIoPort( void )
-{
-  if (!fDeviceAvailable) return;
-
-  close( fIoPortFileDescriptor );
-}
-
-//! Send command termination string (<CR><NL>).
-/*!
-  \internal
-*/
-void KeyenceComHandler::SendFeedString( void )
-{
-  if (!fDeviceAvailable) return;
-
-  // feed string is <CR> ; see documentation page 4.1
-  char feedString = 13;
+    // commit changes
+    fTransport->Configure( fThisTermios );
 
-  // write <CR> and get echo
-  write( fIoPortFileDescriptor, &feedString, 1 );
+#endif
 }
 
 bool KeyenceComHandler::DeviceAvailable()
@@ -23,6 +23,8 @@
 typedef const char* ioport_t;
 typedef struct termios termios_t;
 
+class SerialTransport;
+
 /*
 Class for establishing communication with the Keyence LK-G3000 laser 
 */
@@ -50,15 +52,12 @@ class KeyenceComHandler {
 
   void OpenIoPort( void );
   void InitializeIoPort( void );
-  void RestoreIoPort( void );
-  void CloseIoPort( void );
-  void SendFeedString( void );
 
   bool fDeviceAvailable;
-  int fIoPortFileDescriptor;
+  SerialTransport* fTransport;
 
   ioport_t fIoPort;
-  termios_t fCurrentTermios, fThisTermios;
+  termios_t fThisTermios;
 
 };
 
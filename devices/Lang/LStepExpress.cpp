@@ -18,6 +18,8 @@
 #include <sstream>
 #include <iostream>
 
+#include "ScpiToolkit.h"
+
 #include "LStepExpress.h"
 
 //#define LSTEPDEBUG 0
@@ -50,13 +52,13 @@ bool LStepExpress::DeviceAvailable() const
 }
 
 // low level debugging methods
-void LStepExpress::SendCommand(const std::string & command)
+void LStepExpress::SendCommand(const char * command)
 {
 #ifdef LSTEPDEBUG
   std::cout << "Device SendCommand: " << command << std::endl;
 #endif
 
-  comHandler_->SendCommand(command.c_str());
+  comHandler_->SendCommand(command);
 }
 
 void LStepExpress::ReceiveString(std::string & buffer)
@@ -74,6 +76,69 @@ void LStepExpress::ReceiveString(std::string & buffer)
   buffer = buf;
 }
 
+void LStepExpress::Query(const char * command, std::string & reply)
+{
+#ifdef LSTEPDEBUG
+  std::cout << "Device SendCommand: " << command << std::endl;
+#endif
+
+  char buf[1000];
+  comHandler_->Query(command, buf);
+
+#ifdef LSTEPDEBUG
+  std::cout << "Device ReceiveString: " << buf << std::endl;
+#endif
+
+  reply = buf;
+}
+
+//! Send all commands in a single write and collect the replies in order.
+/*!
+  The controller processes the commands one after the other, so the
+  n-th reply belongs to the n-th command. Saves one round trip per
+  command compared to GetValue. The batch is a single transaction on
+  the port, so concurrent callers cannot pick up one of its replies.
+*/
+void LStepExpress::GetValues(const std::vector<std::string> & commands,
+                             std::vector<std::string> & values)
+{
+  // reuse the reply strings of the previous call
+  values.resize(commands.size());
+  if (commands.empty()) return;
+
+  Scpi::Command<1024> batch;
+  for (std::vector<std::string>::const_iterator it = commands.begin();
+       it!=commands.end();
+       ++it) {
+    if (!batch.empty()) batch << '\r';
+    batch << *it;
+  }
+
+#ifdef LSTEPDEBUG
+  std::cout << "Device SendCommand: " << batch.c_str() << std::endl;
+#endif
+
+  char buf[1000];
+  comHandler_->Query(batch.c_str(), buf, commands.size());
+
+#ifdef LSTEPDEBUG
+  std::cout << "Device ReceiveString: " << buf << std::endl;
+#endif
+
+  // replies are separated by <CR>, missing ones are left empty
+  char* reply = buf;
+  for (unsigned int i=0;i<commands.size();++i) {
+    char* end = strchr(reply, '\r');
+    if (end) *end = '\0';
+    values[i] = reply;
+    if (end) {
+      reply = end + 1;
+    } else {
+      reply += strlen(reply);
+    }
+  }
+}
+
 void LStepExpress::StripBuffer(char* buffer) const
 {
   for (unsigned int c=0; c<strlen(buffer);++c) {
@@ -96,9 +161,7 @@ void LStepExpress::DeviceInit(const std::string& lstep_ver, const std::string& l
     std::string buf;
 
     // read version
-    comHandler_->SendCommand("ver");
-    comHandler_->ReceiveString(buffer);
-    StripBuffer(buffer);
+    comHandler_->Query("ver", buffer);
     buf = buffer;
 
     if(buf != lstep_ver)
@@ -115,9 +178,7 @@ void LStepExpress::DeviceInit(const std::string& lstep_ver, const std::string& l
     }
 
     // read internal version
-    comHandler_->SendCommand("iver");
-    comHandler_->ReceiveString(buffer);
-    StripBuffer(buffer);
+    comHandler_->Query("iver", buffer);
     buf = buffer;
 
     if(buf != lstep_iver)
@@ -172,13 +233,16 @@ void LStepExpress::GetAxisStatus(std::vector<int> & values)
 {
   std::string line;
   GetValue("statusaxis", line);
-  
-  std::string token;
 
+  DecodeAxisStatus(line, values);
+}
+
+void LStepExpress::DecodeAxisStatus(const std::string & line, std::vector<int> & values) const
+{
   values.clear();
 
   for (unsigned int i=0;i<4;++i) {
-    char token = line[i];
+    char token = i<line.length() ? line[i] : 0;
   
     switch (token) {
     case '@': {
@@ -565,6 +629,34 @@ void LStepExpress::SetPositionControllerEnabled(const bool enable)
   else      { this->SendCommand("!poscon 0"); }
 }
 
+void LStepExpress::GetMotionStatus(std::vector<int> & axisStatus,
+                                   std::vector<double> & position)
+{
+  static const std::vector<std::string> commands = { "statusaxis", "pos" };
+  GetValues(commands, replies_);
+
+  DecodeAxisStatus(replies_[0], axisStatus);
+  ParseValues(replies_[1], position);
+}
+
+void LStepExpress::GetMotionParameters(std::vector<int> & axis, std::vector<int> & dimension,
+                                       std::vector<double> & acceleration, std::vector<double> & deceleration,
+                                       std::vector<double> & accelerationJerk, std::vector<double> & decelerationJerk,
+                                       std::vector<double> & velocity)
+{
+  static const std::vector<std::string> commands = { "axis", "dim", "accel", "decel",
+                                                     "acceljerk", "deceljerk", "vel" };
+  GetValues(commands, replies_);
+
+  ParseValues(replies_[0], axis);
+  ParseValues(replies_[1], dimension);
+  ParseValues(replies_[2], acceleration);
+  ParseValues(replies_[3], deceleration);
+  ParseValues(replies_[4], accelerationJerk);
+  ParseValues(replies_[5], decelerationJerk);
+  ParseValues(replies_[6], velocity);
+}
+
 void LStepExpress::Reset()
 {
   this->SendCommand("!Reset");
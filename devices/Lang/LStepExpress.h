@@ -127,6 +127,12 @@ class LStepExpress : public VLStepExpress
   void SetJoystickAxisEnabled(const std::vector<int> & values);
   void SetJoystickAxisEnabled(VLStepExpress::Axis axis, int value);
 
+  void GetMotionStatus(std::vector<int> & axisStatus, std::vector<double> & position);
+  void GetMotionParameters(std::vector<int> & axis, std::vector<int> & dimension,
+                           std::vector<double> & acceleration, std::vector<double> & deceleration,
+                           std::vector<double> & accelerationJerk, std::vector<double> & decelerationJerk,
+                           std::vector<double> & velocity);
+
   void Reset();
   void ConfirmErrorRectification();
   void ValidConfig();
@@ -136,16 +142,23 @@ class LStepExpress : public VLStepExpress
   void EmergencyStop();
 
   // low level debugging methods
-  void SendCommand(const std::string &);
+  void SendCommand(const char *);
   void ReceiveString(std::string &);
+  void Query(const char *, std::string &);
+
+  void GetValues(const std::vector<std::string> & commands, std::vector<std::string> & values);
 
  private:
 
   void StripBuffer( char* ) const;
+  void DecodeAxisStatus(const std::string & line, std::vector<int> & values) const;
   void DeviceInit(const std::string& lstep_ver, const std::string& lstep_iver);
 
   LStepExpressComHandler* comHandler_;
   bool isDeviceAvailable_;
+
+  // replies of the batched status reads, reused between polls
+  std::vector<std::string> replies_;
 };
 
 /** @} */
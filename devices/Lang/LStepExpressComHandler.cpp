@@ -14,6 +14,8 @@
 
 #include <iostream>
 
+#include "SerialTransport.h"
+#include "SerialBroker.h"
 #include "LStepExpressComHandler.h"
 
 /*!
@@ -31,11 +33,8 @@ LStepExpressComHandler::LStepExpressComHandler(const std::string& ioPort)
 
 LStepExpressComHandler::~LStepExpressComHandler( void )
 {
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
@@ -43,28 +42,44 @@ void LStepExpressComHandler::SendCommand( const char *commandString )
 {
   if (!fDeviceAvailable) return;
 
-  char singleCharacter = 0; 
+  // command and feed character in a single write;
+  // feed string is <CR> ; see documentation page 4.1
+  fBroker->Send( fTransport, commandString, "\r" );
+}
+
+//! Send a query and read its replies as one transaction.
+/*!
+\par Input:
+  <br><b>Receive string must be at least 1000 characters long.</b>
+
+  The port is shared with all other users of the controller through
+  its SerialBroker. A query identical to the one in flight is answered
+  with the reply of that one. Returns the length of the reply without
+  the final <CR>, 0 if the controller did not answer.
+*/
+int LStepExpressComHandler::Query( const char *commandString, char *receiveString, unsigned int replies )
+{
+  if (!fDeviceAvailable) {
+    receiveString[0] = 0;
+    return 0;
+  }
 
-  for ( unsigned int i = 0; i < strlen( commandString ); i++ ) {
+  int length = fBroker->Query( fTransport, commandString, "\r", receiveString, 1000, replies );
 
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
+  if (length > 0 && receiveString[length-1] == '\r') {
+    receiveString[--length] = '\0';
   }
 
-  // send feed characters
-  SendFeedString();
+  return length;
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  This function must be placed right in time before
-  the device starts sending.
-
-  See example program in class description.
+  Waits until the device has sent a complete reply or the timeout has
+  expired. The terminating <CR> is removed.
 */
 void LStepExpressComHandler::ReceiveString( char *receiveString )
 {
@@ -73,23 +88,10 @@ void LStepExpressComHandler::ReceiveString( char *receiveString )
     return;
   }
 
-  receiveString[0] = 0;
-
-  usleep( 20000 );
-
-  int timeout = 0;
-  size_t readResult = 0;
+  int length = fTransport->Read( receiveString, 1000 );
 
-  while ( timeout < 100000 )  {
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-
-    if ( readResult > 0 ) {
-      receiveString[readResult-1] = '\0';
-      break;
-    }
-    
-    timeout++;
+  if (length > 0 && receiveString[length-1] == '\r') {
+    receiveString[length-1] = '\0';
   }
 }
 
@@ -99,11 +101,11 @@ void LStepExpressComHandler::ReceiveString( char *receiveString )
 */
 void LStepExpressComHandler::OpenIoPort( void )
 {
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort.c_str(), O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
+  fBroker = SerialBroker::Instance( fIoPort );
 
   // check if successful
-  if(fIoPortFileDescriptor == -1)
+  if (!fTransport->Open())
   {
     std::cout << "[LStepExpressComHandler::OpenIoPort] ** ERROR: could not open device file " << fIoPort << "." << std::endl;
     std::cout << "                                               (probably it's not user-writable)." << std::endl;
@@ -112,14 +114,6 @@ void LStepExpressComHandler::OpenIoPort( void )
 
     return;
   }
-  else
-  {
-    // configure port with no delay
-    int flags = fcntl(fIoPortFileDescriptor, F_GETFL, 0);
-    flags |= O_NONBLOCK;
-    flags |= FNDELAY;
-    fcntl( fIoPortFileDescriptor, F_SETFL, flags );
-  }
 
   fDeviceAvailable = true;
 }
@@ -132,8 +126,8 @@ void LStepExpressComHandler::InitializeIoPort( void )
 {
   if (!fDeviceAvailable) return;
 
-  // get and save current ioport settings for later restoring
-  tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
+  // replies are terminated by <CR>
+  fTransport->SetTerminator( "\r" );
 
 #ifndef USE_FAKEIO
 
@@ -159,49 +153,11 @@ void LStepExpressComHandler::InitializeIoPort( void )
   fThisTermios.c_cflag   &= ~CRTSCTS;
 
   // commit changes
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fThisTermios );
+  fTransport->Configure( fThisTermios );
   
 #endif
 }
 
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void LStepExpressComHandler::RestoreIoPort( void )
-{
-  if (!fDeviceAvailable) return;
-
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void LStepExpressComHandler::CloseIoPort( void )
-{
-  if (!fDeviceAvailable) return;
-
-  close( fIoPortFileDescriptor );
-}
-
-//! Send command termination string (<CR><NL>).
-/*!
-  \internal
-*/
-void LStepExpressComHandler::SendFeedString( void )
-{
-  if (!fDeviceAvailable) return;
-
-  // feed string is <CR> ; see documentation page 4.1
-  char feedString = 13;
-
-  // write <CR> and get echo
-  write( fIoPortFileDescriptor, &feedString, 1 );
-}
-
 bool LStepExpressComHandler::DeviceAvailable()
 {
   return fDeviceAvailable;
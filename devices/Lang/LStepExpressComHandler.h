@@ -19,6 +19,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <memory>
+#include <string>
+
 /** @addtogroup devices
  *  @{
  */
@@ -29,6 +32,9 @@
 
 typedef struct termios termios_t;
 
+class SerialTransport;
+class SerialBroker;
+
 class LStepExpressComHandler {
 
  public:
@@ -46,6 +52,7 @@ class LStepExpressComHandler {
 
   void SendCommand( const char* );
   void ReceiveString( char* );
+  int Query( const char*, char*, unsigned int replies = 1 );
 
   bool DeviceAvailable();
 
@@ -53,15 +60,13 @@ class LStepExpressComHandler {
 
   void OpenIoPort( void );
   void InitializeIoPort( void );
-  void RestoreIoPort( void );
-  void CloseIoPort( void );
-  void SendFeedString( void );
 
   bool fDeviceAvailable;
-  int fIoPortFileDescriptor;
+  SerialTransport* fTransport;
+  std::shared_ptr<SerialBroker> fBroker;
 
   const std::string fIoPort;
-  termios_t fCurrentTermios, fThisTermios;
+  termios_t fThisTermios;
 };
 
 /** @} */
@@ -400,7 +400,7 @@ void LStepExpressFake::SetJoystickAxisEnabled(VLStepExpress::Axis axis, int valu
   joystickAxisEnabled_[axis] = value;
 }
 
-void LStepExpressFake::SendCommand(const std::string& command)
+void LStepExpressFake::SendCommand(const char * command)
 {
   std::cout << "SendCommand: " << command << std::endl;
 }
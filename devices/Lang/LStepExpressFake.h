@@ -128,8 +128,8 @@ class LStepExpressFake : public VLStepExpress
   void EmergencyStop() {}
 
   // low level debugging methods
-  void SendCommand(const std::string & command);
-  void ReceiveString(std::string &) { }
+  void SendCommand(const char * command);
+  void ReceiveString(std::string & buffer) { buffer.clear(); }
 
  private:
 
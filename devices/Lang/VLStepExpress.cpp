@@ -10,10 +10,21 @@
 //                                                                             //
 /////////////////////////////////////////////////////////////////////////////////
 
-#include <sstream>
+#include "ScpiToolkit.h"
 
 #include "VLStepExpress.h"
 
+namespace {
+
+  // reply buffer of GetValue, one per thread because several threads poll the same
+  // controller; keeps its capacity between polls
+  std::string& ReplyBuffer()
+  {
+    thread_local std::string reply;
+    return reply;
+  }
+}
+
 VLStepExpress::VLStepExpress(const std::string& /* ioPort */)
 {
 }
@@ -35,255 +46,261 @@ void VLStepExpress::ValidParameter()
 void VLStepExpress::SetValue(const std::string & command,
                              const std::string & value)
 {
-  std::ostringstream os;
-  os << command << " " << value;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << value;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              VLStepExpress::Axis axis, const std::string & value)
 {
-  std::ostringstream os;
-  os << command << " " << GetAxisName(axis) << " " << value;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << GetAxisName(axis) << ' ' << value;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              int value1)
 {
-  std::ostringstream os;
-  os << command << " " << value1;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << value1;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              int value1, int value2)
 {
-  std::ostringstream os;
-  os << command << " " << value1 << " " << value2;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << value1 << ' ' << value2;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              int value1, int value2, int value3)
 {
-  std::ostringstream os;
-  os << command << " " << value1 << " " << value2 << " " << value3;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << value1 << ' ' << value2 << ' ' << value3;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              int value1, int value2, int value3, int value4)
 {
-  std::ostringstream os;
-  os << command << " " << value1 << " " << value2 << " " << value3 << " " << value4;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << value1 << ' ' << value2 << ' ' << value3 << ' ' << value4;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              VLStepExpress::Axis axis, int value)
 {
-  std::ostringstream os;
-  os << command << " " << GetAxisName(axis) << " " << value;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << GetAxisName(axis) << ' ' << value;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              double value1)
 {
-  std::ostringstream os;
-  os << command << " " << value1;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << value1;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              double value1, double value2)
 {
-  std::ostringstream os;
-  os << command << " " << value1 << " " << value2;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << value1 << ' ' << value2;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              double value1, double value2, double value3)
 {
-  std::ostringstream os;
-  os << command << " " << value1 << " " << value2 << " " << value3;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << value1 << ' ' << value2 << ' ' << value3;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              double value1, double value2, double value3, double value4)
 {
-  std::ostringstream os;
-  os << command << " " << value1 << " " << value2 << " " << value3 << " " << value4;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << value1 << ' ' << value2 << ' ' << value3 << ' ' << value4;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              VLStepExpress::Axis axis, double value)
 {
-  std::ostringstream os;
-  os << command << " " << GetAxisName(axis) << " " << value;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << GetAxisName(axis) << ' ' << value;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              VLStepExpress::Axis axis, double value1, double value2)
 {
-  std::ostringstream os;
-  os << command << " " << GetAxisName(axis) << " " << value1 << " " << value2;
-  this->SendCommand(os.str());
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << GetAxisName(axis) << ' ' << value1 << ' ' << value2;
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              const std::vector<int> & values)
 {
-  std::ostringstream os;
-  os << command;
+  Scpi::Command<256> cmd;
+  cmd << command;
   for (std::vector<int>::const_iterator it = values.begin();
       it!=values.end();
       ++it) {
-    os << " " << *it;
+    cmd << ' ' << *it;
   }
-  this->SendCommand(os.str());
+  this->SendCommand(cmd.c_str());
 }
 
 void VLStepExpress::SetValue(const std::string & command,
                              const std::vector<double> & values)
 {
-  std::ostringstream os;
-  os << command;
+  Scpi::Command<256> cmd;
+  cmd << command;
   for (std::vector<double>::const_iterator it = values.begin();
       it!=values.end();
       ++it) {
-    os << " " << *it;
+    cmd << ' ' << *it;
   }
-  this->SendCommand(os.str());
+  this->SendCommand(cmd.c_str());
+}
+
+void VLStepExpress::Query(const char * command, std::string & reply)
+{
+  this->SendCommand(command);
+  this->ReceiveString(reply);
 }
 
 void VLStepExpress::GetValue(const std::string & command,
                              std::string & value)
 {
-  this->SendCommand(command);
-  this->ReceiveString(value);
+  this->Query(command.c_str(), value);
 }
 
 void VLStepExpress::GetValue(const std::string & command,
                              int & value)
 {
-  this->SendCommand(command);
-
-  std::string buffer;
-  int temp;
-  this->ReceiveString(buffer);
-  std::istringstream is(buffer);
-  is >> temp;
-  value = temp;
+  std::string& reply = ReplyBuffer();
+  this->Query(command.c_str(), reply);
+  Scpi::ParseNumber<int>(reply, value);
 }
 
 void VLStepExpress::GetValue(const std::string & command,
                              double & value)
 {
-  this->SendCommand(command);
-
-  std::string buffer;
-  double temp;
-  this->ReceiveString(buffer);
-  std::istringstream is(buffer);
-  is >> temp;
-  value = temp;
+  std::string& reply = ReplyBuffer();
+  this->Query(command.c_str(), reply);
+  Scpi::ParseNumber<double>(reply, value);
 }
 
 void VLStepExpress::GetValue(const std::string & command, VLStepExpress::Axis axis,
                              std::string & value)
 {
-  std::ostringstream os;
-  os << command << " " << GetAxisName(axis);
-  this->SendCommand(os.str());
-  this->ReceiveString(value);
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << GetAxisName(axis);
+  this->Query(cmd.c_str(), value);
 }
 
 void VLStepExpress::GetValue(const std::string & command,
                              std::vector<int> & values)
 {
-  this->SendCommand(command);
-
-  std::string buffer;
-  int temp;
-  this->ReceiveString(buffer);
-
-  values.clear();
-  std::istringstream is(buffer);
-  while (is >> temp) {
-    values.push_back(temp);
-  }
+  std::string& reply = ReplyBuffer();
+  this->Query(command.c_str(), reply);
+  Scpi::ParseList(reply, " \t\r\n", values);
 }
 
 void VLStepExpress::GetValue(const std::string & command,
                              VLStepExpress::Axis axis, int & value)
 {
-  std::ostringstream os;
-  os << command << " " << GetAxisName(axis);
-  this->SendCommand(os.str());
-
-  std::string buffer;
-  int temp;
-  this->ReceiveString(buffer);
-  std::istringstream is(buffer);
-  is >> temp;
-  value = temp;
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << GetAxisName(axis);
+  std::string& reply = ReplyBuffer();
+  this->Query(cmd.c_str(), reply);
+  Scpi::ParseNumber<int>(reply, value);
 }
 
 void VLStepExpress::GetValue(const std::string & command,
                              std::vector<double> & values)
 {
-  this->SendCommand(command);
-
-  std::string buffer;
-  double temp;
-  this->ReceiveString(buffer);
-
-  values.clear();
-  std::istringstream is(buffer);
-  while (is >> temp) {
-    values.push_back(temp);
-  }
+  std::string& reply = ReplyBuffer();
+  this->Query(command.c_str(), reply);
+  Scpi::ParseList(reply, " \t\r\n", values);
 }
 
 void VLStepExpress::GetValue(const std::string & command, VLStepExpress::Axis axis,
                              double & value)
 {
-  std::ostringstream os;
-  os << command << " " << GetAxisName(axis);
-  this->SendCommand(os.str());
-
-  std::string buffer;
-  double temp;
-  this->ReceiveString(buffer);
-  std::istringstream is(buffer);
-  is >> temp;
-  value = temp;
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << GetAxisName(axis);
+  std::string& reply = ReplyBuffer();
+  this->Query(cmd.c_str(), reply);
+  Scpi::ParseNumber<double>(reply, value);
 }
 
 void VLStepExpress::GetValue(const std::string & command, VLStepExpress::Axis axis,
                              std::vector<double> & values)
 {
-  std::ostringstream os;
-  os << command << " " << GetAxisName(axis);
-  this->SendCommand(os.str());
-
-  std::string buffer;
-  double temp;
-  this->ReceiveString(buffer);
+  Scpi::Command<256> cmd;
+  cmd << command << ' ' << GetAxisName(axis);
+  std::string& reply = ReplyBuffer();
+  this->Query(cmd.c_str(), reply);
+  Scpi::ParseList(reply, " \t\r\n", values);
+}
 
+void VLStepExpress::GetValues(const std::vector<std::string> & commands,
+                              std::vector<std::string> & values)
+{
   values.clear();
-  std::istringstream is(buffer);
-  while (is >> temp){
-    values.push_back(temp);
+  for (std::vector<std::string>::const_iterator it = commands.begin();
+       it!=commands.end();
+       ++it) {
+    std::string buffer;
+    GetValue(*it, buffer);
+    values.push_back(buffer);
   }
 }
 
+void VLStepExpress::ParseValues(const std::string & buffer,
+                                std::vector<int> & values)
+{
+  Scpi::ParseList(buffer, " \t\r\n", values);
+}
+
+void VLStepExpress::ParseValues(const std::string & buffer,
+                                std::vector<double> & values)
+{
+  Scpi::ParseList(buffer, " \t\r\n", values);
+}
+
+void VLStepExpress::GetMotionStatus(std::vector<int> & axisStatus,
+                                    std::vector<double> & position)
+{
+  GetAxisStatus(axisStatus);
+  GetPosition(position);
+}
+
+void VLStepExpress::GetMotionParameters(std::vector<int> & axis, std::vector<int> & dimension,
+                                        std::vector<double> & acceleration, std::vector<double> & deceleration,
+                                        std::vector<double> & accelerationJerk, std::vector<double> & decelerationJerk,
+                                        std::vector<double> & velocity)
+{
+  GetAxisEnabled(axis);
+  GetDimension(dimension);
+  GetAcceleration(acceleration);
+  GetDeceleration(deceleration);
+  GetAccelerationJerk(accelerationJerk);
+  GetDecelerationJerk(decelerationJerk);
+  GetVelocity(velocity);
+}
+
 char VLStepExpress::GetAxisName(VLStepExpress::Axis axis)
 {
   switch (axis) {
@@ -149,6 +149,13 @@ class VLStepExpress
   virtual void SetJoystickAxisEnabled(const std::vector<int> & values) = 0;
   virtual void SetJoystickAxisEnabled(VLStepExpress::Axis axis, int value) = 0;
 
+  // batched status reads; the default implementations use one query per value
+  virtual void GetMotionStatus(std::vector<int> & axisStatus, std::vector<double> & position);
+  virtual void GetMotionParameters(std::vector<int> & axis, std::vector<int> & dimension,
+                                   std::vector<double> & acceleration, std::vector<double> & deceleration,
+                                   std::vector<double> & accelerationJerk, std::vector<double> & decelerationJerk,
+                                   std::vector<double> & velocity);
+
   virtual void Reset() = 0;
   virtual void ConfirmErrorRectification() = 0;
   void ValidConfig();
@@ -156,8 +163,10 @@ class VLStepExpress
   virtual void Calibrate() = 0;
 
   // low level methods
-  virtual void SendCommand(const std::string &) = 0;
+  virtual void SendCommand(const char *) = 0;
   virtual void ReceiveString(std::string &) = 0;
+  // sends a command and reads its reply as one transaction
+  virtual void Query(const char * command, std::string & reply);
 
   void SetValue(const std::string & command, const std::string & value);
   void SetValue(const std::string & command, VLStepExpress::Axis axis, const std::string & value);
@@ -185,6 +194,11 @@ class VLStepExpress
   void GetValue(const std::string & command, VLStepExpress::Axis axis, double & value);
   void GetValue(const std::string & command, VLStepExpress::Axis axis, std::vector<double> & values);
 
+  // sends all commands before reading the first reply
+  virtual void GetValues(const std::vector<std::string> & commands, std::vector<std::string> & values);
+  void ParseValues(const std::string & buffer, std::vector<int> & values);
+  void ParseValues(const std::string & buffer, std::vector<double> & values);
+
   char GetAxisName(VLStepExpress::Axis axis);
   const char * GetAxisDimensionShortName(VLStepExpress::Dimension dimension);
   const char * GetAxisDimensionName(VLStepExpress::Dimension dimension);
@@ -14,6 +14,7 @@
 
 #include <iostream>
 
+#include "SerialTransport.h"
 #include "LeyboldComHandler.h"
 
 /*!
@@ -33,40 +34,29 @@ LeyboldComHandler::LeyboldComHandler(ioport_t ioPort)
 
 LeyboldComHandler::~LeyboldComHandler( void )
 {
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
+/*!
+  The command string already contains checksum and <EOT>.
+*/
 void LeyboldComHandler::SendCommand( const char *commandString )
 {
   if (!fDeviceAvailable) return;
 
-  char singleCharacter = 0; 
-
-  for (unsigned int i=0;i<strlen(commandString);i++) {
-    
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
-  }
-
-  usleep(50000);
+  fTransport->Write( commandString, strlen(commandString) );
   // std::cout << "command: |" << commandString << "|" << std::endl;
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
-
-  This function must be placed right in time before
-  the device starts sending.
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  See example program in class description.
+  Waits until the device has sent a complete reply terminated by <EOT>
+  or the timeout has expired.
 */
 void LeyboldComHandler::ReceiveString( char *receiveString )
 {
@@ -75,21 +65,7 @@ void LeyboldComHandler::ReceiveString( char *receiveString )
     return;
   }
 
-  usleep(25000);
-
-  int timeout = 0, readResult = 0;
-
-  while (timeout < 100000)  {
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-
-    if (readResult > 0) {
-      receiveString[readResult] = 0;
-      break;
-    }
-    
-    timeout++;
-  }
+  fTransport->Read( receiveString, 1000 );
 }
 
 //! Open I/O port.
@@ -98,20 +74,16 @@ void LeyboldComHandler::ReceiveString( char *receiveString )
 */
 void LeyboldComHandler::OpenIoPort( void )
 {
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
 
-  // check if successful
-  if (fIoPortFileDescriptor == -1) {
+  // open io port and put it into exclusive mode
+  if (!fTransport->Open( true )) {
     std::cerr << "[LeyboldComHandler::OpenIoPort] ** ERROR: could not open device file "
               << fIoPort << "." << std::endl;
     std::cerr << "                               (probably it's not user-writable)."
               << std::endl;
     fDeviceAvailable = false;
     return;
-  } else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
   }
 
   fDeviceAvailable = true;
@@ -125,9 +97,6 @@ void LeyboldComHandler::InitializeIoPort( void )
 {
   if (!fDeviceAvailable) return;
 
-  // get and save current ioport settings for later restoring
-  tcgetattr(fIoPortFileDescriptor, &fCurrentTermios);
-
   // clear new settings struct
   bzero(&fThisTermios, sizeof(fThisTermios));
 
@@ -146,43 +115,12 @@ void LeyboldComHandler::InitializeIoPort( void )
   fThisTermios.c_cflag |= (CLOCAL | CREAD | CS8);
   fThisTermios.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
   fThisTermios.c_oflag &= ~OPOST;
-  fThisTermios.c_cc[VMIN] = 0;
-  fThisTermios.c_cc[VTIME] = 10;
 
   // commit changes
-  tcflush(fIoPortFileDescriptor, TCIOFLUSH);
-
-  if (tcsetattr(fIoPortFileDescriptor, TCSAFLUSH, &fThisTermios) != 0)
-    return;
-
-  int modeLines = 0;
-
-  // put card into exclusive mode
-  if (ioctl(fIoPortFileDescriptor, TIOCEXCL, &modeLines) == -1)
-    return;
-}
-
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void LeyboldComHandler::RestoreIoPort( void )
-{
-  if (!fDeviceAvailable) return;
-
-  // restore old com port settings
-  tcsetattr(fIoPortFileDescriptor, TCSANOW, &fCurrentTermios);
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void LeyboldComHandler::CloseIoPort( void )
-{
-  if (!fDeviceAvailable) return;
+  fTransport->Configure(fThisTermios);
 
-  close(fIoPortFileDescriptor);
+  // replies are terminated by <EOT>
+  fTransport->SetTerminator("\x04");
 }
 
 bool LeyboldComHandler::DeviceAvailable()
@@ -13,7 +13,10 @@
 #include <string.h>
 
 #include <iostream>
+#include <string>
 
+#include "SerialTransport.h"
+#include "SerialBroker.h"
 #include "NanotecComHandler.h"
 
 /*!
@@ -33,11 +36,8 @@ NanotecComHandler::NanotecComHandler(ioport_t ioPort)
 
 NanotecComHandler::~NanotecComHandler( void )
 {
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
@@ -45,32 +45,56 @@ void NanotecComHandler::SendCommand( const char *commandString )
 {
   if (!fDeviceAvailable) return;
 
-  char singleCharacter = 0; 
+  // command and feed characters in a single write; feed string is <CR>
+  fBroker->Send( fTransport, commandString, "\r" );
+}
+
+//! Send a query and read its replies as one transaction.
+/*!
+\par Input:
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  for ( unsigned int i = 0; i < strlen( commandString ); i++ ) {
-    
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
+  Several commands separated by <CR> are answered one after the other,
+  replies is the number of <CR> terminated replies to wait for. The port
+  is shared with all other users of the controllers on the bus through
+  its SerialBroker. Returns the length of the replies, 0 if the
+  controller did not answer.
+*/
+int NanotecComHandler::Query( const char *commandString, char *receiveString, unsigned int replies )
+{
+  if (!fDeviceAvailable) {
+    receiveString[0] = 0;
+    return 0;
   }
 
-  // send feed characters
-  SendFeedString();
+  return fBroker->Query( fTransport, commandString, "\r", receiveString, 1000, replies );
+}
 
-  usleep(10000);
+//! Send a command that changes the state of the controller and read its replies.
+/*!
+\par Input:
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  // std::cout << "command: |" << commandString << "|" << std::endl;
+  Same as Query(), but the command is never merged with an identical
+  command of another caller, every call reaches the controller.
+*/
+int NanotecComHandler::Execute( const char *commandString, char *receiveString, unsigned int replies )
+{
+  if (!fDeviceAvailable) {
+    receiveString[0] = 0;
+    return 0;
+  }
+
+  return fBroker->Execute( fTransport, commandString, "\r", receiveString, 1000, replies );
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
-
-  This function must be placed right in time before
-  the device starts sending.
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  See example program in class description.
+  Waits until the device has sent a complete reply or the timeout has
+  expired.
 */
 void NanotecComHandler::ReceiveString( char *receiveString )
 {
@@ -79,21 +103,7 @@ void NanotecComHandler::ReceiveString( char *receiveString )
     return;
   }
 
-  usleep( 10000 );
-
-  int timeout = 0, readResult = 0;
-
-  while ( timeout < 100000 )  {
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-
-    if ( readResult > 0 ) {
-      receiveString[readResult] = 0;
-      break;
-    }
-    
-    timeout++;
-  }
+  fTransport->Read( receiveString, 1000 );
 }
 
 //! Open I/O port.
@@ -102,20 +112,17 @@ void NanotecComHandler::ReceiveString( char *receiveString )
 */
 void NanotecComHandler::OpenIoPort( void )
 {
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
+  fBroker = SerialBroker::Instance( fIoPort );
 
-  // check if successful
-  if ( fIoPortFileDescriptor == -1 ) {
+  // open io port and put it into exclusive mode
+  if ( !fTransport->Open(true) ) {
     std::cerr << "[NanotecComHandler::OpenIoPort] ** ERROR: could not open device file "
               << fIoPort << "." << std::endl;
     std::cerr << "                               (probably it's not user-writable)."
               << std::endl;
     fDeviceAvailable = false;
     return;
-  } else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
   }
 
   fDeviceAvailable = true;
@@ -129,9 +136,6 @@ void NanotecComHandler::InitializeIoPort( void )
 {
   if (!fDeviceAvailable) return;
 
-  // get and save current ioport settings for later restoring
-  tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
-
   // clear new settings struct
   bzero( &fThisTermios, sizeof( fThisTermios ) );
 
@@ -150,58 +154,12 @@ void NanotecComHandler::InitializeIoPort( void )
   fThisTermios.c_cflag |= (CLOCAL | CREAD | CS8);
   fThisTermios.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
   fThisTermios.c_oflag &= ~OPOST;
-  fThisTermios.c_cc[VMIN] = 0;
-  fThisTermios.c_cc[VTIME] = 10;
 
   // commit changes
-  tcflush(fIoPortFileDescriptor, TCIOFLUSH);
-
-  if (tcsetattr(fIoPortFileDescriptor, TCSAFLUSH, &fThisTermios) != 0)
-    return;
-
-  int modeLines = 0;
-
-  // put card into exclusive mode
-  if (ioctl(fIoPortFileDescriptor, TIOCEXCL, &modeLines) == -1)
-    return;
-}
-
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void NanotecComHandler::RestoreIoPort( void )
-{
-  if (!fDeviceAvailable) return;
-
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void NanotecComHandler::CloseIoPort( void )
-{
-  if (!fDeviceAvailable) return;
-
-  close( fIoPortFileDescriptor );
-}
-
-//! Send command termination string (<CR><NL>).
-/*!
-  \internal
-*/
-void NanotecComHandler::SendFeedString( void )
-{
-  if (!fDeviceAvailable) return;
-
-  // feed string is <CR>
-  char feedString = '\r';
+  fTransport->Configure( fThisTermios );
 
-  // write <CR> and get echo
-  write( fIoPortFileDescriptor, &feedString, 1 );
+  // replies are terminated by <CR>
+  fTransport->SetTerminator( "\r" );
 }
 
 bool NanotecComHandler::DeviceAvailable()
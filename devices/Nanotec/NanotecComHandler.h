@@ -20,6 +20,8 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <memory>
+
 /** @addtogroup devices
  *  @{
  */
@@ -31,6 +33,9 @@
 typedef const char* ioport_t;
 typedef struct termios termios_t;
 
+class SerialTransport;
+class SerialBroker;
+
 class NanotecComHandler
 {
  public:
@@ -46,6 +51,8 @@ class NanotecComHandler
 
   void SendCommand( const char* );
   void ReceiveString( char* );
+  int Query( const char*, char*, unsigned int replies = 1 );
+  int Execute( const char*, char*, unsigned int replies = 1 );
 
   bool DeviceAvailable();
 
@@ -53,15 +60,13 @@ class NanotecComHandler
 
   void OpenIoPort( void );
   void InitializeIoPort( void );
-  void RestoreIoPort( void );
-  void CloseIoPort( void );
-  void SendFeedString( void );
 
   bool fDeviceAvailable;
-  int fIoPortFileDescriptor;
+  SerialTransport* fTransport;
+  std::shared_ptr<SerialBroker> fBroker;
 
   ioport_t fIoPort;
-  termios_t fCurrentTermios, fThisTermios;
+  termios_t fThisTermios;
 };
 
 /** @} */
@@ -14,8 +14,22 @@
 #include <cmath>
 #include <sstream>
 
+#include "ScpiToolkit.h"
+
 #include "NanotecSMCI36.h"
 
+namespace {
+
+// value following the command character in a reply like "1C1234"
+template <typename T>
+void ParseReply(std::string_view reply, char key, T& value)
+{
+  size_t idx = reply.find(key);
+  if (idx != std::string_view::npos) Scpi::ParseNumber(reply.substr(idx+1), value);
+}
+
+}
+
 NanotecSMCI36::NanotecSMCI36( const ioport_t ioPort )
   :VNanotecSMCI36(ioPort),
    isDeviceAvailable_(false)
@@ -39,9 +53,8 @@ std::string NanotecSMCI36::GetFirmwareVersion() const
   char command[20];
   sprintf(command, "#%dv", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -55,9 +68,8 @@ int NanotecSMCI36::GetStatus() const
   char command[20];
   sprintf(command, "#%d$", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -73,9 +85,8 @@ void NanotecSMCI36::SetMotorType(int type)
   char command[20];
   sprintf(command, "#%d:CL_motor_type%d", driveAddress_, type);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetMotorType() const
@@ -83,9 +94,8 @@ int NanotecSMCI36::GetMotorType() const
   char command[20];
   sprintf(command, "#%d:CL_motor_type", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -101,9 +111,8 @@ void NanotecSMCI36::SetPhaseCurrent(int current)
   char command[20];
   sprintf(command, "#%di%d", driveAddress_, current);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetPhaseCurrent() const
@@ -111,9 +120,8 @@ int NanotecSMCI36::GetPhaseCurrent() const
   char command[20];
   sprintf(command, "#%dZi", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -131,9 +139,8 @@ void NanotecSMCI36::SetStandStillPhaseCurrent(int current)
   char command[20];
   sprintf(command, "#%dr%d", driveAddress_, current);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetStandStillPhaseCurrent() const
@@ -141,9 +148,8 @@ int NanotecSMCI36::GetStandStillPhaseCurrent() const
   char command[20];
   sprintf(command, "#%dZr", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -171,9 +177,8 @@ void NanotecSMCI36::SetStepMode(int mode)
   char command[20];
   sprintf(command, "#%dg%d", driveAddress_, mode);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetStepMode() const
@@ -181,9 +186,8 @@ int NanotecSMCI36::GetStepMode() const
   char command[20];
   sprintf(command, "#%dZg", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -201,16 +205,14 @@ void NanotecSMCI36::SetDriveAddress(int address)
   char command[20];
   sprintf(command, "m%d", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetDriveAddress()
 {
-  comHandler_->SendCommand("#*m");
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query("#*m", buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -228,9 +230,8 @@ void NanotecSMCI36::SetMotorID(int ID)
   char command[20];
   sprintf(command, "#%d:mt%d", driveAddress_, ID);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetMotorID() const
@@ -238,9 +239,8 @@ int NanotecSMCI36::GetMotorID() const
   char command[20];
   sprintf(command, "#%d:mt", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -258,9 +258,8 @@ void NanotecSMCI36::SetErrorCorrectionMode(int mode)
   char command[20];
   sprintf(command, "#%dU%d", driveAddress_, mode);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetErrorCorrectionMode() const
@@ -268,9 +267,8 @@ int NanotecSMCI36::GetErrorCorrectionMode() const
   char command[20];
   sprintf(command, "#%dZU", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -286,9 +284,8 @@ void NanotecSMCI36::SetEncoderDirection(bool direction)
   char command[20];
   sprintf(command, "#%dq%d", driveAddress_, (int)direction);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 bool NanotecSMCI36::GetEncoderDirection() const
@@ -296,9 +293,8 @@ bool NanotecSMCI36::GetEncoderDirection() const
   char command[20];
   sprintf(command, "#%dZq", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -316,9 +312,8 @@ void NanotecSMCI36::SetSwingOutTime(int time)
   char command[20];
   sprintf(command, "#%dO%d", driveAddress_, time);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetSwingOutTime() const
@@ -326,9 +321,8 @@ int NanotecSMCI36::GetSwingOutTime() const
   char command[20];
   sprintf(command, "#%dZO", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -346,9 +340,8 @@ void NanotecSMCI36::SetMaxEncoderDeviation(int deviation)
   char command[20];
   sprintf(command, "#%dX%d", driveAddress_, deviation);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetMaxEncoderDeviation() const
@@ -356,9 +349,8 @@ int NanotecSMCI36::GetMaxEncoderDeviation() const
   char command[20];
   sprintf(command, "#%dZX", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -374,9 +366,8 @@ int NanotecSMCI36::GetPosition() const
   char command[20];
   sprintf(command, "#%dC", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -392,9 +383,8 @@ int NanotecSMCI36::GetEncoderPosition() const
   char command[20];
   sprintf(command, "#%dI", driveAddress_);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -405,14 +395,44 @@ int NanotecSMCI36::GetEncoderPosition() const
   return std::atoi(ret.c_str());
 }
 
+//! Read status, controller and encoder position and IO in a single transaction.
+/*!
+  The four queries are sent in one write and answered one after the
+  other, each reply echoes its command without the leading '#'.
+*/
+void NanotecSMCI36::GetMotionStatus(unsigned int& status, int& position,
+                                    int& encoderPosition, unsigned int& io) const
+{
+  Scpi::Command<64> command;
+  command << '#' << driveAddress_ << "$\r"
+          << '#' << driveAddress_ << "C\r"
+          << '#' << driveAddress_ << "I\r"
+          << '#' << driveAddress_ << "ZY";
+
+  char buffer[1000];
+  comHandler_->Query(command.c_str(), buffer, 4);
+
+  Scpi::Tokenizer replies(buffer, "\r\n");
+  std::string_view reply;
+
+  status = 0;
+  position = 0;
+  encoderPosition = 0;
+  io = 0;
+
+  if (replies.Next(reply)) ParseReply(reply, '$', status);
+  if (replies.Next(reply)) ParseReply(reply, 'C', position);
+  if (replies.Next(reply)) ParseReply(reply, 'I', encoderPosition);
+  if (replies.Next(reply)) ParseReply(reply, 'Y', io);
+}
+
 void NanotecSMCI36::ResetPositionError(int position)
 {
   char command[20];
   sprintf(command, "#%dD%d", driveAddress_, position);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 void NanotecSMCI36::SetInputPinFunction(int pin, int function)
@@ -423,9 +443,8 @@ void NanotecSMCI36::SetInputPinFunction(int pin, int function)
   char command[20];
   sprintf(command, "#%d:port_in_%c%d", driveAddress_, 'a'+pin-1, function);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetInputPinFunction(int pin) const
@@ -435,10 +454,8 @@ int NanotecSMCI36::GetInputPinFunction(int pin) const
   char command[20];
   sprintf(command, "#%d:port_in_%c", driveAddress_, 'a'+pin-1);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -457,9 +474,8 @@ void NanotecSMCI36::SetOutputPinFunction(int pin, int function)
   char command[20];
   sprintf(command, "#%d:port_out_%c%d", driveAddress_, 'a'+pin-1, function);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetOutputPinFunction(int pin) const
@@ -469,10 +485,8 @@ int NanotecSMCI36::GetOutputPinFunction(int pin) const
   char command[20];
   sprintf(command, "#%d:port_out_%c", driveAddress_, 'a'+pin-1);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -488,9 +502,8 @@ void NanotecSMCI36::SetIOMask(unsigned int mask)
   char command[20];
   sprintf(command, "#%dL%d", driveAddress_, mask);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 unsigned int NanotecSMCI36::GetIOMask() const
@@ -498,10 +511,8 @@ unsigned int NanotecSMCI36::GetIOMask() const
   char command[20];
   sprintf(command, "#%dZL", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -517,9 +528,8 @@ void NanotecSMCI36::SetReversePolarityMask(unsigned int mask)
   char command[20];
   sprintf(command, "#%dh%d", driveAddress_, mask);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 unsigned int NanotecSMCI36::GetReversePolarityMask() const
@@ -527,10 +537,8 @@ unsigned int NanotecSMCI36::GetReversePolarityMask() const
   char command[20];
   sprintf(command, "#%dZh", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -546,9 +554,8 @@ void NanotecSMCI36::SetIO(unsigned int mask)
   char command[20];
   sprintf(command, "#%dY%d", driveAddress_, mask);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 unsigned int NanotecSMCI36::GetIO() const
@@ -556,10 +563,8 @@ unsigned int NanotecSMCI36::GetIO() const
   char command[20];
   sprintf(command, "#%dZY", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -577,9 +582,8 @@ void NanotecSMCI36::SetRampMode(int ramp)
   char command[20];
   sprintf(command, "#%d:ramp_mode%d", driveAddress_, ramp);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetRampMode() const
@@ -587,10 +591,8 @@ int NanotecSMCI36::GetRampMode() const
   char command[20];
   sprintf(command, "#%d:ramp_mode", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -608,9 +610,8 @@ void NanotecSMCI36::SetQuickstopRamp(int ramp)
   char command[20];
   sprintf(command, "#%dH%d", driveAddress_, ramp);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetQuickstopRamp() const
@@ -618,10 +619,8 @@ int NanotecSMCI36::GetQuickstopRamp() const
   char command[20];
   sprintf(command, "#%dZH", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -639,9 +638,8 @@ void NanotecSMCI36::SetQuickstopRampHzPerSecond(int ramp)
   char command[20];
   sprintf(command, "#%d:decelquick%d", driveAddress_, ramp);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetQuickstopRampHzPerSecond() const
@@ -649,10 +647,8 @@ int NanotecSMCI36::GetQuickstopRampHzPerSecond() const
   char command[20];
   sprintf(command, "#%d:decelquick", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -670,9 +666,8 @@ void NanotecSMCI36::SetAccelerationRamp(int ramp)
   char command[20];
   sprintf(command, "#%db%d", driveAddress_, ramp);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetAccelerationRamp() const
@@ -680,10 +675,8 @@ int NanotecSMCI36::GetAccelerationRamp() const
   char command[20];
   sprintf(command, "#%dZb", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -701,9 +694,8 @@ void NanotecSMCI36::SetAccelerationRampHzPerSecond(int ramp)
   char command[20];
   sprintf(command, "#%d:accel%d", driveAddress_, ramp);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetAccelerationRampHzPerSecond() const
@@ -711,10 +703,8 @@ int NanotecSMCI36::GetAccelerationRampHzPerSecond() const
   char command[20];
   sprintf(command, "#%d:accel", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -732,9 +722,8 @@ void NanotecSMCI36::SetDecelerationRamp(int ramp)
   char command[20];
   sprintf(command, "#%dB%d", driveAddress_, ramp);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetDecelerationRamp() const
@@ -742,10 +731,8 @@ int NanotecSMCI36::GetDecelerationRamp() const
   char command[20];
   sprintf(command, "#%dZB", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -763,9 +750,8 @@ void NanotecSMCI36::SetDecelerationRampHzPerSecond(int ramp)
   char command[20];
   sprintf(command, "#%d:decel%d", driveAddress_, ramp);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetDecelerationRampHzPerSecond() const
@@ -773,10 +759,8 @@ int NanotecSMCI36::GetDecelerationRampHzPerSecond() const
   char command[20];
   sprintf(command, "#%d:decel", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -794,9 +778,8 @@ void NanotecSMCI36::SetPositioningMode(int mode)
   char command[20];
   sprintf(command, "#%dp%d", driveAddress_, mode);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetPositioningMode() const
@@ -804,10 +787,8 @@ int NanotecSMCI36::GetPositioningMode() const
   char command[20];
   sprintf(command, "#%dZp", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -823,9 +804,8 @@ void NanotecSMCI36::SetTravelDistance(int distance)
   char command[20];
   sprintf(command, "#%ds%d", driveAddress_, distance);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetTravelDistance() const
@@ -833,10 +813,8 @@ int NanotecSMCI36::GetTravelDistance() const
   char command[20];
   sprintf(command, "#%dZs", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -852,9 +830,8 @@ void NanotecSMCI36::SetDirection(bool direction)
   char command[20];
   sprintf(command, "#%dd%d", driveAddress_, (int)direction);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 bool NanotecSMCI36::GetDirection() const
@@ -862,10 +839,8 @@ bool NanotecSMCI36::GetDirection() const
   char command[20];
   sprintf(command, "#%dZd", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -883,9 +858,8 @@ void NanotecSMCI36::SetMinimumFrequency(int frequency)
   char command[20];
   sprintf(command, "#%du%d", driveAddress_, frequency);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetMinimumFrequency() const
@@ -893,10 +867,8 @@ int NanotecSMCI36::GetMinimumFrequency() const
   char command[20];
   sprintf(command, "#%dZu", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -914,9 +886,8 @@ void NanotecSMCI36::SetMaximumFrequency(int frequency)
   char command[20];
   sprintf(command, "#%do%d", driveAddress_, frequency);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetMaximumFrequency() const
@@ -924,10 +895,8 @@ int NanotecSMCI36::GetMaximumFrequency() const
   char command[20];
   sprintf(command, "#%dZo", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -945,9 +914,8 @@ void NanotecSMCI36::SetMaximumFrequency2(int frequency)
   char command[20];
   sprintf(command, "#%dn%d", driveAddress_, frequency);
 
-  comHandler_->SendCommand(command);
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Execute(command, buffer);
 }
 
 int NanotecSMCI36::GetMaximumFrequency2() const
@@ -955,10 +923,8 @@ int NanotecSMCI36::GetMaximumFrequency2() const
   char command[20];
   sprintf(command, "#%dZn", driveAddress_);
 
-  comHandler_->SendCommand(command);
-
   char buffer[1000];
-  comHandler_->ReceiveString(buffer);
+  comHandler_->Query(command, buffer);
   StripBuffer(buffer);
 
   std::string ret = buffer;
@@ -974,7 +940,9 @@ void NanotecSMCI36::Start()
   char command[20];
   sprintf(command, "#%dA", driveAddress_);
 
-  comHandler_->SendCommand(command);
+  // the echo of the command has to be read, it would be taken for the reply of the next query
+  char buffer[1000];
+  comHandler_->Execute(command, buffer);
 }
 
 void NanotecSMCI36::Stop(bool quickstop)
@@ -982,7 +950,9 @@ void NanotecSMCI36::Stop(bool quickstop)
   char command[20];
   sprintf(command, "#%dS%d", driveAddress_, (int)!quickstop);
 
-  comHandler_->SendCommand(command);
+  // the echo of the command has to be read, it would be taken for the reply of the next query
+  char buffer[1000];
+  comHandler_->Execute(command, buffer);
 }
 
 void NanotecSMCI36::StripBuffer(char* buffer) const
@@ -1002,9 +972,8 @@ void NanotecSMCI36::DeviceInit()
   if (comHandler_->DeviceAvailable()) {
     
     // get the drive address
-    comHandler_->SendCommand("#*m");
     char buffer[1000];
-    comHandler_->ReceiveString(buffer);
+    comHandler_->Query("#*m", buffer);
     StripBuffer(buffer);
 
     std::string buf = buffer;
@@ -1015,8 +984,7 @@ void NanotecSMCI36::DeviceInit()
     char command[20];
     sprintf(command, "#%dv", driveAddress_);
 
-    comHandler_->SendCommand(command);
-    comHandler_->ReceiveString(buffer);
+    comHandler_->Query(command, buffer);
     StripBuffer(buffer);
     buf = buffer;
 
@@ -80,6 +80,9 @@ class NanotecSMCI36 : public VNanotecSMCI36
   int GetEncoderPosition() const;
   void ResetPositionError(int position);
 
+  void GetMotionStatus(unsigned int& status, int& position,
+                       int& encoderPosition, unsigned int& io) const;
+
   void SetInputPinFunction(int pin, int function);
   int GetInputPinFunction(int pin) const;
 
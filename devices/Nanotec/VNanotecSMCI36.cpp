@@ -122,6 +122,15 @@ const std::string VNanotecSMCI36::GetPositioningModeName(int mode) const
   return "unknown";
 }
 
+void VNanotecSMCI36::GetMotionStatus(unsigned int& status, int& position,
+                                     int& encoderPosition, unsigned int& io) const
+{
+  status = GetStatus();
+  position = GetPosition();
+  encoderPosition = GetEncoderPosition();
+  io = GetIO();
+}
+
 unsigned int VNanotecSMCI36::GetInputBitForPin(int pin) const
 {
   switch (pin) {
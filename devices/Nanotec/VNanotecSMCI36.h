@@ -182,6 +182,10 @@ class VNanotecSMCI36
 
   virtual void ResetPositionError(int position) = 0;
 
+  // reads status, positions and IO in one go, the default calls the single getters
+  virtual void GetMotionStatus(unsigned int& status, int& position,
+                               int& encoderPosition, unsigned int& io) const;
+
   virtual void SetInputPinFunction(int pin, int function) = 0;
   virtual int GetInputPinFunction(int pin) const = 0;
   const std::string GetInputPinFunctionName(int function) const;
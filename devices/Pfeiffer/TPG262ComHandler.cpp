@@ -2,6 +2,7 @@
 
 #include <iostream>
 
+#include "SerialTransport.h"
 #include "TPG262ComHandler.h"
 
 // SETTINGS ON THE DEVICE:
@@ -33,11 +34,8 @@ TPG262ComHandler::TPG262ComHandler( const ioport_t ioPort )
 ///
 TPG262ComHandler::~TPG262ComHandler( void )
 {
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
@@ -45,40 +43,28 @@ void TPG262ComHandler::SendCommand( const char *commandString )
 {
   if (!fDeviceAvailable) return;
 
-  char singleCharacter = 0; 
-
-  for ( unsigned int i = 0; i < strlen( commandString ); i++ ) {
-    
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
-  }
+  // command and feed characters ( <CR><LF> ) in a single write
+  std::string command = commandString;
+  command += "\r\n";
 
-  // send feed characters
-  SendFeedString();
+  fTransport->Write( command );
 }
 
 void TPG262ComHandler::SendEnquiry( )
 {
   if (!fDeviceAvailable) return;
 
-  char singleCharacter = 0x05; 
-
-  write( fIoPortFileDescriptor, &singleCharacter, 1 );
-
-  // send feed characters
-  SendFeedString();
+  // <ENQ> and feed characters
+  fTransport->Write( "\x05\r\n" );
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
-
-  This function must be placed right in time before
-  the device starts sending.
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  See example program in class description.
+  Waits until the device has sent a complete line or the timeout has
+  expired.
 */
 void TPG262ComHandler::ReceiveString( char *receiveString )
 {
@@ -87,21 +73,7 @@ void TPG262ComHandler::ReceiveString( char *receiveString )
     return;
   }
 
-  usleep( ComHandlerDelay );
-
-  int timeout = 0, readResult = 0;
-
-  while ( timeout < 100000 )  {
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1000 );
-
-    if ( readResult > 0 )   {
-      receiveString[readResult] = 0;
-      break;
-    }
-    
-    timeout++;
-  }
+  fTransport->Read( receiveString, 1000 );
 }
 
 //! Open I/O port.
@@ -110,11 +82,10 @@ void TPG262ComHandler::ReceiveString( char *receiveString )
 */
 void TPG262ComHandler::OpenIoPort( void )
 {
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
 
   // check if successful
-  if ( fIoPortFileDescriptor == -1 ) {
+  if ( !fTransport->Open() ) {
     std::cerr << "[TPG262ComHandler::OpenIoPort] ** ERROR: could not open device file "
         << fIoPort << "." << std::endl;
     std::cerr << "                               (probably it's not user-writable)."
@@ -122,10 +93,6 @@ void TPG262ComHandler::OpenIoPort( void )
     fDeviceAvailable = false;
     return;
   }
-  else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
-  }
 
   fDeviceAvailable = true;
 }
@@ -136,10 +103,12 @@ void TPG262ComHandler::OpenIoPort( void )
 */
 void TPG262ComHandler::InitializeIoPort( void )
 {
-#ifndef USE_FAKEIO
+  if (!fDeviceAvailable) return;
 
-  // get and save current ioport settings for later restoring
-  tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
+  // replies are terminated by <CR><LF>
+  fTransport->SetTerminator( "\n" );
+
+#ifndef USE_FAKEIO
 
   // CONFIGURE NEW SETTINGS
 
@@ -207,57 +176,17 @@ void TPG262ComHandler::InitializeIoPort( void )
 //   fThisTermios.c_cflag   |=  FF0;
 
   // commit changes
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fThisTermios );
+  fTransport->Configure( fThisTermios );
 
 #endif
 }
 
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-
-void TPG262ComHandler::RestoreIoPort( void )
-{
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void TPG262ComHandler::CloseIoPort( void )
-{
-  close( fIoPortFileDescriptor );
-}
-
-//! Send command termination string (<CR><NL>).
-/*!
-  \internal
-*/
-void TPG262ComHandler::SendFeedString( void )
-{
-  // feed string is <NL>
-  char feedString = 13;
-
-  // write <CR> and get echo
-  write( fIoPortFileDescriptor, &feedString, 1 );
-
-  feedString = 10;
-
-  // write <LF> and get echo
-  write( fIoPortFileDescriptor, &feedString, 1 );
-
-}
-
 void TPG262ComHandler::SendResetInterface()
 {
-  char singleCharacter=0x03;
-  write( fIoPortFileDescriptor, &singleCharacter, 1);
-  
-  // send feed characters
-  SendFeedString();
+  if (!fDeviceAvailable) return;
+
+  // <ETX> and feed characters
+  fTransport->Write( "\x03\r\n" );
 }
 
 bool TPG262ComHandler::DeviceAvailable()
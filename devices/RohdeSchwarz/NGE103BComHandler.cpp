@@ -13,7 +13,9 @@
 #include <string.h>
 
 #include <iostream>
+#include <string>
 
+#include "SerialTransport.h"
 #include "NGE103BComHandler.h"
 
 /*!
@@ -33,11 +35,8 @@ NGE103BComHandler::NGE103BComHandler(ioport_t ioPort)
 
 NGE103BComHandler::~NGE103BComHandler( void )
 {
-  // restore ioport options as they were
-  RestoreIoPort();
-  
-  // close device file
-  CloseIoPort();
+  // restore ioport options as they were and close device file
+  delete fTransport;
 }
 
 //! Send the command string &lt;commandString&gt; to device.
@@ -45,28 +44,20 @@ void NGE103BComHandler::SendCommand( const char *commandString )
 {
   if (!fDeviceAvailable) return;
 
-  char singleCharacter = 0; 
+  // command and feed characters in a single write; feed string is <NL>
+  std::string command = commandString;
+  command += "\n";
 
-  for ( unsigned int i = 0; i < strlen( commandString ); i++ ) {
-    
-    // scan command string character wise & write
-    singleCharacter = commandString[i];
-    write( fIoPortFileDescriptor, &singleCharacter, 1 );
-  }
-
-  // send feed characters
-  SendFeedString();
+  fTransport->Write( command );
 }
 
 //! Read a string from device.
 /*!
 \par Input:
-  <br><b>Receive string must be at least 41 characters long.</b>
+  <br><b>Receive string must be at least 1000 characters long.</b>
 
-  This function must be placed right in time before
-  the device starts sending.
-
-  See example program in class description.
+  Waits until the device has sent a complete reply or the timeout has
+  expired.
 */
 void NGE103BComHandler::ReceiveString( char *receiveString )
 {
@@ -75,21 +66,7 @@ void NGE103BComHandler::ReceiveString( char *receiveString )
     return;
   }
 
-  usleep( 10000 );
-
-  int timeout = 0, readResult = 0;
-
-  while ( timeout < 100000 )  {
-
-    readResult = read( fIoPortFileDescriptor, receiveString, 1024 );
-
-    if ( readResult > 0 ) {
-      receiveString[readResult] = 0;
-      break;
-    }
-    
-    timeout++;
-  }
+  fTransport->Read( receiveString, 1000 );
 }
 
 //! Open I/O port.
@@ -98,20 +75,16 @@ void NGE103BComHandler::ReceiveString( char *receiveString )
 */
 void NGE103BComHandler::OpenIoPort( void )
 {
-  // open io port ( read/write | no term control | no DCD line check )
-  fIoPortFileDescriptor = open( fIoPort, O_RDWR | O_NOCTTY  | O_NDELAY );
+  fTransport = new SerialTransport( fIoPort );
 
-  // check if successful
-  if ( fIoPortFileDescriptor == -1 ) {
+  // open io port ( read/write | no term control | non-blocking )
+  if ( !fTransport->Open() ) {
     std::cerr << "[NGE103BComHandler::OpenIoPort] ** ERROR: could not open device file "
               << fIoPort << "." << std::endl;
     std::cerr << "                               (probably it's not user-writable)."
               << std::endl;
     fDeviceAvailable = false;
     return;
-  } else {
-    // configure port with no delay
-    fcntl( fIoPortFileDescriptor, F_SETFL, FNDELAY );
   }
 
   fDeviceAvailable = true;
@@ -125,46 +98,10 @@ void NGE103BComHandler::InitializeIoPort( void )
 {
   if (!fDeviceAvailable) return;
 
-  // get and save current ioport settings for later restoring
-  tcgetattr( fIoPortFileDescriptor, &fCurrentTermios );
-}
-
-//! Restore former I/O port settings.
-/*!
-  \internal
-*/
-void NGE103BComHandler::RestoreIoPort( void )
-{
-  if (!fDeviceAvailable) return;
-
-  // restore old com port settings
-  tcsetattr( fIoPortFileDescriptor, TCSANOW, &fCurrentTermios );
-}
-
-//! Close I/O port.
-/*!
-  \internal
-*/
-void NGE103BComHandler::CloseIoPort( void )
-{
-  if (!fDeviceAvailable) return;
-
-  close( fIoPortFileDescriptor );
-}
-
-//! Send command termination string (<CR><NL>).
-/*!
-  \internal
-*/
-void NGE103BComHandler::SendFeedString( void )
-{
-  if (!fDeviceAvailable) return;
-
-  // feed string is <NL>
-  char feedString = 10;
+  // the port is used with the settings of the USB serial driver
 
-  // write <CR> and get echo
-  write( fIoPortFileDescriptor, &feedString, 1 );
+  // replies are terminated by <NL>
+  fTransport->SetTerminator( "\n" );
 }
 
 bool NGE103BComHandler::DeviceAvailable()
@@ -122,6 +122,11 @@ PlasmaMainWindow::PlasmaMainWindow(QWidget *parent)
                                          0x107003F)
       );
 
+      smci36ModelX_->setPositionStreaming(
+          config->getValue<int>("SMCI36_PositionStreamInterval_X",
+                                20)
+      );
+
       stageX_->setPitch(config->getValue<double>("Stage_Pitch_X",
                                                  0.35)
       );
@@ -38,6 +38,8 @@ ThermoMainWindow::ThermoMainWindow(QWidget *parent) :
     // KEITHLEY MODEL
     keithleyModel_ = new KeithleyModel(config->getValue<std::string>("KeithleyDevice").c_str(),
                                        20, this);
+    keithleyModel_->setBinaryReadout(config->getValue<int>("KeithleyBinaryReadout", 0));
+    keithleyModel_->setContinuousScan(config->getValue<int>("KeithleyContinuousScan", 0));
 
     // HAMEG MODEL
     hamegModel_ = new HamegModel(config->getValue<std::string>("HamegDevice").c_str(),
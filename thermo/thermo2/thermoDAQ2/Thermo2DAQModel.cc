@@ -11,6 +11,7 @@
 /////////////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
+#include <cstring>
 
 #include <QApplication>
 #include <QDateTime>
@@ -18,6 +19,7 @@
 
 #include <nqlogger.h>
 
+#include "Thermo2DAQSchema.h"
 #include "Thermo2DAQModel.h"
 
 Thermo2DAQModel::Thermo2DAQModel(HuberUnistat525wModel* huberModel,
@@ -50,6 +52,23 @@ Thermo2DAQModel::Thermo2DAQModel(HuberUnistat525wModel* huberModel,
 
   connect(keithleyModel_, SIGNAL(informationChanged()),
           this, SLOT(keithleyInfoChanged()));
+
+  std::memset(&record_, 0, sizeof(record_));
+  record_.version = Thermo2DAQRecordVersion;
+
+  daqRing_ = new SharedMemoryRing(Thermo2DAQRecordName,
+                                  sizeof(Thermo2DAQRecord),
+                                  Thermo2DAQRecordCapacity,
+                                  SharedMemoryRing::Writer);
+  if (!daqRing_->isValid()) {
+    NQLogWarning("Thermo2DAQModel") << "could not create shared memory ring "
+                                    << daqRing_->name();
+  }
+}
+
+Thermo2DAQModel::~Thermo2DAQModel()
+{
+  delete daqRing_;
 }
 
 void Thermo2DAQModel::myMoveToThread(QThread *thread)
@@ -68,27 +87,31 @@ void Thermo2DAQModel::startMeasurement()
   daqState_ = true;
   emit daqStateChanged(true);
 
-  for (int i=0;i<3;++i) {
-    nge103BOutputState_[i] = false;
-    nge103BOutputMode_[i] = 0;
-    nge103BVoltage_[i] = -1.0;
-    nge103BCurrent_[i] = -1.0;
-    nge103BMeasuredVoltage_[i] = 0.;
-    nge103BMeasuredCurrent_[i] = 0.;
-  }
+  {
+    QMutexLocker locker(&mutex_);
 
-  agilentState_ = false;
-  agilentPumpState_ = false;
-  agilentPumpStatus_ = 0;
-  agilentErrorCode_ = 0;
+    for (int i=0;i<3;++i) {
+      record_.nge103BState[i] = false;
+      record_.nge103BMode[i] = 0;
+      record_.nge103BVoltage[i] = -1.0;
+      record_.nge103BCurrent[i] = -1.0;
+      record_.nge103BMeasuredVoltage[i] = 0.;
+      record_.nge103BMeasuredCurrent[i] = 0.;
+    }
 
-  leyboldState_ = false;
-  leyboldPressure_ = 1.013;
+    record_.agilentState = false;
+    record_.agilentPumpState = false;
+    record_.agilentPumpStatus = 0;
+    record_.agilentErrorCode = 0;
 
-  for (unsigned int card=0;card<2;++card) {
-    for (unsigned int channel=0;channel<10;++channel) {
-      keithleyState_[card][channel] = false;
-      keithleyTemperature_[card][channel] = 0.;
+    record_.leyboldState = false;
+    record_.leyboldPressure = 1.013;
+
+    for (unsigned int card=0;card<2;++card) {
+      for (unsigned int channel=0;channel<10;++channel) {
+        record_.keithleyState[card][channel] = false;
+        record_.keithleyTemperature[card][channel] = 0.;
+      }
     }
   }
 
@@ -99,111 +122,77 @@ void Thermo2DAQModel::startMeasurement()
   NQLogMessage("thermo2DAQ") << "measurement started";
 }
 
-void Thermo2DAQModel::createDAQStatusMessage(QString &buffer, bool start)
+void Thermo2DAQModel::fillHuberUnistat525w(Thermo2DAQRecord& record)
 {
-  QDateTime& utime = currentTime();
+  record.u525wState = huberModel_->getDeviceState()==READY;
+  record.u525wTemperatureSetPoint = huberModel_->getTemperatureSetPoint();
+  record.u525wTemperatureControlMode = huberModel_->getTemperatureControlMode();
+  record.u525wTemperatureControlEnabled = huberModel_->getTemperatureControlEnabled();
+  record.u525wCirculatorEnabled = huberModel_->getCirculatorEnabled();
+  record.u525wBathTemperature = huberModel_->getBathTemperature();
+  record.u525wReturnTemperature = huberModel_->getReturnTemperature();
+  record.u525wPumpPressure = huberModel_->getPumpPressure();
+  record.u525wPower = huberModel_->getPower();
+  record.u525wCWInletTemperature = huberModel_->getCoolingWaterInletTemperature();
+  record.u525wCWOutletTemperature = huberModel_->getCoolingWaterOutletTemperature();
+}
 
-  QXmlStreamWriter xml(&buffer);
-  xml.setAutoFormatting(true);
+void Thermo2DAQModel::fillAgilentTwisTorr304(Thermo2DAQRecord& record)
+{
+  record.agilentState = agilentModel_->getDeviceState()==READY;
+  record.agilentPumpState = agilentModel_->getPumpState();
+  record.agilentPumpStatus = agilentModel_->getPumpStatus();
+  record.agilentErrorCode = agilentModel_->getErrorCode();
+}
 
-  //
-  // Start of Huber Unistat 525w
-  //
-  xml.writeStartElement("HuberUnistat525w");
-  xml.writeAttribute("time", utime.toString(Qt::ISODate));
-  xml.writeAttribute("State", huberModel_->getDeviceState()==READY ? "1" : "0");
-
-  xml.writeStartElement("HuberUnistat525wControl");
-  xml.writeAttribute("SetPoint", QString::number(huberModel_->getTemperatureSetPoint(), 'f', 2));
-  xml.writeAttribute("ControlMode", QString::number(huberModel_->getTemperatureControlMode()));
-  xml.writeAttribute("ControlEnabled", QString::number(huberModel_->getTemperatureControlEnabled()));
-  xml.writeAttribute("CirculatorEnabled", QString::number(huberModel_->getCirculatorEnabled()));
-  xml.writeEndElement();
-
-  xml.writeStartElement("HuberUnistat525wInfo");
-  xml.writeAttribute("Bath", QString::number(huberModel_->getBathTemperature(), 'f', 2));
-  xml.writeAttribute("Return", QString::number(huberModel_->getReturnTemperature(), 'f', 2));
-  xml.writeAttribute("Pressure", QString::number(huberModel_->getPumpPressure(), 'f', 3));
-  xml.writeAttribute("Power", QString::number(huberModel_->getPower()));
-  xml.writeAttribute("CWI", QString::number(huberModel_->getCoolingWaterInletTemperature(), 'f', 2));
-  xml.writeAttribute("CWO", QString::number(huberModel_->getCoolingWaterOutletTemperature(), 'f', 2));
-  xml.writeEndElement();
-
-  xml.writeEndElement();
-  //
-  // End of Huber Unistat 525w
-  //
-
-  //
-  // Start of Agilent TwisTorr 304
-  //
-
-  xml.writeStartElement("AgilentTwisTorr304");
-  xml.writeAttribute("time", utime.toString(Qt::ISODate));
-  xml.writeAttribute("State", agilentModel_->getDeviceState()==READY ? "1" : "0");
-  xml.writeAttribute("PumpState", agilentModel_->getPumpState()==true ? "1" : "0");
-  xml.writeAttribute("PumpStatus", QString::number(agilentModel_->getPumpStatus()));
-  xml.writeAttribute("ErrorCode", QString::number(agilentModel_->getErrorCode()));
-  xml.writeEndElement();
-
-  //
-  // End of Agilent TwisTorr 304
-  //
-
-  //
-  // Start of Leybold Graphix One
-  //
-
-  xml.writeStartElement("LeyboldGraphixOne");
-  xml.writeAttribute("time", utime.toString(Qt::ISODate));
-  xml.writeAttribute("State", leyboldModel_->getDeviceState()==READY ? "1" : "0");
-  xml.writeAttribute("Pressure", QString::number(leyboldModel_->getPressure(), 'e', 3));
-  xml.writeEndElement();
-
-  //
-  // End of Leybold Graphix One
-  //
-
-  //
-  // Start of Rohde & Schwarz NGE103B
-  //
-  xml.writeStartElement("RohdeSchwarzNGE103B");
-  xml.writeAttribute("time", utime.toString(Qt::ISODate));
+void Thermo2DAQModel::fillLeyboldGraphixOne(Thermo2DAQRecord& record)
+{
+  record.leyboldState = leyboldModel_->getDeviceState()==READY;
+  record.leyboldPressure = leyboldModel_->getPressure();
+}
+
+void Thermo2DAQModel::fillRohdeSchwarzNGE103B(Thermo2DAQRecord& record)
+{
   for (int i=0;i<3;++i) {
-    xml.writeStartElement(QString("RohdeSchwarzNGE103BChannel"));
-    xml.writeAttribute("id", QString::number(i+1));
-    xml.writeAttribute("State", nge103BModel_->getOutputState(i+1)==true ? "1" : "0");
-    xml.writeAttribute("Mode", QString::number(nge103BModel_->getOutputMode(i+1)));
-    xml.writeAttribute("U", QString::number(nge103BModel_->getVoltage(i+1), 'f', 3));
-    xml.writeAttribute("mU", QString::number(nge103BModel_->getMeasuredVoltage(i+1), 'f', 3));
-    xml.writeAttribute("I", QString::number(nge103BModel_->getCurrent(i+1), 'f', 3));
-    xml.writeAttribute("mI", QString::number(nge103BModel_->getMeasuredCurrent(i+1), 'f', 3));
-    xml.writeEndElement();
+    record.nge103BState[i] = nge103BModel_->getOutputState(i+1);
+    record.nge103BMode[i] = nge103BModel_->getOutputMode(i+1);
+    record.nge103BVoltage[i] = nge103BModel_->getVoltage(i+1);
+    record.nge103BCurrent[i] = nge103BModel_->getCurrent(i+1);
+    record.nge103BMeasuredVoltage[i] = nge103BModel_->getMeasuredVoltage(i+1);
+    record.nge103BMeasuredCurrent[i] = nge103BModel_->getMeasuredCurrent(i+1);
   }
-  xml.writeEndElement();
-  //
-  // End of Rohde & Schwarz NGE103B
-  //
-
-  //
-  // Start of Keithley DAQ6510
-  //
-  xml.writeStartElement("KeithleyDAQ6510");
-  xml.writeAttribute("time", utime.toString(Qt::ISODate));
-  for (unsigned int card=1;card<=2;++card) {
-    for (unsigned int channel=1;channel<=10;++channel) {
-      unsigned int sensor = card*100 + channel;
-      xml.writeStartElement(QString("KeithleyDAQ6510Sensor"));
-      xml.writeAttribute("id", QString::number(sensor));
-      xml.writeAttribute("State", keithleyModel_->getSensorState(sensor)==READY ? "1" : "0");
-      xml.writeAttribute("T", QString::number(keithleyModel_->getTemperature(sensor), 'f', 4));
-      xml.writeEndElement();
+}
+
+void Thermo2DAQModel::fillKeithleyDAQ6510(Thermo2DAQRecord& record)
+{
+  for (unsigned int card=0;card<2;++card) {
+    for (unsigned int channel=0;channel<10;++channel) {
+      unsigned int sensor = (card+1)*100 + channel + 1;
+      record.keithleyState[card][channel] = keithleyModel_->getSensorState(sensor)==READY;
+      record.keithleyTemperature[card][channel] = keithleyModel_->getTemperature(sensor);
     }
   }
-  xml.writeEndElement();
-  //
-  // End of Keithley DAQ6510
-  //
+}
+
+void Thermo2DAQModel::createDAQStatusMessage(QString &buffer, bool start)
+{
+  QDateTime& utime = currentTime();
+
+  Thermo2DAQRecord record;
+  std::memset(&record, 0, sizeof(record));
+  record.version = Thermo2DAQRecordVersion;
+  record.time = utime.toMSecsSinceEpoch();
+
+  fillHuberUnistat525w(record);
+  fillAgilentTwisTorr304(record);
+  fillLeyboldGraphixOne(record);
+  fillRohdeSchwarzNGE103B(record);
+  fillKeithleyDAQ6510(record);
+
+  QXmlStreamWriter xml(&buffer);
+  xml.setAutoFormatting(true);
+
+  Thermo2DAQSchema::write(xml, record);
 
   if (start) {
     xml.writeStartElement("DAQStarted");
@@ -212,6 +201,13 @@ void Thermo2DAQModel::createDAQStatusMessage(QString &buffer, bool start)
   }
 }
 
+void Thermo2DAQModel::publishDAQRecord()
+{
+  if (!daqRing_->isValid()) return;
+
+  daqRing_->write(&record_);
+}
+
 void Thermo2DAQModel::stopMeasurement()
 {
   daqState_ = false;
@@ -237,7 +233,6 @@ void Thermo2DAQModel::customDAQMessage(const QString & message)
   emit daqMessage(message);
 }
 
-
 void Thermo2DAQModel::huberInfoChanged()
 {
   NQLogDebug("Thermo2DAQModel") << "huberInfoChanged()";
@@ -250,53 +245,23 @@ void Thermo2DAQModel::huberInfoChanged()
 
   QMutexLocker locker(&mutex_);
 
-  QDateTime& utime = currentTime();
+  Thermo2DAQRecord previous = record_;
+  record_.time = currentTime().toMSecsSinceEpoch();
+  fillHuberUnistat525w(record_);
 
   QString buffer;
 
-  bool changed = false;
-  changed |= updateIfChanged<bool>(u525wState_, huberModel_->getDeviceState()==READY ? true : false);
-  changed |= updateIfChanged<float>(u525wTemperatureSetPoint_, huberModel_->getTemperatureSetPoint());
-  changed |= updateIfChanged<bool>(u525wTemperatureControlMode_, huberModel_->getTemperatureControlMode());
-  changed |= updateIfChanged<bool>(u525wTemperatureControlEnabled_, huberModel_->getTemperatureControlEnabled());
-  changed |= updateIfChanged<bool>(u525wCirculatorEnabled_, huberModel_->getCirculatorEnabled());
-  changed |= updateIfChanged<float>(u525wBathTemperature_, huberModel_->getBathTemperature());
-  changed |= updateIfChanged<float>(u525wReturnTemperature_, huberModel_->getReturnTemperature());
-  changed |= updateIfChanged<float>(u525wPumpPressure_, huberModel_->getPumpPressure());
-  changed |= updateIfChanged<int>(u525wPower_, huberModel_->getPower());
-  changed |= updateIfChanged<float>(u525wCWInletTemperature_, huberModel_->getCoolingWaterInletTemperature());
-  changed |= updateIfChanged<float>(u525wCWOutletTemperature_, huberModel_->getCoolingWaterOutletTemperature());
-
-  if (changed) {
+  if (Thermo2DAQSchema::changed(Thermo2DAQSchema::HuberUnistat525w, record_, previous)) {
     QXmlStreamWriter xml(&buffer);
     xml.setAutoFormatting(true);
 
-    xml.writeStartElement("HuberUnistat525w");
-    xml.writeAttribute("time", utime.toString(Qt::ISODate));
-    xml.writeAttribute("State", QString::number(u525wState_));
-
-    xml.writeStartElement("HuberUnistat525wControl");
-    xml.writeAttribute("SetPoint", QString::number(u525wTemperatureSetPoint_, 'f', 2));
-    xml.writeAttribute("ControlMode", QString::number(u525wTemperatureControlMode_));
-    xml.writeAttribute("ControlEnabled", QString::number(u525wTemperatureControlEnabled_));
-    xml.writeAttribute("CirculatorEnabled", QString::number(u525wCirculatorEnabled_));
-    xml.writeEndElement();
-
-    xml.writeStartElement("HuberUnistat525wInfo");
-    xml.writeAttribute("Bath", QString::number(u525wBathTemperature_, 'f', 2));
-    xml.writeAttribute("Return", QString::number(u525wReturnTemperature_, 'f', 2));
-    xml.writeAttribute("Pressure", QString::number(u525wPumpPressure_, 'f', 3));
-    xml.writeAttribute("Power", QString::number(u525wPower_));
-    xml.writeAttribute("CWI", QString::number(u525wCWInletTemperature_, 'f', 2));
-    xml.writeAttribute("CWO", QString::number(u525wCWOutletTemperature_, 'f', 2));
-    xml.writeEndElement();
-
-    xml.writeEndElement();
+    Thermo2DAQSchema::write(xml, Thermo2DAQSchema::HuberUnistat525w, record_);
   }
 
   if (buffer.length()>0) {
     emit daqMessage(buffer);
     emit newDataAvailable();
+    publishDAQRecord();
   }
 }
 
@@ -312,33 +277,23 @@ void Thermo2DAQModel::agilentInfoChanged()
 
   QMutexLocker locker(&mutex_);
 
-  QDateTime& utime = currentTime();
+  Thermo2DAQRecord previous = record_;
+  record_.time = currentTime().toMSecsSinceEpoch();
+  fillAgilentTwisTorr304(record_);
 
   QString buffer;
 
-  bool changed = false;
-  changed |= updateIfChanged<bool>(agilentState_, agilentModel_->getDeviceState()==READY ? true : false);
-  changed |= updateIfChanged<bool>(agilentPumpState_, agilentModel_->getPumpState());
-  changed |= updateIfChanged<unsigned int>(agilentPumpStatus_, agilentModel_->getPumpStatus());
-  changed |= updateIfChanged<unsigned int>(agilentErrorCode_, agilentModel_->getErrorCode());
-
-  if (changed) {
+  if (Thermo2DAQSchema::changed(Thermo2DAQSchema::AgilentTwisTorr304, record_, previous)) {
     QXmlStreamWriter xml(&buffer);
     xml.setAutoFormatting(true);
 
-    xml.writeStartElement("AgilentTwisTorr304");
-    xml.writeAttribute("time", utime.toString(Qt::ISODate));
-    xml.writeAttribute("State", agilentState_==READY ? "1" : "0");
-    xml.writeAttribute("PumpState", agilentPumpState_==true ? "1" : "0");
-    xml.writeAttribute("PumpStatus", QString::number(agilentPumpStatus_));
-    xml.writeAttribute("ErrorCode", QString::number(agilentErrorCode_));
-
-    xml.writeEndElement();
+    Thermo2DAQSchema::write(xml, Thermo2DAQSchema::AgilentTwisTorr304, record_);
   }
 
   if (buffer.length()>0) {
     emit daqMessage(buffer);
     emit newDataAvailable();
+    publishDAQRecord();
   }
 }
 
@@ -354,30 +309,23 @@ void Thermo2DAQModel::leyboldInfoChanged()
 
   QMutexLocker locker(&mutex_);
 
-  QDateTime& utime = currentTime();
+  Thermo2DAQRecord previous = record_;
+  record_.time = currentTime().toMSecsSinceEpoch();
+  fillLeyboldGraphixOne(record_);
 
   QString buffer;
 
-  bool changed = false;
-  changed |= updateIfChanged<bool>(leyboldState_, leyboldModel_->getDeviceState()==READY ? true : false);
-  changed |= updateIfChanged<double>(leyboldPressure_, leyboldModel_->getPressure());
-
-  if (changed) {
+  if (Thermo2DAQSchema::changed(Thermo2DAQSchema::LeyboldGraphixOne, record_, previous)) {
     QXmlStreamWriter xml(&buffer);
     xml.setAutoFormatting(true);
 
-    xml.writeStartElement("LeyboldGraphixOne");
-    xml.writeAttribute("time", utime.toString(Qt::ISODate));
-    xml.writeAttribute("State", leyboldState_==READY ? "1" : "0");
-    xml.writeAttribute("Pressure", QString::number(leyboldPressure_, 'e', 3));
-    xml.writeEndElement();
-
-    xml.writeEndElement();
+    Thermo2DAQSchema::write(xml, Thermo2DAQSchema::LeyboldGraphixOne, record_);
   }
 
   if (buffer.length()>0) {
     emit daqMessage(buffer);
     emit newDataAvailable();
+    publishDAQRecord();
   }
 }
 
@@ -393,42 +341,21 @@ void Thermo2DAQModel::nge103BInfoChanged()
 
   QMutexLocker locker(&mutex_);
 
-  QDateTime& utime = currentTime();
+  Thermo2DAQRecord previous = record_;
+  record_.time = currentTime().toMSecsSinceEpoch();
+  fillRohdeSchwarzNGE103B(record_);
 
+  // only channels that have changed are written
   QString buffer;
   QXmlStreamWriter xml(&buffer);
   xml.setAutoFormatting(true);
 
-  xml.writeStartElement("RohdeSchwarzNGE103B");
-  xml.writeAttribute("time", utime.toString(Qt::ISODate));
-
-  for (int i=0;i<3;++i) {
-
-    bool changed = false;
-    changed |= updateIfChanged<bool>(nge103BOutputState_[i], nge103BModel_->getOutputState(i+1));
-    changed |= updateIfChanged<unsigned int>(nge103BOutputMode_[i], nge103BModel_->getOutputMode(i+1));
-    changed |= updateIfChanged<float>(nge103BVoltage_[i], nge103BModel_->getVoltage(i+1));
-    changed |= updateIfChanged<float>(nge103BCurrent_[i], nge103BModel_->getCurrent(i+1));
-    changed |= updateIfChanged<float>(nge103BMeasuredVoltage_[i], nge103BModel_->getMeasuredVoltage(i+1));
-    changed |= updateIfChanged<float>(nge103BMeasuredCurrent_[i], nge103BModel_->getMeasuredCurrent(i+1));
-
-    if (changed) {
-      xml.writeStartElement(QString("RohdeSchwarzNGE103BChannel"));
-      xml.writeAttribute("id", QString::number(i+1));
-      xml.writeAttribute("State", nge103BOutputState_[i]==true ? "1" : "0");
-      xml.writeAttribute("Mode", QString::number(nge103BOutputMode_[i]));
-      xml.writeAttribute("U", QString::number(nge103BVoltage_[i], 'f', 3));
-      xml.writeAttribute("mU", QString::number(nge103BMeasuredVoltage_[i], 'f', 3));
-      xml.writeAttribute("I", QString::number(nge103BCurrent_[i], 'f', 3));
-      xml.writeAttribute("mI", QString::number(nge103BMeasuredCurrent_[i], 'f', 3));
-      xml.writeEndElement();
-    }
-  }
-  xml.writeEndElement();
+  Thermo2DAQSchema::write(xml, Thermo2DAQSchema::RohdeSchwarzNGE103B, record_, &previous);
 
   if (buffer.length()>0) {
     emit daqMessage(buffer);
     emit newDataAvailable();
+    publishDAQRecord();
   }
 }
 
@@ -444,36 +371,20 @@ void Thermo2DAQModel::keithleyInfoChanged()
 
   QMutexLocker locker(&mutex_);
 
-  QDateTime& utime = currentTime();
+  Thermo2DAQRecord previous = record_;
+  record_.time = currentTime().toMSecsSinceEpoch();
+  fillKeithleyDAQ6510(record_);
 
+  // only sensors that have changed are written
   QString buffer;
   QXmlStreamWriter xml(&buffer);
   xml.setAutoFormatting(true);
 
-  xml.writeStartElement("KeithleyDAQ6510");
-  xml.writeAttribute("time", utime.toString(Qt::ISODate));
-
-  for (unsigned int card=0;card<2;++card) {
-    for (unsigned int channel=0;channel<10;++channel) {
-      unsigned int sensor = (card+1)*100 + channel + 1;
-
-      bool changed = false;
-      changed |= updateIfChanged<bool>(keithleyState_[card][channel], keithleyModel_->getSensorState(sensor)==READY ? "1" : "0");
-      changed |= updateIfChanged<float>(keithleyTemperature_[card][channel], keithleyModel_->getTemperature(sensor));
-
-      if (changed) {
-        xml.writeStartElement(QString("KeithleyDAQ6510Sensor"));
-        xml.writeAttribute("id", QString::number(sensor));
-        xml.writeAttribute("State", keithleyState_[card][channel]==true ? "1" : "0");
-        xml.writeAttribute("T", QString::number(keithleyTemperature_[card][channel], 'f', 4));
-        xml.writeEndElement();
-      }
-    }
-  }
-  xml.writeEndElement();
+  Thermo2DAQSchema::write(xml, Thermo2DAQSchema::KeithleyDAQ6510, record_, &previous);
 
   if (buffer.length()>0) {
     emit daqMessage(buffer);
     emit newDataAvailable();
+    publishDAQRecord();
   }
 }
@@ -28,6 +28,10 @@
 #include "RohdeSchwarzNGE103BModel.h"
 #include "KeithleyDAQ6510Model.h"
 
+#include "SharedMemoryRing.h"
+
+#include "Thermo2DAQRecord.h"
+
 class Thermo2DAQModel : public QObject
 {
   Q_OBJECT
@@ -39,6 +43,7 @@ public:
                            RohdeSchwarzNGE103BModel* nge103BModel,
                            KeithleyDAQ6510Model* keithleyModel,
                            QObject *parent = 0);
+  ~Thermo2DAQModel();
 
   QDateTime& currentTime();
 
@@ -78,46 +83,17 @@ protected:
 
   QDateTime currentTime_;
 
-  template <typename T> bool updateIfChanged(T &variable, T newValue) {
-    if (variable==newValue) return false;
-    variable = newValue;
-    return true;
-  }
-
-  // Huber Unistat 525w Data
-  bool u525wState_;
-  float u525wTemperatureSetPoint_;
-  bool u525wTemperatureControlMode_;
-  bool u525wTemperatureControlEnabled_;
-  bool u525wCirculatorEnabled_;
-  float u525wBathTemperature_;
-  float u525wReturnTemperature_;
-  float u525wPumpPressure_;
-  int u525wPower_;
-  float u525wCWInletTemperature_;
-  float u525wCWOutletTemperature_;
-
-  // Agilent TwisTorr 304 Data
-  bool agilentState_;
-  bool agilentPumpState_;
-  unsigned int agilentPumpStatus_;
-  unsigned int agilentErrorCode_;
-
-  // Leybold GraphixOne Data;
-  bool leyboldState_;
-  double leyboldPressure_;
-
-  // Rohde & Schwarz NGE130B Data
-  bool nge103BOutputState_[3];
-  unsigned int nge103BOutputMode_[3];
-  float nge103BVoltage_[3];
-  float nge103BCurrent_[3];
-  float nge103BMeasuredVoltage_[3];
-  float nge103BMeasuredCurrent_[3];
-
-  // Keithley DAQ6510 Data
-  std::array<std::array<bool,10>,2> keithleyState_;
-  std::array<std::array<float,10>,2> keithleyTemperature_;
+  SharedMemoryRing* daqRing_;
+  void publishDAQRecord();
+
+  void fillHuberUnistat525w(Thermo2DAQRecord& record);
+  void fillAgilentTwisTorr304(Thermo2DAQRecord& record);
+  void fillLeyboldGraphixOne(Thermo2DAQRecord& record);
+  void fillRohdeSchwarzNGE103B(Thermo2DAQRecord& record);
+  void fillKeithleyDAQ6510(Thermo2DAQRecord& record);
+
+  // last known state of all devices
+  Thermo2DAQRecord record_;
 
 signals:
 
@@ -0,0 +1,65 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THERMO2DAQRECORD_H
+#define THERMO2DAQRECORD_H
+
+#include <cstdint>
+
+/*
+  Fixed layout snapshot of all thermo2 DAQ values as published by
+  thermoDAQ2 through a SharedMemoryRing for local display clients.
+  Changing the layout requires bumping Thermo2DAQRecordVersion.
+*/
+
+static const char* const Thermo2DAQRecordName = "/cmstkmodlab_thermo2";
+static const uint32_t Thermo2DAQRecordVersion = 1;
+static const uint32_t Thermo2DAQRecordCapacity = 64;
+
+struct Thermo2DAQRecord
+{
+  uint32_t version;
+  uint32_t reserved;
+  int64_t  time; // ms since epoch
+
+  uint8_t  u525wState;
+  uint8_t  u525wTemperatureControlMode;
+  uint8_t  u525wTemperatureControlEnabled;
+  uint8_t  u525wCirculatorEnabled;
+  float    u525wTemperatureSetPoint;
+  float    u525wBathTemperature;
+  float    u525wReturnTemperature;
+  float    u525wPumpPressure;
+  int32_t  u525wPower;
+  float    u525wCWInletTemperature;
+  float    u525wCWOutletTemperature;
+
+  uint8_t  agilentState;
+  uint8_t  agilentPumpState;
+  uint32_t agilentErrorCode;
+  uint32_t agilentPumpStatus;
+
+  uint8_t  leyboldState;
+  double   leyboldPressure;
+
+  uint8_t  nge103BState[3];
+  uint32_t nge103BMode[3];
+  float    nge103BVoltage[3];
+  float    nge103BCurrent[3];
+  float    nge103BMeasuredVoltage[3];
+  float    nge103BMeasuredCurrent[3];
+
+  uint8_t  keithleyState[2][10];
+  float    keithleyTemperature[2][10];
+};
+
+#endif // THERMO2DAQRECORD_H
@@ -0,0 +1,413 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THERMO2DAQSCHEMA_H
+#define THERMO2DAQSCHEMA_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <QString>
+#include <QHash>
+#include <QDateTime>
+#include <QXmlStreamWriter>
+#include <QXmlStreamReader>
+
+#include "Thermo2DAQRecord.h"
+
+/*
+  Declarative description of the thermo2 DAQ data.
+
+  Every device is described once as an XML element with a list of fields.
+  A field maps an XML attribute and a ROOT branch name onto a member of
+  Thermo2DAQRecord. Elements with a channel count are written once per
+  channel and carry an "id" attribute.
+
+  From this single definition the templates below generate the XML writer
+  used by thermoDAQ2, the XML reader used by thermoDisplay2 and
+  thermoDAQ2Root and the ROOT branch layout. A new device channel only
+  needs a record member and a field entry here.
+*/
+namespace Thermo2DAQSchema
+{
+  typedef Thermo2DAQRecord Record;
+
+  template <typename M> struct Field
+  {
+    const char* attribute;
+    const char* branch;
+    M Record::* member;
+    char format;
+    int precision;
+  };
+
+  template <typename M>
+  constexpr Field<M> field(const char* attribute, const char* branch,
+                           M Record::* member, char format = 'd', int precision = 0)
+  {
+    return Field<M>{ attribute, branch, member, format, precision };
+  }
+
+  template <typename... F> struct Element
+  {
+    const char* name;
+    bool hasTime;
+    int count;
+    int (*id)(int index);
+    int (*index)(int id);
+    std::tuple<F...> fields;
+  };
+
+  template <typename... F>
+  constexpr Element<F...> element(const char* name, bool hasTime, F... fields)
+  {
+    return Element<F...>{ name, hasTime, 0, nullptr, nullptr, std::make_tuple(fields...) };
+  }
+
+  template <typename... F>
+  constexpr Element<F...> channels(const char* name, int count,
+                                   int (*id)(int), int (*index)(int),
+                                   F... fields)
+  {
+    return Element<F...>{ name, false, count, id, index, std::make_tuple(fields...) };
+  }
+
+  template <typename Parent, typename... Children> struct Device
+  {
+    Parent parent;
+    std::tuple<Children...> children;
+  };
+
+  template <typename Parent, typename... Children>
+  constexpr Device<Parent, Children...> device(Parent parent, Children... children)
+  {
+    return Device<Parent, Children...>{ parent, std::make_tuple(children...) };
+  }
+
+  // access to scalar, per channel and per card/channel record members
+
+  template <typename T>
+  T& value(Record& r, T Record::* m, int) { return r.*m; }
+  template <typename T>
+  const T& value(const Record& r, T Record::* m, int) { return r.*m; }
+
+  template <typename T, std::size_t N>
+  T& value(Record& r, T (Record::* m)[N], int idx) { return (r.*m)[idx]; }
+  template <typename T, std::size_t N>
+  const T& value(const Record& r, T (Record::* m)[N], int idx) { return (r.*m)[idx]; }
+
+  template <typename T, std::size_t N1, std::size_t N2>
+  T& value(Record& r, T (Record::* m)[N1][N2], int idx) { return (r.*m)[idx/N2][idx%N2]; }
+  template <typename T, std::size_t N1, std::size_t N2>
+  const T& value(const Record& r, T (Record::* m)[N1][N2], int idx) { return (r.*m)[idx/N2][idx%N2]; }
+
+  inline int channelId(int index) { return index + 1; }
+  inline int channelIndex(int id) { return id - 1; }
+
+  inline int sensorId(int index) { return (index/10 + 1)*100 + index%10 + 1; }
+  inline int sensorIndex(int id) { return (id/100 - 1)*10 + id%100 - 1; }
+
+  //
+  // the thermo2 DAQ data
+  //
+
+  constexpr auto HuberUnistat525w =
+    device(element("HuberUnistat525w", true,
+                   field("State", "u525wState", &Record::u525wState)),
+           element("HuberUnistat525wControl", false,
+                   field("SetPoint", "u525wTemperatureSetPoint", &Record::u525wTemperatureSetPoint, 'f', 2),
+                   field("ControlMode", "u525wTemperatureControlMode", &Record::u525wTemperatureControlMode),
+                   field("ControlEnabled", "u525wTemperatureControlEnabled", &Record::u525wTemperatureControlEnabled),
+                   field("CirculatorEnabled", "u525wCirculatorEnabled", &Record::u525wCirculatorEnabled)),
+           element("HuberUnistat525wInfo", false,
+                   field("Bath", "u525wBathTemperature", &Record::u525wBathTemperature, 'f', 2),
+                   field("Return", "u525wReturnTemperature", &Record::u525wReturnTemperature, 'f', 2),
+                   field("Pressure", "u525wPumpPressure", &Record::u525wPumpPressure, 'f', 3),
+                   field("Power", "u525wPower", &Record::u525wPower),
+                   field("CWI", "u525wCWInletTemperature", &Record::u525wCWInletTemperature, 'f', 2),
+                   field("CWO", "u525wCWOutletTemperature", &Record::u525wCWOutletTemperature, 'f', 2)));
+
+  constexpr auto AgilentTwisTorr304 =
+    device(element("AgilentTwisTorr304", true,
+                   field("State", "agilentState", &Record::agilentState),
+                   field("PumpState", "agilentPumpState", &Record::agilentPumpState),
+                   field("PumpStatus", "agilentPumpStatus", &Record::agilentPumpStatus),
+                   field("ErrorCode", "agilentErrorCode", &Record::agilentErrorCode)));
+
+  constexpr auto LeyboldGraphixOne =
+    device(element("LeyboldGraphixOne", true,
+                   field("State", "leyboldState", &Record::leyboldState),
+                   field("Pressure", "leyboldPressure", &Record::leyboldPressure, 'e', 3)));
+
+  constexpr auto RohdeSchwarzNGE103B =
+    device(element("RohdeSchwarzNGE103B", true),
+           channels("RohdeSchwarzNGE103BChannel", 3, channelId, channelIndex,
+                    field("State", "nge103BState", &Record::nge103BState),
+                    field("Mode", "nge103BMode", &Record::nge103BMode),
+                    field("U", "nge103BVoltageSet", &Record::nge103BVoltage, 'f', 3),
+                    field("mU", "nge103BVoltage", &Record::nge103BMeasuredVoltage, 'f', 3),
+                    field("I", "nge103BCurrentSet", &Record::nge103BCurrent, 'f', 3),
+                    field("mI", "nge103BCurrent", &Record::nge103BMeasuredCurrent, 'f', 3)));
+
+  constexpr auto KeithleyDAQ6510 =
+    device(element("KeithleyDAQ6510", true),
+           channels("KeithleyDAQ6510Sensor", 20, sensorId, sensorIndex,
+                    field("State", "keithleyState", &Record::keithleyState),
+                    field("T", "keithleyTemperature", &Record::keithleyTemperature, 'f', 4)));
+
+  constexpr auto Devices = std::make_tuple(HuberUnistat525w,
+                                           AgilentTwisTorr304,
+                                           LeyboldGraphixOne,
+                                           RohdeSchwarzNGE103B,
+                                           KeithleyDAQ6510);
+
+  //
+  // generic helpers
+  //
+
+  template <typename Tuple, typename Function>
+  void forEach(const Tuple& tuple, Function function)
+  {
+    std::apply([&](const auto&... item) { (function(item), ...); }, tuple);
+  }
+
+  template <typename E, typename Function>
+  void forEachInstance(const E& e, Function function)
+  {
+    if (e.count==0) {
+      function(0);
+    } else {
+      for (int idx=0;idx<e.count;++idx) function(idx);
+    }
+  }
+
+  template <typename D, typename Function>
+  void forEachElement(const D& d, Function function)
+  {
+    function(d.parent);
+    forEach(d.children, function);
+  }
+
+  template <typename T>
+  QString toString(const T& v, char format, int precision)
+  {
+    if (format=='d') return QString::number(v);
+    return QString::number(v, format, precision);
+  }
+
+  inline QString toString(const uint8_t& v, char, int)
+  {
+    return QString::number((unsigned int)v);
+  }
+
+  template <typename T, typename S>
+  void fromString(T& v, const S& s)
+  {
+    if constexpr (std::is_floating_point<T>::value) {
+      v = s.toDouble();
+    } else if constexpr (std::is_signed<T>::value) {
+      v = s.toInt();
+    } else {
+      v = s.toUInt();
+    }
+  }
+
+  template <typename T> constexpr char leafType();
+  template <> constexpr char leafType<float>() { return 'F'; }
+  template <> constexpr char leafType<double>() { return 'D'; }
+  template <> constexpr char leafType<int32_t>() { return 'I'; }
+  template <> constexpr char leafType<uint32_t>() { return 'i'; }
+  template <> constexpr char leafType<uint8_t>() { return 'b'; }
+
+  template <typename E>
+  bool changed(const E& e, const Record& r, const Record& previous, int idx)
+  {
+    bool result = false;
+    forEach(e.fields, [&](const auto& f) {
+        result |= value(r, f.member, idx)!=value(previous, f.member, idx);
+      });
+    return result;
+  }
+
+  template <typename D>
+  bool changed(const D& d, const Record& r, const Record& previous)
+  {
+    bool result = false;
+    forEachElement(d, [&](const auto& e) {
+        forEachInstance(e, [&](int idx) { result |= changed(e, r, previous, idx); });
+      });
+    return result;
+  }
+
+  //
+  // XML writer
+  //
+
+  template <typename E>
+  void writeAttributes(QXmlStreamWriter& xml, const E& e, const Record& r, int idx)
+  {
+    if (e.hasTime) {
+      xml.writeAttribute("time", QDateTime::fromMSecsSinceEpoch(r.time).toString(Qt::ISODate));
+    }
+    if (e.count>0) {
+      xml.writeAttribute("id", QString::number(e.id(idx)));
+    }
+    forEach(e.fields, [&](const auto& f) {
+        xml.writeAttribute(f.attribute, toString(value(r, f.member, idx), f.format, f.precision));
+      });
+  }
+
+  /**
+    Writes the device element and all its children. If previous is given,
+    channel elements are only written if one of their fields has changed.
+    */
+  template <typename D>
+  void write(QXmlStreamWriter& xml, const D& d, const Record& r, const Record* previous = nullptr)
+  {
+    xml.writeStartElement(d.parent.name);
+    writeAttributes(xml, d.parent, r, 0);
+
+    forEach(d.children, [&](const auto& e) {
+        forEachInstance(e, [&](int idx) {
+            if (previous && e.count>0 && !changed(e, r, *previous, idx)) return;
+            xml.writeStartElement(e.name);
+            writeAttributes(xml, e, r, idx);
+            xml.writeEndElement();
+          });
+      });
+
+    xml.writeEndElement();
+  }
+
+  inline void write(QXmlStreamWriter& xml, const Record& r)
+  {
+    forEach(Devices, [&](const auto& d) { write(xml, d, r); });
+  }
+
+  //
+  // XML reader
+  //
+
+  typedef decltype(std::declval<QXmlStreamAttribute>().value()) AttributeValue;
+
+  template <typename E, std::size_t I>
+  void storeField(const E& e, Record& r, int idx, const AttributeValue& v)
+  {
+    fromString(value(r, std::get<I>(e.fields).member, idx), v);
+  }
+
+  //! Stores v in the field with index field of the element through its member pointer.
+  template <typename E, std::size_t... I>
+  void readField(const E& e, int field, Record& r, int idx, const AttributeValue& v,
+                 std::index_sequence<I...>)
+  {
+    typedef void (*Reader)(const E&, Record&, int, const AttributeValue&);
+    static constexpr std::array<Reader, sizeof...(I)> readers = { &storeField<E, I>... };
+    readers[field](e, r, idx, v);
+  }
+
+  //! Maps the attribute names of the element to the index of their field.
+  template <typename E>
+  QHash<QString, int> fieldIndices(const E& e)
+  {
+    QHash<QString, int> indices;
+    int field = 0;
+    forEach(e.fields, [&](const auto& f) { indices.insert(QLatin1String(f.attribute), field++); });
+    return indices;
+  }
+
+  template <typename E>
+  void readAttributes(const QXmlStreamAttributes& attributes, const E& e,
+                      const QHash<QString, int>& indices, Record& r)
+  {
+    int idx = 0;
+    if (e.count>0) {
+      idx = e.index(attributes.value("id").toInt());
+      if (idx<0 || idx>=e.count) return;
+    }
+
+    for (const QXmlStreamAttribute& attribute : attributes) {
+      if (e.hasTime && attribute.name()==QLatin1String("time")) {
+        r.time = QDateTime::fromString(attribute.value().toString(), Qt::ISODate).toMSecsSinceEpoch();
+        continue;
+      }
+      auto it = indices.constFind(attribute.name().toString());
+      if (it==indices.constEnd()) continue;
+      readField(e, it.value(), r, idx, attribute.value(),
+                std::make_index_sequence<std::tuple_size<decltype(e.fields)>::value>());
+    }
+  }
+
+  /**
+    Updates the record from the current start element of xml. Returns
+    false if the element is not part of the schema. The element and
+    attribute names are looked up in tables built once from the schema.
+    */
+  inline bool read(QXmlStreamReader& xml, Record& r)
+  {
+    typedef std::function<void(const QXmlStreamAttributes&, Record&)> Reader;
+
+    static const QHash<QString, Reader> readers = [] {
+      QHash<QString, Reader> result;
+      forEach(Devices, [&](const auto& d) {
+          forEachElement(d, [&](const auto& e) {
+              result.insert(QLatin1String(e.name),
+                            [e, indices = fieldIndices(e)](const QXmlStreamAttributes& attributes, Record& r) {
+                              readAttributes(attributes, e, indices, r);
+                            });
+            });
+        });
+      return result;
+    }();
+
+    auto it = readers.constFind(xml.name().toString());
+    if (it==readers.constEnd()) return false;
+
+    it.value()(xml.attributes(), r);
+
+    return true;
+  }
+
+  //
+  // ROOT branch layout
+  //
+
+  /**
+    Creates one branch per field and channel in tree, pointing to the
+    corresponding member of r. Channel branches are suffixed with the
+    channel id, e.g. keithleyTemperature_101.
+    */
+  template <typename Tree>
+  void createBranches(Tree* tree, Record& r)
+  {
+    forEach(Devices, [&](const auto& d) {
+        forEachElement(d, [&](const auto& e) {
+            forEachInstance(e, [&](int idx) {
+                forEach(e.fields, [&](const auto& f) {
+                    auto& v = value(r, f.member, idx);
+                    std::string name = f.branch;
+                    if (e.count>0) name += "_" + std::to_string(e.id(idx));
+                    std::string leaf = name + "/" + leafType<std::remove_reference_t<decltype(v)>>();
+                    tree->Branch(name.c_str(), &v, leaf.c_str());
+                  });
+              });
+          });
+      });
+  }
+}
+
+#endif // THERMO2DAQSCHEMA_H
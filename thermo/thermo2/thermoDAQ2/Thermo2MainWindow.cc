@@ -83,6 +83,7 @@ Thermo2MainWindow::Thermo2MainWindow(QWidget *parent)
   keithleyModel_ = new KeithleyDAQ6510Model(config->getValue<std::string>("KeithleyDAQ6510").c_str(),
                                             30, this);
 #endif
+  keithleyModel_->setStreaming(config->getValue<int>("KeithleyDAQ6510Streaming", 0));
 
   daqModel_ = new Thermo2DAQModel(huberModel_,
                                   agilentModel_,
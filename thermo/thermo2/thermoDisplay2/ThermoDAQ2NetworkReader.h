@@ -20,31 +20,7 @@
 #include <QXmlStreamReader>
 #include <QDateTime>
 
-typedef struct {
-  QDateTime      dt;
-
-  bool           u525wState_;
-  float          u525wTemperatureSetPoint_;
-  bool           u525wTemperatureControlMode_;
-  bool           u525wTemperatureControlEnabled_;
-  bool           u525wCirculatorEnabled_;
-  float          u525wBathTemperature_;
-  float          u525wReturnTemperature_;
-  float          u525wPumpPressure_;
-  int            u525wPower_;
-  float          u525wCWInletTemperature_;
-  float          u525wCWOutletTemperature_;
-
-  bool           leyboldState_;
-  double         leyboldPressure_;
-
-  bool           nge103BState[3];
-  float          nge103BVoltage[3];
-  float          nge103BCurrent[3];
-
-  bool           keithleyState[2][10];
-  float          keithleyTemperature[2][10];
-} Measurement_t;
+#include "thermoDAQ2/Thermo2DAQRecord.h"
 
 class ThermoDAQ2NetworkReader : public QObject
 {
@@ -52,10 +28,11 @@ class ThermoDAQ2NetworkReader : public QObject
 public:
   explicit ThermoDAQ2NetworkReader(QObject* parent);
 
-  const Measurement_t& getMeasurement() const { return measurement_; }
+  const Thermo2DAQRecord& getRecord() const { return record_; }
 
 public slots:
   void run(QString& buffer);
+  void run(const Thermo2DAQRecord& record);
 
 signals:
   void finished();
@@ -64,19 +41,7 @@ signals:
   void process(QString& buffer);
   void processLine(QString& line);
 
-  void processHuberUnistat525w(QXmlStreamReader& xml);
-  void processHuberUnistat525wControl(QXmlStreamReader& xml);
-  void processHuberUnistat525wInfo(QXmlStreamReader& xml);
-
-  void processLeyboldGraphixOne(QXmlStreamReader& xml);
-
-  void processRohdeSchwarzNGE103B(QXmlStreamReader& xml);
-  void processRohdeSchwarzNGE103BChannel(QXmlStreamReader& xml);
-
-  void processKeithleyDAQ6510(QXmlStreamReader& xml);
-  void processKeithleyDAQ6510Sensor(QXmlStreamReader& xml);
-
-  Measurement_t measurement_;
+  Thermo2DAQRecord record_;
 };
 
 #endif // THERMODAQ2NETWORKREADER_H
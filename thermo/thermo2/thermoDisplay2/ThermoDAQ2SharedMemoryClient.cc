@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include <QMutexLocker>
+
+#include <nqlogger.h>
+
+#include "SharedMemoryRing.h"
+
+#include "ThermoDAQ2SharedMemoryClient.h"
+
+ThermoDAQ2SharedMemoryClient::ThermoDAQ2SharedMemoryClient(QObject *parent)
+  : QThread(parent),
+    attached_(false)
+{
+  std::memset(&record_, 0, sizeof(record_));
+}
+
+ThermoDAQ2SharedMemoryClient::~ThermoDAQ2SharedMemoryClient()
+{
+  requestInterruption();
+  wait();
+}
+
+Thermo2DAQRecord ThermoDAQ2SharedMemoryClient::latestRecord()
+{
+  QMutexLocker locker(&mutex_);
+  return record_;
+}
+
+void ThermoDAQ2SharedMemoryClient::run()
+{
+  Thermo2DAQRecord record;
+
+  while (!isInterruptionRequested()) {
+
+    SharedMemoryRing ring(Thermo2DAQRecordName,
+                          sizeof(Thermo2DAQRecord),
+                          Thermo2DAQRecordCapacity,
+                          SharedMemoryRing::Reader);
+
+    if (!ring.isValid()) {
+      if (attached_) {
+        NQLogMessage("ThermoDAQ2SharedMemoryClient") << "detached from " << ring.name();
+      }
+      attached_ = false;
+      msleep(2000);
+      continue;
+    }
+
+    if (!attached_) {
+      NQLogMessage("ThermoDAQ2SharedMemoryClient") << "attached to " << ring.name();
+    }
+
+    uint64_t cursor = ring.sequence();
+    if (ring.readLatest(&record) && record.version==Thermo2DAQRecordVersion) {
+      {
+        QMutexLocker locker(&mutex_);
+        record_ = record;
+      }
+      emit recordAvailable();
+    }
+
+    attached_ = true;
+
+    // a ring that stays silent for a while may belong to a writer that has
+    // gone away, in that case the segment is reopened
+    int idle = 0;
+    while (!isInterruptionRequested() && idle<10) {
+
+      if (!ring.wait(cursor, 1000)) {
+        idle++;
+        continue;
+      }
+      idle = 0;
+
+      // every record is a full snapshot, only the newest one is of interest
+      Thermo2DAQRecord next;
+      bool available = false;
+      while (ring.read(&next, cursor)) {
+        record = next;
+        available = true;
+      }
+
+      if (available && record.version==Thermo2DAQRecordVersion) {
+        {
+          QMutexLocker locker(&mutex_);
+          record_ = record;
+        }
+        emit recordAvailable();
+      }
+    }
+  }
+
+  attached_ = false;
+}
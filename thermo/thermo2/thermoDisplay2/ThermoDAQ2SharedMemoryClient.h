@@ -0,0 +1,55 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THERMODAQ2SHAREDMEMORYCLIENT_H
+#define THERMODAQ2SHAREDMEMORYCLIENT_H
+
+#include <atomic>
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+
+#include "thermoDAQ2/Thermo2DAQRecord.h"
+
+/*
+  Waits on the shared memory ring published by a thermoDAQ2 running on the
+  same host and signals every new record. While no ring is available
+  isAttached() returns false and the display keeps polling via TCP.
+*/
+class ThermoDAQ2SharedMemoryClient : public QThread
+{
+  Q_OBJECT
+public:
+
+  explicit ThermoDAQ2SharedMemoryClient(QObject *parent = 0);
+  ~ThermoDAQ2SharedMemoryClient();
+
+  bool isAttached() const { return attached_; }
+
+  Thermo2DAQRecord latestRecord();
+
+signals:
+
+  void recordAvailable();
+
+protected:
+
+  void run();
+
+  std::atomic<bool> attached_;
+
+  QMutex mutex_;
+  Thermo2DAQRecord record_;
+};
+
+#endif // THERMODAQ2SHAREDMEMORYCLIENT_H
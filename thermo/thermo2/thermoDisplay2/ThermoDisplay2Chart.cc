@@ -115,8 +115,29 @@ void ThermoDisplay2Chart::clearData()
   auto ss = series();
   for (QAbstractSeries *s : ss) {
     ThermoDisplay2LineSeries *ls = qobject_cast<ThermoDisplay2LineSeries*>(s);
-    ls->clear();
-    ls->resetInitialized();
+    if (ls) ls->clearData();
+  }
+}
+
+bool ThermoDisplay2Chart::isDirty() const
+{
+  auto ss = series();
+  for (QAbstractSeries *s : ss) {
+    ThermoDisplay2LineSeries *ls = qobject_cast<ThermoDisplay2LineSeries*>(s);
+    if (ls && ls->isDirty()) return true;
+  }
+  return false;
+}
+
+void ThermoDisplay2Chart::refreshSeriesPoints(const QDateTime& min, const QDateTime& max)
+{
+  int pixels = plotArea().width();
+  if (pixels<=0) pixels = 800;
+
+  auto ss = series();
+  for (QAbstractSeries *s : ss) {
+    ThermoDisplay2LineSeries *ls = qobject_cast<ThermoDisplay2LineSeries*>(s);
+    if (ls) ls->refreshPoints(min.toMSecsSinceEpoch(), max.toMSecsSinceEpoch(), pixels);
   }
 }
 
@@ -189,6 +210,7 @@ void ThermoDisplay2TemperatureChart::refreshAxes()
   dtMax = dtMax.addSecs(-temp+deltaX*60);
 
   axisX_->setRange(dtMin, dtMax);
+  refreshSeriesPoints(dtMin, dtMax);
 
   qreal deltaY = maxY-minY;
   if (deltaY<5.0) deltaY = 5.0;
@@ -282,6 +304,7 @@ void ThermoDisplay2TemperatureStateChart::refreshXAxis()
   dtMax = dtMax.addSecs(-temp+deltaX*60);
 
   axisX_->setRange(dtMin, dtMax);
+  refreshSeriesPoints(dtMin, dtMax);
 }
 
 void ThermoDisplay2TemperatureStateChart::refreshTemperatureAxis()
@@ -380,6 +403,7 @@ void ThermoDisplay2VoltageChart::refreshAxes()
   dtMax = dtMax.addSecs(-temp+deltaX*60);
 
   axisX_->setRange(dtMin, dtMax);
+  refreshSeriesPoints(dtMin, dtMax);
 
   qreal deltaY = maxY-minY;
   if (deltaY<5.0) deltaY = 5.0;
@@ -449,6 +473,7 @@ void ThermoDisplay2CurrentChart::refreshAxes()
   dtMax = dtMax.addSecs(-temp+deltaX*60);
 
   axisX_->setRange(dtMin, dtMax);
+  refreshSeriesPoints(dtMin, dtMax);
 
   qreal deltaY = maxY-minY;
   if (deltaY<5.0) deltaY = 5.0;
@@ -539,6 +564,7 @@ void ThermoDisplay2PowerPressureChart::refreshXAxis()
   dtMax = dtMax.addSecs(-temp+deltaX*60);
 
   axisX_->setRange(dtMin, dtMax);
+  refreshSeriesPoints(dtMin, dtMax);
 }
 
 void ThermoDisplay2PowerPressureChart::refreshPowerAxis()
@@ -670,6 +696,7 @@ void ThermoDisplay2PressureChart::refreshXAxis()
   dtMax = dtMax.addSecs(-temp+deltaX*60);
 
   axisX_->setRange(dtMin, dtMax);
+  refreshSeriesPoints(dtMin, dtMax);
 }
 
 void ThermoDisplay2PressureChart::refreshPressureAxis()
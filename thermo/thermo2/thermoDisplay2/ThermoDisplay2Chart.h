@@ -35,6 +35,8 @@ public:
 
   virtual void refreshAxes() = 0;
 
+  bool isDirty() const;
+
   void setTheme(QChart::ChartTheme theme);
 
 public slots:
@@ -43,6 +45,10 @@ public slots:
   void updateLegend();
   void handleMarkerClicked();
   void clearData();
+
+protected:
+
+  void refreshSeriesPoints(const QDateTime& min, const QDateTime& max);
 };
 
 class ThermoDisplay2TemperatureChart : public ThermoDisplay2Chart
@@ -42,8 +42,10 @@ ThermoDisplay2ChartView::ThermoDisplay2ChartView(ThermoDisplay2Chart *chart, QWi
   setMouseTracking(true);
 }
 
-void ThermoDisplay2ChartView::refreshAxes()
+void ThermoDisplay2ChartView::refreshAxes(bool force)
 {
+  if (!force && !chart_->isDirty()) return;
+
   if (callout_) callout_->hide();
   chart_->refreshAxes();
 }
@@ -32,7 +32,7 @@ public:
 
   explicit ThermoDisplay2ChartView(ThermoDisplay2Chart *chart, QWidget *parent = nullptr);
 
-  void refreshAxes();
+  void refreshAxes(bool force = false);
 
 public slots:
 
@@ -0,0 +1,201 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "ThermoDisplay2DataStore.h"
+
+ThermoDisplay2DataStore::ThermoDisplay2DataStore(int capacity, int levels, int factor)
+  : capacity_(std::max(capacity, 16)),
+    factor_(std::max(factor, 2))
+{
+  levels_.resize(std::max(levels, 1));
+  for (Level& level : levels_) {
+    level.buffer.resize(capacity_);
+    level.head = 0;
+    level.size = 0;
+    level.pendingCount = 0;
+    level.pendingSamples = 0;
+  }
+}
+
+void ThermoDisplay2DataStore::clear()
+{
+  for (Level& level : levels_) {
+    level.head = 0;
+    level.size = 0;
+    level.pendingCount = 0;
+    level.pendingSamples = 0;
+  }
+}
+
+void ThermoDisplay2DataStore::append(qreal x, qreal y)
+{
+  QPointF p(x, y);
+  Bucket b = { p, p, p, p };
+  push(0, b);
+
+  // every sample goes into the incomplete bucket of every level,
+  // so that the coarse levels do not lag behind the raw samples
+  for (int l=1;l<levels_.size();++l) {
+    Level& level = levels_[l];
+    if (level.pendingSamples==0) {
+      level.pending = b;
+    } else {
+      merge(level.pending, b);
+    }
+    level.pendingSamples++;
+  }
+
+  // a completed bucket counts towards the incomplete bucket of the next level
+  for (int l=1;l<levels_.size();++l) {
+    Level& level = levels_[l];
+    level.pendingCount++;
+    if (level.pendingCount<factor_) break;
+
+    push(l, level.pending);
+    level.pendingCount = 0;
+    level.pendingSamples = 0;
+  }
+}
+
+void ThermoDisplay2DataStore::push(int idx, const Bucket& bucket)
+{
+  Level& level = levels_[idx];
+
+  level.buffer[level.head] = bucket;
+  level.head++;
+  if (level.head>=capacity_) level.head = 0;
+  if (level.size<capacity_) level.size++;
+}
+
+void ThermoDisplay2DataStore::merge(Bucket& target, const Bucket& source)
+{
+  target.last = source.last;
+  if (source.min.y()<target.min.y()) target.min = source.min;
+  if (source.max.y()>target.max.y()) target.max = source.max;
+}
+
+const ThermoDisplay2DataStore::Bucket& ThermoDisplay2DataStore::at(const Level& level, int idx) const
+{
+  int i = level.head - level.size + idx;
+  if (i<0) i += capacity_;
+  return level.buffer[i];
+}
+
+int ThermoDisplay2DataStore::bucketCount(const Level& level) const
+{
+  return level.size + (level.pendingSamples>0 ? 1 : 0);
+}
+
+const ThermoDisplay2DataStore::Bucket& ThermoDisplay2DataStore::bucket(const Level& level, int idx) const
+{
+  if (idx<level.size) return at(level, idx);
+  return level.pending;
+}
+
+void ThermoDisplay2DataStore::appendPoints(QVector<QPointF>& points, const Bucket& b)
+{
+  QPointF p[4] = { b.first, b.min, b.max, b.last };
+  if (p[2].x()<p[1].x()) std::swap(p[1], p[2]);
+
+  for (int i=0;i<4;++i) {
+    if (!points.isEmpty() && points.last()==p[i]) continue;
+    points.append(p[i]);
+  }
+}
+
+QVector<QPointF> ThermoDisplay2DataStore::decimated(qreal minX, qreal maxX, int pixels) const
+{
+  QVector<QPointF> points;
+
+  if (isEmpty() || pixels<=0 || maxX<=minX) return points;
+
+  // Pick the finest level that still reaches back to minX and does not
+  // hand out more than four buckets per pixel. If no level reaches back
+  // far enough the coarsest populated level holds the oldest data.
+  int selected = 0;
+  int lo = 0, hi = 0;
+  for (int l=0;l<levels_.size();++l) {
+    const Level& level = levels_[l];
+    int n = bucketCount(level);
+    if (n==0) break;
+
+    selected = l;
+
+    lo = 0;
+    hi = n;
+    {
+      int first = 0, count = n;
+      while (count>0) {
+        int step = count/2;
+        if (bucket(level, first+step).last.x()<minX) {
+          first += step + 1;
+          count -= step + 1;
+        } else {
+          count = step;
+        }
+      }
+      lo = first;
+    }
+    {
+      int first = lo, count = n - lo;
+      while (count>0) {
+        int step = count/2;
+        if (bucket(level, first+step).first.x()<=maxX) {
+          first += step + 1;
+          count -= step + 1;
+        } else {
+          count = step;
+        }
+      }
+      hi = first;
+    }
+
+    if (bucket(level, 0).first.x()>minX) continue;
+    if (hi-lo<=4*pixels) break;
+  }
+
+  const Level& level = levels_[selected];
+  int n = bucketCount(level);
+
+  // keep one bucket on either side so that the lines reach the plot edges
+  lo = std::max(lo-1, 0);
+  hi = std::min(hi+1, n);
+
+  points.reserve(std::min(4*(hi-lo), 4*(pixels+2)));
+
+  const qreal width = (maxX-minX) / pixels;
+
+  Bucket column;
+  int currentColumn = 0;
+  bool hasColumn = false;
+
+  for (int i=lo;i<hi;++i) {
+    const Bucket& b = bucket(level, i);
+
+    int c = (b.first.x()-minX) / width;
+    c = std::min(std::max(c, -1), pixels);
+
+    if (hasColumn && c==currentColumn) {
+      merge(column, b);
+    } else {
+      if (hasColumn) appendPoints(points, column);
+      column = b;
+      currentColumn = c;
+      hasColumn = true;
+    }
+  }
+  if (hasColumn) appendPoints(points, column);
+
+  return points;
+}
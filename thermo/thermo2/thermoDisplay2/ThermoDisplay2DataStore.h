@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THERMODISPLAY2DATASTORE_H
+#define THERMODISPLAY2DATASTORE_H
+
+#include <QVector>
+#include <QPointF>
+
+/*
+  Multi-resolution time series store for the ThermoDisplay2 charts.
+
+  Level 0 holds the raw samples, every further level aggregates factor_
+  buckets of the level below into one bucket that keeps the first, last,
+  minimum and maximum sample (M4 aggregation). Each level is a ring buffer
+  of fixed capacity, so the memory footprint is bounded by
+  levels*capacity*sizeof(Bucket) independent of the run time. Old data
+  drops out of the fine levels first and is still available at a coarser
+  resolution. The newest, incomplete bucket of every level already
+  contains all samples appended so far, so each level reaches up to the
+  latest sample.
+
+  decimated() returns at most four points per horizontal pixel for the
+  requested x range, which renders identical to the full data set.
+*/
+class ThermoDisplay2DataStore
+{
+public:
+
+  explicit ThermoDisplay2DataStore(int capacity = 2048,
+                                   int levels = 8,
+                                   int factor = 4);
+
+  void append(qreal x, qreal y);
+  void clear();
+
+  bool isEmpty() const { return levels_[0].size==0; }
+
+  QVector<QPointF> decimated(qreal minX, qreal maxX, int pixels) const;
+
+protected:
+
+  struct Bucket {
+    QPointF first;
+    QPointF last;
+    QPointF min;
+    QPointF max;
+  };
+
+  struct Level {
+    QVector<Bucket> buffer;
+    int head;
+    int size;
+    Bucket pending;
+    int pendingCount;
+    int pendingSamples;
+  };
+
+  void push(int level, const Bucket& bucket);
+  static void merge(Bucket& target, const Bucket& source);
+  static void appendPoints(QVector<QPointF>& points, const Bucket& bucket);
+
+  const Bucket& at(const Level& level, int idx) const;
+  int bucketCount(const Level& level) const;
+  const Bucket& bucket(const Level& level, int idx) const;
+
+  int capacity_;
+  int factor_;
+  QVector<Level> levels_;
+};
+
+#endif // THERMODISPLAY2DATASTORE_H
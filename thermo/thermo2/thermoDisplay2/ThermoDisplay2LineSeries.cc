@@ -17,6 +17,8 @@
 
 #include <nqlogger.h>
 
+#include "ApplicationConfig.h"
+
 #include "ThermoDisplay2LineSeries.h"
 
 ThermoDisplay2LineSeries::ThermoDisplay2LineSeries()
@@ -25,7 +27,11 @@ ThermoDisplay2LineSeries::ThermoDisplay2LineSeries()
     enabled_(false),
     minX_(0), maxX_(0),
     minY_(0), maxY_(0),
-    lastX_(0), lastY_(0)
+    lastX_(0), lastY_(0),
+    store_(ApplicationConfig::instance()->getValue<int>("DisplayBufferSize", 2048)),
+    dirty_(false),
+    pointsMinX_(0), pointsMaxX_(0),
+    pointsPixels_(0)
 {
 
 }
@@ -33,8 +39,7 @@ ThermoDisplay2LineSeries::ThermoDisplay2LineSeries()
 void ThermoDisplay2LineSeries::setEnabled(bool enabled)
 {
   if (enabled_ && !enabled) {
-    clear();
-    resetInitialized();
+    clearData();
   }
 
   enabled_ = enabled;
@@ -63,5 +68,32 @@ void ThermoDisplay2LineSeries::append(qreal x, qreal y)
   lastX_ = x;
   lastY_ = y;
 
-  QLineSeries::append(x, y);
+  store_.append(x, y);
+  dirty_ = true;
+}
+
+void ThermoDisplay2LineSeries::clearData()
+{
+  store_.clear();
+  clear();
+  resetInitialized();
+
+  // the axes have to be refreshed for the empty series
+  dirty_ = true;
+}
+
+void ThermoDisplay2LineSeries::refreshPoints(qreal minX, qreal maxX, int pixels)
+{
+  if (!enabled_) return;
+
+  if (!dirty_ &&
+      minX==pointsMinX_ && maxX==pointsMaxX_ &&
+      pixels==pointsPixels_) return;
+
+  replace(store_.decimated(minX, maxX, pixels));
+
+  pointsMinX_ = minX;
+  pointsMaxX_ = maxX;
+  pointsPixels_ = pixels;
+  dirty_ = false;
 }
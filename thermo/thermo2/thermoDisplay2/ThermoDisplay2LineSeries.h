@@ -19,6 +19,8 @@
 #include <QtCharts/QDateTimeAxis>
 #include <QtCharts/QValueAxis>
 
+#include "ThermoDisplay2DataStore.h"
+
 QT_CHARTS_USE_NAMESPACE
 
 class ThermoDisplay2LineSeries : public QLineSeries
@@ -32,9 +34,13 @@ public:
   void resetInitialized() { initialized_ = false; }
 
   bool isEnabled() const { return enabled_; }
+  bool isDirty() const { return dirty_; }
   void setEnabled(bool enabled);
 
   void append(qreal x, qreal y);
+  void clearData();
+
+  void refreshPoints(qreal minX, qreal maxX, int pixels);
 
   qreal minX() { return minX_; }
   qreal maxX() { return maxX_; }
@@ -52,6 +58,11 @@ protected:
   qreal minX_, maxX_;
   qreal minY_, maxY_;
   qreal lastX_, lastY_;
+
+  ThermoDisplay2DataStore store_;
+  bool dirty_;
+  qreal pointsMinX_, pointsMaxX_;
+  int pointsPixels_;
 };
 
 #endif // THERMODISPLAY2LINESERIES_H
@@ -14,6 +14,7 @@
 #include <string>
 
 #include <QApplication>
+#include <QScreen>
 #include <QGroupBox>
 #include <QToolBar>
 #include <QToolButton>
@@ -41,11 +42,15 @@ ThermoDisplay2MainWindow::ThermoDisplay2MainWindow(QWidget *parent)
   connect(btnClear, SIGNAL(clicked()), this, SLOT(clearData()));
   toolBar->addWidget(btnClear);
 
-  QToolButton * btnSavePlots = new QToolButton(toolBar);
-  btnSavePlots->setText("Save Plots");
-  btnSavePlots->setToolButtonStyle( Qt::ToolButtonTextUnderIcon );
-  connect(btnSavePlots, SIGNAL(clicked()), this, SLOT(savePlots()));
-  toolBar->addWidget(btnSavePlots);
+  btnSavePlots_ = new QToolButton(toolBar);
+  btnSavePlots_->setText("Save Plots");
+  btnSavePlots_->setToolButtonStyle( Qt::ToolButtonTextUnderIcon );
+  connect(btnSavePlots_, SIGNAL(clicked()), this, SLOT(savePlots()));
+  toolBar->addWidget(btnSavePlots_);
+
+  exporter_ = new ThermoDisplay2PlotExporter(this);
+  connect(exporter_, SIGNAL(finished(int,int)),
+          this, SLOT(plotsSaved(int,int)));
 
   addToolBar(toolBar);
 
@@ -204,6 +209,13 @@ ThermoDisplay2MainWindow::ThermoDisplay2MainWindow(QWidget *parent)
   QObject::connect(reader_, SIGNAL(finished()),
                    this, SLOT(updateInfo()));
 
+  // a thermoDAQ2 on the same host publishes its data via shared memory,
+  // the TCP client is only used while no shared memory ring is attached
+  shmClient_ = new ThermoDAQ2SharedMemoryClient(this);
+  QObject::connect(shmClient_, SIGNAL(recordAvailable()),
+                   this, SLOT(readRecord()));
+  shmClient_->start();
+
   setCentralWidget(tabWidget_);
 
   /*
@@ -218,6 +230,20 @@ ThermoDisplay2MainWindow::ThermoDisplay2MainWindow(QWidget *parent)
   }
   */
 
+  // chart updates of one network tick are coalesced and applied at most
+  // once per display frame
+  qreal refreshRate = QGuiApplication::primaryScreen()->refreshRate();
+  if (refreshRate<=0) refreshRate = 60;
+
+  refreshTimer_ = new QTimer(this);
+  refreshTimer_->setSingleShot(true);
+  refreshTimer_->setInterval(1000./refreshRate);
+  connect(refreshTimer_, SIGNAL(timeout()),
+          this, SLOT(refreshCharts()));
+
+  connect(tabWidget_, SIGNAL(currentChanged(int)),
+          this, SLOT(refreshCharts()));
+
   requestData();
 
   timer_ = new QTimer(this);
@@ -252,6 +278,8 @@ void ThermoDisplay2MainWindow::savePlots()
 
   if (dir.isEmpty()) return;
 
+  if (exporter_->isBusy()) return;
+
   int currentTab = tabWidget_->currentIndex();
   for (int idx=0;idx<4;++idx) {
     if (idx!=currentTab) tabWidget_->setCurrentIndex(idx);
@@ -261,157 +289,79 @@ void ThermoDisplay2MainWindow::savePlots()
   config->setValue("PlotSaveDirectory", dir);
   config->safe(std::string(Config::CMSTkModLabBasePath) + "/thermo/thermo2/thermo2.cfg");
 
-  QApplication::processEvents();
-
-  {
-    auto dpr = 2.0*ChillerTSChartView_->devicePixelRatioF();
-    QPixmap buffer(ChillerTSChartView_->width() * dpr,
-                   ChillerTSChartView_->height() * dpr);
-    buffer.fill(Qt::transparent);
-
-    QPainter *painter = new QPainter(&buffer);
-    painter->setPen(*(new QColor(255,34,255,255)));
-    ChillerTSChartView_->render(painter);
-
-    QFile file(dir + "/" + dt.toString("yyyy-MM-dd-hh-mm-ss") + "_thermo2_chillerTS.png");
-    file.open(QIODevice::WriteOnly);
-    buffer.save(&file, "PNG");
-  }
-
-  QApplication::processEvents();
-
-  {
-    auto dpr = 2.0*ChillerPPChartView_->devicePixelRatioF();
-    QPixmap buffer(ChillerPPChartView_->width() * dpr,
-                   ChillerPPChartView_->height() * dpr);
-    buffer.fill(Qt::transparent);
-
-    QPainter *painter = new QPainter(&buffer);
-    painter->setPen(*(new QColor(255,34,255,255)));
-    ChillerPPChartView_->render(painter);
-
-    QFile file(dir + "/" + dt.toString("yyyy-MM-dd-hh-mm-ss") + "_thermo2_chillerPP.png");
-    file.open(QIODevice::WriteOnly);
-    buffer.save(&file, "PNG");
-  }
-
-  QApplication::processEvents();
-
-  {
-    auto dpr = 2.0*VacuumChartView_->devicePixelRatioF();
-    QPixmap buffer(VacuumChartView_->width() * dpr,
-                   VacuumChartView_->height() * dpr);
-    buffer.fill(Qt::transparent);
-
-    QPainter *painter = new QPainter(&buffer);
-    VacuumChartView_->render(painter);
-
-    QFile file(dir + "/" + dt.toString("yyyy-MM-dd-hh-mm-ss") + "_thermo2_vacuum.png");
-    file.open(QIODevice::WriteOnly);
-    buffer.save(&file, "PNG");
-  }
-
-  QApplication::processEvents();
-
-  {
-    auto dpr = 2.0*UChartView_->devicePixelRatioF();
-    QPixmap buffer(UChartView_->width() * dpr,
-                   UChartView_->height() * dpr);
-    buffer.fill(Qt::transparent);
-
-    QPainter *painter = new QPainter(&buffer);
-    painter->setPen(*(new QColor(255,34,255,255)));
-    UChartView_->render(painter);
-
-    QFile file(dir + "/" + dt.toString("yyyy-MM-dd-hh-mm-ss") + "_thermo2_voltage.png");
-    file.open(QIODevice::WriteOnly);
-    buffer.save(&file, "PNG");
-  }
+  ChillerTSChartView_->refreshAxes();
+  ChillerPPChartView_->refreshAxes();
+  VacuumChartView_->refreshAxes();
+  UChartView_->refreshAxes();
+  IChartView_->refreshAxes();
+  TChartView_[0]->refreshAxes();
+  TChartView_[1]->refreshAxes();
 
   QApplication::processEvents();
 
-  {
-    auto dpr = 2.0*IChartView_->devicePixelRatioF();
-    QPixmap buffer(IChartView_->width() * dpr,
-                   IChartView_->height() * dpr);
-    buffer.fill(Qt::transparent);
-
-    QPainter *painter = new QPainter(&buffer);
-    painter->setPen(*(new QColor(255,34,255,255)));
-    IChartView_->render(painter);
-
-    QFile file(dir + "/" + dt.toString("yyyy-MM-dd-hh-mm-ss") + "_thermo2_current.png");
-    file.open(QIODevice::WriteOnly);
-    buffer.save(&file, "PNG");
-  }
+  QString prefix = dir + "/" + dt.toString("yyyy-MM-dd-hh-mm-ss") + "_thermo2_";
 
-  QApplication::processEvents();
+  exporter_->addChart(ChillerTSChartView_, prefix + "chillerTS.png");
+  exporter_->addChart(ChillerPPChartView_, prefix + "chillerPP.png");
+  exporter_->addChart(VacuumChartView_, prefix + "vacuum.png");
+  exporter_->addChart(UChartView_, prefix + "voltage.png");
+  exporter_->addChart(IChartView_, prefix + "current.png");
+  exporter_->addChart(TChartView_[0], prefix + "temperatures1.png");
+  exporter_->addChart(TChartView_[1], prefix + "temperatures2.png");
 
-  {
-    auto dpr = 2.0*TChartView_[0]->devicePixelRatioF();
-    QPixmap buffer(TChartView_[0]->width() * dpr,
-                   TChartView_[0]->height() * dpr);
-    buffer.fill(Qt::transparent);
-
-    QPainter *painter = new QPainter(&buffer);
-    painter->setPen(*(new QColor(255,34,255,255)));
-    TChartView_[0]->render(painter);
-
-    QFile file(dir + "/" + dt.toString("yyyy-MM-dd-hh-mm-ss") + "_thermo2_temperatures1.png");
-    file.open(QIODevice::WriteOnly);
-    buffer.save(&file, "PNG");
-  }
+  btnSavePlots_->setEnabled(false);
+  exporter_->start();
+}
 
-  QApplication::processEvents();
+void ThermoDisplay2MainWindow::plotsSaved(int saved, int failed)
+{
+  NQLogMessage("ThermoDisplay2MainWindow") << "plotsSaved(" << saved << ", " << failed << ")";
 
-  {
-    auto dpr = 2.0*TChartView_[1]->devicePixelRatioF();
-    QPixmap buffer(TChartView_[1]->width() * dpr,
-                   TChartView_[1]->height() * dpr);
-    buffer.fill(Qt::transparent);
-
-    QPainter *painter = new QPainter(&buffer);
-    painter->setPen(*(new QColor(255,34,255,255)));
-    TChartView_[1]->render(painter);
-
-    QFile file(dir + "/" + dt.toString("yyyy-MM-dd-hh-mm-ss") + "_thermo2_temperatures2.png");
-    file.open(QIODevice::WriteOnly);
-    buffer.save(&file, "PNG");
-  }
+  btnSavePlots_->setEnabled(true);
 }
 
 void ThermoDisplay2MainWindow::requestData()
 {
   NQLogDebug("ThermoDisplay2MainWindow") << "requestData()";
+
+  if (shmClient_->isAttached()) return;
+
   client_->readDAQStatus();
 }
 
+void ThermoDisplay2MainWindow::readRecord()
+{
+  NQLogDebug("ThermoDisplay2MainWindow") << "readRecord()";
+
+  reader_->run(shmClient_->latestRecord());
+}
+
 void ThermoDisplay2MainWindow::updateInfo()
 {
   NQLogDebug("ThermoDisplay2MainWindow") << "updateInfo()";
 
-  const Measurement_t& m = reader_->getMeasurement();
+  const Thermo2DAQRecord& m = reader_->getRecord();
 
   {
     bool updateLegend = false;
 
-    if (ChillerTBathSeries_->isEnabled()!=m.u525wState_) updateLegend = true;
-    ChillerTBathSeries_->setEnabled(m.u525wState_);
-    ChillerTReturnSeries_->setEnabled(m.u525wState_);
-    ChillerTCWISeries_->setEnabled(m.u525wState_);
-    ChillerTCWOSeries_->setEnabled(m.u525wState_);
-    ChillerPowerSeries_->setEnabled(m.u525wState_);
-    ChillerPressureSeries_->setEnabled(m.u525wState_);
-    ChillerSTCSeries_->setEnabled(m.u525wState_);
-    ChillerSCSeries_->setEnabled(m.u525wState_);
-    ChillerTBathSeries_->append(m.dt.toMSecsSinceEpoch(), m.u525wBathTemperature_);
-    ChillerTReturnSeries_->append(m.dt.toMSecsSinceEpoch(), m.u525wReturnTemperature_);
-    ChillerTCWISeries_->append(m.dt.toMSecsSinceEpoch(), m.u525wCWInletTemperature_);
-    ChillerTCWOSeries_->append(m.dt.toMSecsSinceEpoch(), m.u525wCWOutletTemperature_);
-    ChillerPowerSeries_->append(m.dt.toMSecsSinceEpoch(), m.u525wPower_/1000.);
-    ChillerPressureSeries_->append(m.dt.toMSecsSinceEpoch(), m.u525wPumpPressure_);
-    ChillerSTCSeries_->append(m.dt.toMSecsSinceEpoch(), m.u525wTemperatureControlEnabled_);
-    ChillerSCSeries_->append(m.dt.toMSecsSinceEpoch(), m.u525wCirculatorEnabled_);
+    if (ChillerTBathSeries_->isEnabled()!=(bool)m.u525wState) updateLegend = true;
+    ChillerTBathSeries_->setEnabled(m.u525wState);
+    ChillerTReturnSeries_->setEnabled(m.u525wState);
+    ChillerTCWISeries_->setEnabled(m.u525wState);
+    ChillerTCWOSeries_->setEnabled(m.u525wState);
+    ChillerPowerSeries_->setEnabled(m.u525wState);
+    ChillerPressureSeries_->setEnabled(m.u525wState);
+    ChillerSTCSeries_->setEnabled(m.u525wState);
+    ChillerSCSeries_->setEnabled(m.u525wState);
+    ChillerTBathSeries_->append(m.time, m.u525wBathTemperature);
+    ChillerTReturnSeries_->append(m.time, m.u525wReturnTemperature);
+    ChillerTCWISeries_->append(m.time, m.u525wCWInletTemperature);
+    ChillerTCWOSeries_->append(m.time, m.u525wCWOutletTemperature);
+    ChillerPowerSeries_->append(m.time, m.u525wPower/1000.);
+    ChillerPressureSeries_->append(m.time, m.u525wPumpPressure);
+    ChillerSTCSeries_->append(m.time, m.u525wTemperatureControlEnabled);
+    ChillerSCSeries_->append(m.time, m.u525wCirculatorEnabled);
 
     if (updateLegend) {
       ChillerTSChart_->updateLegend();
@@ -422,12 +372,12 @@ void ThermoDisplay2MainWindow::updateInfo()
   {
     bool updateLegend = false;
 
-    NQLogDebug("ThermoDisplay2MainWindow") << "updateInfo() " << m.leyboldState_;
-    NQLogDebug("ThermoDisplay2MainWindow") << "updateInfo() " << m.leyboldPressure_;
+    NQLogDebug("ThermoDisplay2MainWindow") << "updateInfo() " << (int)m.leyboldState;
+    NQLogDebug("ThermoDisplay2MainWindow") << "updateInfo() " << m.leyboldPressure;
 
-    if (VacuumPressureSeries_->isEnabled()!=m.leyboldState_) updateLegend = true;
-    VacuumPressureSeries_->setEnabled(m.leyboldState_);
-    VacuumPressureSeries_->append(m.dt.toMSecsSinceEpoch(), m.leyboldPressure_);
+    if (VacuumPressureSeries_->isEnabled()!=(bool)m.leyboldState) updateLegend = true;
+    VacuumPressureSeries_->setEnabled(m.leyboldState);
+    VacuumPressureSeries_->append(m.time, m.leyboldPressure);
 
     if (updateLegend) {
       VacuumPressureChart_->updateLegend();
@@ -437,23 +387,23 @@ void ThermoDisplay2MainWindow::updateInfo()
   {
     bool updateLegend = false;
 
-    if (U1Series_->isEnabled()!=m.nge103BState[0]) updateLegend = true;
+    if (U1Series_->isEnabled()!=(bool)m.nge103BState[0]) updateLegend = true;
     U1Series_->setEnabled(m.nge103BState[0]);
     I1Series_->setEnabled(m.nge103BState[0]);
-    U1Series_->append(m.dt.toMSecsSinceEpoch(), m.nge103BVoltage[0]);
-    I1Series_->append(m.dt.toMSecsSinceEpoch(), m.nge103BCurrent[0]);
+    U1Series_->append(m.time, m.nge103BMeasuredVoltage[0]);
+    I1Series_->append(m.time, m.nge103BMeasuredCurrent[0]);
 
-    if (U2Series_->isEnabled()!=m.nge103BState[1]) updateLegend = true;
+    if (U2Series_->isEnabled()!=(bool)m.nge103BState[1]) updateLegend = true;
     U2Series_->setEnabled(m.nge103BState[1]);
     I2Series_->setEnabled(m.nge103BState[1]);
-    U2Series_->append(m.dt.toMSecsSinceEpoch(), m.nge103BVoltage[1]);
-    I2Series_->append(m.dt.toMSecsSinceEpoch(), m.nge103BCurrent[1]);
+    U2Series_->append(m.time, m.nge103BMeasuredVoltage[1]);
+    I2Series_->append(m.time, m.nge103BMeasuredCurrent[1]);
 
-    if (U3Series_->isEnabled()!=m.nge103BState[2]) updateLegend = true;
+    if (U3Series_->isEnabled()!=(bool)m.nge103BState[2]) updateLegend = true;
     U3Series_->setEnabled(m.nge103BState[2]);
     I3Series_->setEnabled(m.nge103BState[2]);
-    U3Series_->append(m.dt.toMSecsSinceEpoch(), m.nge103BVoltage[2]);
-    I3Series_->append(m.dt.toMSecsSinceEpoch(), m.nge103BCurrent[2]);
+    U3Series_->append(m.time, m.nge103BMeasuredVoltage[2]);
+    I3Series_->append(m.time, m.nge103BMeasuredCurrent[2]);
 
     if (updateLegend) {
       UChart_->updateLegend();
@@ -465,19 +415,27 @@ void ThermoDisplay2MainWindow::updateInfo()
     for (unsigned int card = 0;card<2;++card) {
       bool updateLegend = false;
       for (unsigned int channel = 0;channel<10;++channel) {
-        if (TSeries_[card][channel]->isEnabled()!=m.keithleyState[card][channel]) updateLegend = true;
+        if (TSeries_[card][channel]->isEnabled()!=(bool)m.keithleyState[card][channel]) updateLegend = true;
         TSeries_[card][channel]->setEnabled(m.keithleyState[card][channel]);
-        TSeries_[card][channel]->append(m.dt.toMSecsSinceEpoch(), m.keithleyTemperature[card][channel]);
+        TSeries_[card][channel]->append(m.time, m.keithleyTemperature[card][channel]);
       }
       if (updateLegend) TChart_[card]->updateLegend();
     }
   }
 
-  ChillerTSChartView_->refreshAxes();
-  ChillerPPChartView_->refreshAxes();
-  VacuumChartView_->refreshAxes();
-  UChartView_->refreshAxes();
-  IChartView_->refreshAxes();
-  TChartView_[0]->refreshAxes();
-  TChartView_[1]->refreshAxes();
+  if (!refreshTimer_->isActive()) refreshTimer_->start();
+}
+
+void ThermoDisplay2MainWindow::refreshCharts()
+{
+  NQLogDebug("ThermoDisplay2MainWindow") << "refreshCharts()";
+
+  // charts on hidden tabs are refreshed when their tab is selected
+  if (ChillerTSChartView_->isVisible()) ChillerTSChartView_->refreshAxes();
+  if (ChillerPPChartView_->isVisible()) ChillerPPChartView_->refreshAxes();
+  if (VacuumChartView_->isVisible()) VacuumChartView_->refreshAxes();
+  if (UChartView_->isVisible()) UChartView_->refreshAxes();
+  if (IChartView_->isVisible()) IChartView_->refreshAxes();
+  if (TChartView_[0]->isVisible()) TChartView_[0]->refreshAxes();
+  if (TChartView_[1]->isVisible()) TChartView_[1]->refreshAxes();
 }
@@ -17,6 +17,7 @@
 #include <QTimer>
 #include <QVector>
 #include <QTabWidget>
+#include <QToolButton>
 
 #include <QtCharts/QChartView>
 #include <QtCharts/QChart>
@@ -24,10 +25,12 @@
 
 #include "ThermoDAQ2Client.h"
 #include "ThermoDAQ2NetworkReader.h"
+#include "ThermoDAQ2SharedMemoryClient.h"
 
 #include "ThermoDisplay2ChartView.h"
 #include "ThermoDisplay2Chart.h"
 #include "ThermoDisplay2LineSeries.h"
+#include "ThermoDisplay2PlotExporter.h"
 
 QT_CHARTS_USE_NAMESPACE
 
@@ -40,19 +43,27 @@ public:
 public slots:
 
   void requestData();
+  void readRecord();
   void updateInfo();
+  void refreshCharts();
 
   void clearData();
   void savePlots();
+  void plotsSaved(int saved, int failed);
 
 protected:
 
   QTimer* timer_;
+  QTimer* refreshTimer_;
 
   QTabWidget* tabWidget_;
+  QToolButton* btnSavePlots_;
+
+  ThermoDisplay2PlotExporter* exporter_;
 
   ThermoDAQ2Client* client_;
   ThermoDAQ2NetworkReader* reader_;
+  ThermoDAQ2SharedMemoryClient* shmClient_;
 
   ThermoDisplay2ChartView *ChillerTSChartView_;
   ThermoDisplay2TemperatureStateChart *ChillerTSChart_;
@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <QPainter>
+#include <QtConcurrent>
+
+#include <nqlogger.h>
+
+#include "ThermoDisplay2PlotExporter.h"
+
+ThermoDisplay2PlotExporter::ThermoDisplay2PlotExporter(QObject *parent)
+  : QObject(parent)
+{
+  connect(&watcher_, SIGNAL(finished()),
+          this, SLOT(handleFinished()));
+}
+
+void ThermoDisplay2PlotExporter::addChart(QChartView *view, const QString& filename, qreal scale)
+{
+  if (isBusy()) return;
+
+  auto dpr = scale*view->devicePixelRatioF();
+
+  Snapshot snapshot;
+  snapshot.filename = filename;
+  snapshot.image = QImage(view->width() * dpr,
+                          view->height() * dpr,
+                          QImage::Format_ARGB32_Premultiplied);
+  snapshot.image.fill(Qt::transparent);
+
+  {
+    QPainter painter(&snapshot.image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    view->render(&painter);
+  }
+
+  snapshots_.append(snapshot);
+}
+
+void ThermoDisplay2PlotExporter::start()
+{
+  if (isBusy()) return;
+
+  NQLogMessage("ThermoDisplay2PlotExporter") << "saving " << snapshots_.size() << " plots";
+
+  watcher_.setFuture(QtConcurrent::mapped(snapshots_, &ThermoDisplay2PlotExporter::save));
+}
+
+bool ThermoDisplay2PlotExporter::save(const Snapshot& snapshot)
+{
+  return snapshot.image.save(snapshot.filename, "PNG");
+}
+
+void ThermoDisplay2PlotExporter::handleFinished()
+{
+  int saved = 0;
+  int failed = 0;
+
+  QFuture<bool> future = watcher_.future();
+  for (int i=0;i<future.resultCount();++i) {
+    if (future.resultAt(i)) {
+      saved++;
+    } else {
+      NQLogWarning("ThermoDisplay2PlotExporter") << "could not write " << snapshots_.at(i).filename;
+      failed++;
+    }
+  }
+
+  snapshots_.clear();
+
+  NQLogMessage("ThermoDisplay2PlotExporter") << saved << " plots saved";
+
+  emit finished(saved, failed);
+}
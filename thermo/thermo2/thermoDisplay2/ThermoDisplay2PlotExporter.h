@@ -0,0 +1,68 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THERMODISPLAY2PLOTEXPORTER_H
+#define THERMODISPLAY2PLOTEXPORTER_H
+
+#include <QObject>
+#include <QImage>
+#include <QList>
+#include <QString>
+#include <QFutureWatcher>
+
+#include <QtCharts/QChartView>
+
+QT_CHARTS_USE_NAMESPACE
+
+/*
+  Saves chart views as PNG files without blocking the GUI.
+
+  addChart() renders a snapshot of the view into an offscreen QImage. The
+  QtCharts scene graph is not thread safe, so this step stays on the GUI
+  thread, but it is cheap compared to the PNG encoding. start() then
+  encodes and writes all snapshots in parallel on the global thread pool
+  and emits finished() once all files have been written.
+*/
+class ThermoDisplay2PlotExporter : public QObject
+{
+  Q_OBJECT
+public:
+
+  explicit ThermoDisplay2PlotExporter(QObject *parent = nullptr);
+
+  bool isBusy() const { return watcher_.isRunning(); }
+
+  void addChart(QChartView *view, const QString& filename, qreal scale = 2.0);
+  void start();
+
+signals:
+
+  void finished(int saved, int failed);
+
+protected slots:
+
+  void handleFinished();
+
+protected:
+
+  struct Snapshot {
+    QImage image;
+    QString filename;
+  };
+
+  static bool save(const Snapshot& snapshot);
+
+  QList<Snapshot> snapshots_;
+  QFutureWatcher<bool> watcher_;
+};
+
+#endif // THERMODISPLAY2PLOTEXPORTER_H
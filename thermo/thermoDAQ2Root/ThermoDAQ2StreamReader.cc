@@ -11,6 +11,7 @@
 /////////////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
+#include <cstring>
 
 #include <QDateTime>
 #include <QTextStream>
@@ -20,6 +21,8 @@
 
 #include <TDatime.h>
 
+#include "thermoDAQ2/Thermo2DAQSchema.h"
+
 #include "ThermoDAQ2StreamReader.h"
 
 ThermoDAQ2StreamReader::ThermoDAQ2StreamReader(QStringList arguments,
@@ -29,6 +32,10 @@ ThermoDAQ2StreamReader::ThermoDAQ2StreamReader(QStringList arguments,
     measurementValid_(false)
 {
   log_.message = "";
+
+  std::memset(&measurement_.record, 0, sizeof(measurement_.record));
+  measurement_.record.version = Thermo2DAQRecordVersion;
+  measurement_.uTime = 0;
 }
 
 void ThermoDAQ2StreamReader::run()
@@ -37,24 +44,6 @@ void ThermoDAQ2StreamReader::run()
   emit finished();
 }
 
-void ThermoDAQ2StreamReader::processRohdeSchwarzNGE103B(QXmlStreamReader& xml)
-{
-  QString time = xml.attributes().value("time").toString();
-  QDateTime dt = QDateTime::fromString(time, Qt::ISODate);
-  measurement_.uTime = dt.toTime_t();
-  measurement_.datime = TDatime(measurement_.uTime);
-}
-
-void ThermoDAQ2StreamReader::processRohdeSchwarzNGE103BChannel(QXmlStreamReader& xml)
-{
-  int id = xml.attributes().value("id").toString().toInt();
-  float mU = xml.attributes().value("mU").toString().toFloat();
-  float mI = xml.attributes().value("mI").toString().toFloat();
-
-  measurement_.nge103BVoltage[id-1] = mU;
-  measurement_.nge103BCurrent[id-1] = mI;
-}
-
 void ThermoDAQ2StreamReader::processLog(QXmlStreamReader& xml)
 {
   QString time = xml.attributes().value("time").toString();
@@ -71,6 +60,7 @@ void ThermoDAQ2StreamReader::processDAQStarted(QXmlStreamReader& xml)
 {
   QString time = xml.attributes().value("time").toString();
   QDateTime dt = QDateTime::fromString(time, Qt::ISODate);
+  measurement_.record.time = dt.toMSecsSinceEpoch();
   measurement_.uTime = dt.toTime_t();
   measurement_.datime = TDatime(measurement_.uTime);
 
@@ -83,11 +73,10 @@ void ThermoDAQ2StreamReader::processLine(QString& line)
   while (!xml.atEnd()) {
     xml.readNextStartElement();
     if (xml.isStartElement()) {
-      if (xml.name()=="RohdeSchwarzNGE103B") {
-        processRohdeSchwarzNGE103B(xml);
-      }
-      if (xml.name()=="RohdeSchwarzNGE103BChannel") {
-        processRohdeSchwarzNGE103BChannel(xml);
+      if (Thermo2DAQSchema::read(xml, measurement_.record)) {
+        measurement_.uTime = measurement_.record.time / 1000;
+        measurement_.datime = TDatime(measurement_.uTime);
+        continue;
       }
       if (xml.name()=="Log") {
         processLog(xml);
@@ -120,18 +109,7 @@ void ThermoDAQ2StreamReader::process()
   otree_->Branch("uTime", &measurement_.uTime, "uTime/i");
   otree_->Branch("datime", &measurement_.datime, 1024, 2);
 
-  for (int i=0;i<3;++i) {
-    char dummy1[20];
-    char dummy2[20];
-
-    sprintf(dummy1, "nge103BVoltage_%d", i+1);
-    sprintf(dummy2, "nge103BVoltage_%d/I", i+1);
-    otree_->Branch(dummy1, &measurement_.nge103BVoltage[i], dummy2);
-
-    sprintf(dummy1, "nge103BCurrent_%d", i+1);
-    sprintf(dummy2, "nge103BCurrent_%d/F", i+1);
-    otree_->Branch(dummy1, &measurement_.nge103BCurrent[i], dummy2);
-  }
+  Thermo2DAQSchema::createBranches(otree_, measurement_.record);
 
   ologtree_ = new TTree("thermoLog", "thermoLog");
   ologtree_->Branch("uTime", &log_.uTime, "uTime/i");
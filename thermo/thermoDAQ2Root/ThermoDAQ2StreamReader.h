@@ -23,12 +23,13 @@
 #include <TTree.h>
 #include <TDatime.h>
 
+#include "thermoDAQ2/Thermo2DAQRecord.h"
+
 typedef struct {
-  unsigned int   uTime;
-  TDatime        datime;
+  unsigned int     uTime;
+  TDatime          datime;
 
-  float          nge103BVoltage[3];
-  float          nge103BCurrent[3];
+  Thermo2DAQRecord record;
 } Measurement2_t;
 
 typedef struct {
@@ -58,9 +59,6 @@ protected:
   void processLog(QXmlStreamReader& xml);
   void processDAQStarted(QXmlStreamReader& xml);
 
-  void processRohdeSchwarzNGE103B(QXmlStreamReader& xml);
-  void processRohdeSchwarzNGE103BChannel(QXmlStreamReader& xml);
-
   bool measurementValid_;
   Measurement2_t measurement_;
   Log2_t         log_;
@@ -0,0 +1,47 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <new>
+
+#include "DeviceBenchmark.h"
+
+// replaces the global allocation functions of the benchmark to count the
+// heap allocations per thread, the emulator threads are not counted
+
+namespace {
+
+thread_local unsigned long gAllocations = 0;
+
+}
+
+unsigned long AllocationCount( void )
+{
+  return gAllocations;
+}
+
+void* operator new( size_t size )
+{
+  gAllocations++;
+  if (void* ptr = std::malloc( size ? size : 1 )) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete( void* ptr ) noexcept
+{
+  std::free( ptr );
+}
+
+void operator delete( void* ptr, size_t ) noexcept
+{
+  std::free( ptr );
+}
@@ -0,0 +1,44 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "HuberPilotOne.h"
+#include "PilotOneComHandler.h"
+
+#include "HuberPilotOneEmulator.h"
+#include "DeviceBenchmark.h"
+
+void BenchmarkHuberPilotOne( const BenchmarkOptions& options )
+{
+  HuberPilotOneEmulator emulator;
+  if (!StartEmulator( emulator, options )) return;
+
+  const char* port = emulator.DevicePath().c_str();
+
+  {
+    PilotOneComHandler comHandler( port );
+    char buffer[1000];
+
+    Measure( "HuberPilotOne", "{M01**** (ComHandler)", options, [&]() {
+        comHandler.SendCommand( "{M01****" );
+        comHandler.ReceiveString( buffer );
+      } );
+  }
+
+  {
+    // the driver waits a fixed time around every command
+    HuberPilotOne huber( port );
+
+    Measure( "HuberPilotOne", "GetBathTemperature()", options, [&]() {
+        huber.GetBathTemperature();
+      } );
+  }
+}
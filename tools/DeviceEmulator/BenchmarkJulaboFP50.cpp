@@ -0,0 +1,43 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "JulaboFP50.h"
+#include "FP50ComHandler.h"
+
+#include "JulaboFP50Emulator.h"
+#include "DeviceBenchmark.h"
+
+void BenchmarkJulaboFP50( const BenchmarkOptions& options )
+{
+  JulaboFP50Emulator emulator;
+  if (!StartEmulator( emulator, options )) return;
+
+  const char* port = emulator.DevicePath().c_str();
+
+  {
+    FP50ComHandler comHandler( port );
+    char buffer[1000];
+
+    Measure( "JulaboFP50", "in_pv_00 (ComHandler)", options, [&]() {
+        comHandler.SendCommand( "in_pv_00" );
+        comHandler.ReceiveString( buffer );
+      } );
+  }
+
+  {
+    JulaboFP50 julabo( port );
+
+    Measure( "JulaboFP50", "GetBathTemperature()", options, [&]() {
+        julabo.GetBathTemperature();
+      } );
+  }
+}
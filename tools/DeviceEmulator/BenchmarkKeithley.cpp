@@ -0,0 +1,56 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "Keithley2700.h"
+
+#include "KeithleyEmulator.h"
+#include "DeviceBenchmark.h"
+
+void BenchmarkKeithley2700( const BenchmarkOptions& options )
+{
+  Keithley2700Emulator emulator;
+  if (!StartEmulator( emulator, options )) return;
+
+  const char* port = emulator.DevicePath().c_str();
+
+  {
+    KMMComHandler comHandler( port );
+    char buffer[1000];
+
+    Measure( "Keithley2700", "*IDN? (ComHandler)", options, [&]() {
+        comHandler.SendCommand( "*IDN?" );
+        comHandler.ReceiveString( buffer );
+      } );
+  }
+
+  {
+    // Scan() returns as soon as the reply is complete
+    Keithley2700 keithley( port );
+    keithley.SetActiveChannels( "0-9" );
+
+    Measure( "Keithley2700", "Scan() 10 channels ASCII", options, [&]() {
+        keithley.Scan();
+      } );
+
+    keithley.SetBinaryReadout( true );
+
+    Measure( "Keithley2700", "Scan() 10 channels SRE", options, [&]() {
+        keithley.Scan();
+      } );
+
+    keithley.SetContinuousScan( true );
+
+    Measure( "Keithley2700", "Scan() 10 channels SRE, INIT:CONT", options, [&]() {
+        keithley.Scan();
+      } );
+  }
+}
@@ -0,0 +1,64 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+
+#include "KeithleyDAQ6510.h"
+
+#include "KeithleyEmulator.h"
+#include "DeviceBenchmark.h"
+
+void BenchmarkKeithleyDAQ6510( const BenchmarkOptions& options )
+{
+  KeithleyDAQ6510Emulator emulator;
+  if (!StartEmulator( emulator, options )) return;
+
+  const char* port = emulator.DevicePath().c_str();
+
+  {
+    KeithleyUSBTMCComHandler comHandler( port );
+    char buffer[1000];
+
+    Measure( "KeithleyDAQ6510", "*IDN? (ComHandler)", options, [&]() {
+        comHandler.SendCommand( "*IDN?" );
+        comHandler.ReceiveString( buffer );
+      } );
+  }
+
+  {
+    KeithleyDAQ6510 daq( port );
+    for (unsigned int channel = 1; channel <= 10; ++channel) {
+      daq.ActivateChannel( 1, channel, true );
+    }
+
+    Measure( "KeithleyDAQ6510", "Scan()+GetScanData()", options, [&]() {
+        reading_t data;
+        daq.Scan();
+        daq.GetScanData( data );
+      } );
+
+    // a scan that does not deliver all readings in time counts as a failed iteration
+    MeasureChecked( "KeithleyDAQ6510", "Scan()+TRAC:ACT? stream", options, [&]() {
+        reading_t data;
+        unsigned int count = 0;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 2 );
+        daq.Scan();
+        while (count < daq.GetActiveChannelCount()) {
+          if (std::chrono::steady_clock::now() >= deadline) return false;
+          unsigned int available = daq.GetNumberOfReadings();
+          if (available > count) daq.GetScanData( count + 1, available, data );
+          count = available;
+        }
+        return true;
+      } );
+  }
+}
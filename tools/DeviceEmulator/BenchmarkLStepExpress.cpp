@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "SerialBroker.h"
+#include "LStepExpress.h"
+
+#include "LStepExpressEmulator.h"
+#include "DeviceBenchmark.h"
+
+void BenchmarkLStepExpress( const BenchmarkOptions& options )
+{
+  const std::string version = "Vers:LSPE 1.4.8";
+  const std::string internalVersion = "1.4.8";
+
+  LStepExpressEmulator emulator( version, internalVersion );
+  if (!StartEmulator( emulator, options )) return;
+
+  {
+    LStepExpressComHandler comHandler( emulator.DevicePath() );
+    char buffer[1000];
+
+    Measure( "LStepExpress", "pos (ComHandler)", options, [&]() {
+        comHandler.SendCommand( "pos" );
+        comHandler.ReceiveString( buffer );
+      } );
+  }
+
+  {
+    LStepExpress lstep( emulator.DevicePath(), version, internalVersion );
+    std::vector<double> values;
+    std::vector<int> status;
+
+    Measure( "LStepExpress", "GetPosition()", options, [&]() {
+        lstep.GetPosition( values );
+      } );
+
+    Measure( "LStepExpress", "GetAxisStatus()", options, [&]() {
+        lstep.GetAxisStatus( status );
+      } );
+
+    Measure( "LStepExpress", "GetMotionStatus()", options, [&]() {
+        lstep.GetMotionStatus( status, values );
+      } );
+
+    Measure( "LStepExpress", "GetMotionParameters()", options, [&]() {
+        std::vector<int> axis, dim;
+        std::vector<double> accel, decel, acceljerk, deceljerk, vel;
+        lstep.GetMotionParameters( axis, dim, accel, decel, acceljerk, deceljerk, vel );
+      } );
+
+    Measure( "LStepExpress", "MoveRelative()", options, [&]() {
+        lstep.MoveRelative( VLStepExpress::X, 0.1 );
+      } );
+
+    // a second consumer of the same controller, like the motion manager
+    // next to the model; identical queries in flight share a transaction
+    LStepExpress consumer( emulator.DevicePath(), version, internalVersion );
+    std::atomic<bool> running( true );
+    std::thread thread( [&]() {
+        std::vector<double> positions;
+        while (running) consumer.GetPosition( positions );
+      } );
+
+    std::shared_ptr<SerialBroker> broker = SerialBroker::Instance( emulator.DevicePath() );
+    unsigned long transactions = broker->Transactions();
+    unsigned long coalesced = broker->Coalesced();
+
+    Measure( "LStepExpress", "GetPosition() 2 consumers", options, [&]() {
+        lstep.GetPosition( values );
+      } );
+
+    running = false;
+    thread.join();
+
+    std::cout << "                  " << broker->Coalesced() - coalesced << " of "
+              << broker->Transactions() - transactions + broker->Coalesced() - coalesced
+              << " queries coalesced" << std::endl;
+  }
+}
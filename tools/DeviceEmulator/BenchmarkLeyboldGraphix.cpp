@@ -0,0 +1,53 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "LeyboldGraphixThree.h"
+
+#include "LeyboldGraphixEmulator.h"
+#include "DeviceBenchmark.h"
+
+void BenchmarkLeyboldGraphix( const BenchmarkOptions& options )
+{
+  LeyboldGraphixEmulator emulator( 3 );
+  if (!StartEmulator( emulator, options )) return;
+
+  const char* port = emulator.DevicePath().c_str();
+
+  {
+    LeyboldComHandler comHandler( port );
+    char buffer[1000];
+
+    // <SI>1;29 <CRC><EOT>, pressure of sensor 1
+    std::string command = "\x0f" "1;29 ";
+    int sum = 0;
+    for (unsigned char c : command) sum += c;
+    command += (char)(255 - (sum % 256));
+    command += '\x04';
+
+    Measure( "LeyboldGraphix", "1;29 (ComHandler)", options, [&]() {
+        comHandler.SendCommand( command.c_str() );
+        comHandler.ReceiveString( buffer );
+      } );
+  }
+
+  {
+    LeyboldGraphixThree graphix( port );
+
+    Measure( "LeyboldGraphix", "GetPressure(1)", options, [&]() {
+        graphix.GetPressure( 1 );
+      } );
+
+    Measure( "LeyboldGraphix", "GetSensorStatus(1)", options, [&]() {
+        graphix.GetSensorStatus( 1 );
+      } );
+  }
+}
@@ -0,0 +1,187 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "PtyEmulator.h"
+#include "DeviceBenchmark.h"
+
+namespace {
+
+// the result table, std::cout is silenced while the benchmarks run
+// because some drivers print every reply and their initialisation
+std::ostream* gTable = &std::cout;
+
+}
+
+bool StartEmulator( PtyEmulator& emulator, const BenchmarkOptions& options )
+{
+  emulator.SetResponseDelay( options.responseDelay );
+  emulator.SetBaudRate( options.baudRate );
+
+  return emulator.Start();
+}
+
+void Measure( const std::string& device, const std::string& query,
+              const BenchmarkOptions& options, const std::function<void()>& function )
+{
+  MeasureChecked( device, query, options, [&]() { function(); return true; } );
+}
+
+void MeasureChecked( const std::string& device, const std::string& query,
+                     const BenchmarkOptions& options, const std::function<bool()>& function )
+{
+  typedef std::chrono::steady_clock clock_type;
+
+  std::vector<double> latencies;
+  latencies.reserve( options.iterations );
+  unsigned int failures = 0;
+
+  auto start = clock_type::now();
+  auto deadline = start + std::chrono::duration<double>( options.timeLimit );
+  unsigned long allocations = AllocationCount();
+
+  while (latencies.size() + failures < options.iterations) {
+    auto begin = clock_type::now();
+    bool ok = function();
+    auto end = clock_type::now();
+
+    if (ok) {
+      latencies.push_back( std::chrono::duration<double,std::milli>( end - begin ).count() );
+    } else {
+      failures++;
+    }
+
+    if (end >= deadline) break;
+  }
+
+  double elapsed = std::chrono::duration<double>( clock_type::now() - start ).count();
+  allocations = AllocationCount() - allocations;
+
+  unsigned int iterations = latencies.size() + failures;
+
+  // keeps the table readable if every query failed
+  if (latencies.empty()) latencies.push_back( 0 );
+
+  std::sort( latencies.begin(), latencies.end() );
+
+  double sum = 0;
+  for (double latency : latencies) sum += latency;
+
+  auto percentile = [&latencies]( double p ) {
+    size_t idx = std::min( latencies.size() - 1, (size_t)( p * latencies.size() ) );
+    return latencies[idx];
+  };
+
+  *gTable << std::left << std::setw( 18 ) << device
+          << std::setw( 34 ) << query
+          << std::right << std::setw( 7 ) << iterations
+          << std::setw( 7 ) << failures
+          << std::fixed << std::setprecision( 3 )
+          << std::setw( 10 ) << latencies.front()
+          << std::setw( 10 ) << sum / latencies.size()
+          << std::setw( 10 ) << percentile( 0.50 )
+          << std::setw( 10 ) << percentile( 0.99 )
+          << std::setw( 10 ) << latencies.back()
+          << std::setprecision( 1 )
+          << std::setw( 10 ) << iterations / elapsed
+          << std::setw( 10 ) << (double) allocations / iterations
+          << std::endl;
+}
+
+void usage( const char* name )
+{
+  std::cerr << "usage: " << name << " [-n iterations] [-t seconds] [-d delay] [-b baudrate] [device ...]" << std::endl;
+  std::cerr << "   -n  maximum number of queries per measurement (default 1000)" << std::endl;
+  std::cerr << "   -t  maximum duration of a measurement in s (default 10)" << std::endl;
+  std::cerr << "   -d  emulated device response time in us (default 0)" << std::endl;
+  std::cerr << "   -b  emulated baud rate, 0 disables the transmission delay (default 0)" << std::endl;
+  std::cerr << "   devices: keithley2700 daq6510 lstep leybold huber julabo (default all)" << std::endl;
+}
+
+int main( int argc, char** argv )
+{
+  BenchmarkOptions options;
+  options.iterations = 1000;
+  options.timeLimit = 10.0;
+  options.responseDelay = 0;
+  options.baudRate = 0;
+
+  int opt;
+  while ((opt = getopt( argc, argv, "n:t:d:b:h" )) != -1) {
+    switch (opt) {
+    case 'n': options.iterations = std::max( 1, std::atoi( optarg ) ); break;
+    case 't': options.timeLimit = std::atof( optarg ); break;
+    case 'd': options.responseDelay = std::atoi( optarg ); break;
+    case 'b': options.baudRate = std::atoi( optarg ); break;
+    default:
+      usage( argv[0] );
+      return opt == 'h' ? 0 : -1;
+    }
+  }
+
+  std::map<std::string,std::function<void(const BenchmarkOptions&)> > benchmarks;
+  benchmarks["keithley2700"] = BenchmarkKeithley2700;
+  benchmarks["daq6510"] = BenchmarkKeithleyDAQ6510;
+  benchmarks["lstep"] = BenchmarkLStepExpress;
+  benchmarks["leybold"] = BenchmarkLeyboldGraphix;
+  benchmarks["huber"] = BenchmarkHuberPilotOne;
+  benchmarks["julabo"] = BenchmarkJulaboFP50;
+
+  std::vector<std::string> devices;
+  for (int i = optind; i < argc; ++i) {
+    if (benchmarks.find( argv[i] ) == benchmarks.end()) {
+      usage( argv[0] );
+      return -1;
+    }
+    devices.push_back( argv[i] );
+  }
+  if (devices.empty()) {
+    devices = { "keithley2700", "daq6510", "lstep", "leybold", "huber", "julabo" };
+  }
+
+  std::cout << std::left << std::setw( 18 ) << "device"
+            << std::setw( 34 ) << "query"
+            << std::right << std::setw( 7 ) << "n"
+            << std::setw( 7 ) << "fail"
+            << std::setw( 10 ) << "min"
+            << std::setw( 10 ) << "mean"
+            << std::setw( 10 ) << "p50"
+            << std::setw( 10 ) << "p99"
+            << std::setw( 10 ) << "max"
+            << std::setw( 10 ) << "q/s"
+            << std::setw( 10 ) << "alloc/q" << std::endl;
+  std::cout << std::setw( 52 ) << "" << std::setw( 14 ) << ""
+            << std::setw( 50 ) << "[ms]" << std::endl;
+
+  // the drivers are constructed and initialised inside the benchmarks,
+  // only the result table goes to stdout
+  std::ostream table( std::cout.rdbuf() );
+  gTable = &table;
+
+  std::streambuf* coutBuffer = std::cout.rdbuf( nullptr );
+
+  for (const std::string& device : devices) benchmarks[device]( options );
+
+  std::cout.rdbuf( coutBuffer );
+  gTable = &std::cout;
+
+  return 0;
+}
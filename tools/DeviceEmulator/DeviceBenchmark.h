@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DEVICEBENCHMARK_H_
+#define _DEVICEBENCHMARK_H_
+
+#include <functional>
+#include <string>
+
+class PtyEmulator;
+
+struct BenchmarkOptions
+{
+  unsigned int iterations;   //!< maximum number of queries per measurement
+  double timeLimit;          //!< maximum duration of a measurement in s
+  int responseDelay;         //!< emulated device response time in us
+  int baudRate;              //!< emulated line speed, 0 for none
+};
+
+/**
+  Applies the options to the emulator and starts it. Returns false if no
+  pseudo terminal could be created.
+  */
+bool StartEmulator( PtyEmulator& emulator, const BenchmarkOptions& options );
+
+//! Number of heap allocations done so far by the calling thread.
+unsigned long AllocationCount( void );
+
+/**
+  Calls function repeatedly until the number of iterations or the time limit
+  is reached and prints the round-trip latency distribution, the query
+  rate and the heap allocations per query as one line of the result table.
+  */
+void Measure( const std::string& device, const std::string& query,
+              const BenchmarkOptions& options, const std::function<void()>& function );
+
+/**
+  Same as Measure(), for queries that can fail: function returns false
+  for a failed query, which is counted in the "fail" column and not
+  included in the latency distribution.
+  */
+void MeasureChecked( const std::string& device, const std::string& query,
+                     const BenchmarkOptions& options, const std::function<bool()>& function );
+
+// one benchmark per driver, each measures the bare ComHandler round trip
+// and one or more driver calls on top of it
+void BenchmarkKeithley2700( const BenchmarkOptions& options );
+void BenchmarkKeithleyDAQ6510( const BenchmarkOptions& options );
+void BenchmarkLStepExpress( const BenchmarkOptions& options );
+void BenchmarkLeyboldGraphix( const BenchmarkOptions& options );
+void BenchmarkHuberPilotOne( const BenchmarkOptions& options );
+void BenchmarkJulaboFP50( const BenchmarkOptions& options );
+
+#endif // _DEVICEBENCHMARK_H_
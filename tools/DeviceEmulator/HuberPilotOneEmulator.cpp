@@ -0,0 +1,57 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "HuberPilotOneEmulator.h"
+
+HuberPilotOneEmulator::HuberPilotOneEmulator()
+  : PtyEmulator( "\n" )
+{
+  fRegisters["00"] = 2000; // temperature set point (0.01 C)
+  fRegisters["01"] = 2012; // bath temperature
+  fRegisters["02"] = 2005; // return temperature
+  fRegisters["03"] = 150;  // pump pressure (mbar)
+  fRegisters["04"] = 0;    // power
+  fRegisters["13"] = 0;    // external temperature control
+  fRegisters["14"] = 1;    // temperature control enabled
+  fRegisters["16"] = 1;    // circulator enabled
+  fRegisters["2C"] = 0;
+  fRegisters["4C"] = 0;
+}
+
+bool HuberPilotOneEmulator::Respond( const std::string& command, std::string& reply )
+{
+  if (command == "CA?") {
+    reply = "CA +00001\r\n";
+    return true;
+  }
+
+  if (command.length() != 8 || command.compare( 0, 2, "{M" ) != 0) return false;
+
+  std::string address = command.substr( 2, 2 );
+  std::string data = command.substr( 4, 4 );
+
+  auto it = fRegisters.find( address );
+  if (it == fRegisters.end()) return false;
+
+  if (data != "****") {
+    it->second = std::strtoul( data.c_str(), nullptr, 16 ) & 0xFFFF;
+  }
+
+  char buffer[16];
+  snprintf( buffer, sizeof(buffer), "{S%s%04X\r\n", address.c_str(), it->second );
+  reply = buffer;
+
+  return true;
+}
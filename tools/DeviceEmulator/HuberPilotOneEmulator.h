@@ -0,0 +1,41 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _HUBERPILOTONEEMULATOR_H_
+#define _HUBERPILOTONEEMULATOR_H_
+
+#include <map>
+
+#include "PtyEmulator.h"
+
+/**
+  \brief Huber Pilot ONE controller.
+
+  Process interface (PB) commands {Mxx**** read and {Mxxhhhh write a 16 bit
+  register and are answered with {Sxxhhhh. The LAI status query CA? is
+  answered as well, it is used by HuberPilotOne to detect the device.
+*/
+class HuberPilotOneEmulator : public PtyEmulator
+{
+ public:
+
+  HuberPilotOneEmulator();
+  ~HuberPilotOneEmulator() { Stop(); }
+
+ protected:
+
+  bool Respond( const std::string& command, std::string& reply );
+
+  std::map<std::string,unsigned int> fRegisters;
+};
+
+#endif // _HUBERPILOTONEEMULATOR_H_
@@ -0,0 +1,57 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "JulaboFP50Emulator.h"
+
+JulaboFP50Emulator::JulaboFP50Emulator()
+  : PtyEmulator( "\n" )
+{
+  fValues["sp_00"] = "20.00";   // working temperature
+  fValues["sp_07"] = "2";       // pump pressure stage
+  fValues["pv_00"] = "20.12";   // bath temperature
+  fValues["pv_01"] = "15";      // heating power
+  fValues["pv_03"] = "20.20";   // safety sensor temperature
+  fValues["mode_05"] = "0";     // circulator
+  fValues["par_06"] = "0.5";    // control parameters Xp, Tn, Tv
+  fValues["par_07"] = "3";
+  fValues["par_08"] = "0";
+}
+
+bool JulaboFP50Emulator::Respond( const std::string& command, std::string& reply )
+{
+  if (command == "version") {
+    reply = "JULABO TOPTECH-SERIES MC-2 VERSION 3.0\r\n";
+    return true;
+  }
+
+  if (command == "status") {
+    reply = "01 MANUAL START\r\n";
+    return true;
+  }
+
+  if (command.compare( 0, 3, "in_" ) == 0) {
+    auto it = fValues.find( command.substr( 3 ) );
+    if (it == fValues.end()) return false;
+    reply = it->second + "\r\n";
+    return true;
+  }
+
+  if (command.compare( 0, 4, "out_" ) == 0) {
+    size_t idx = command.find( ' ' );
+    if (idx == std::string::npos) return false;
+    auto it = fValues.find( command.substr( 4, idx - 4 ) );
+    if (it != fValues.end()) it->second = command.substr( idx + 1 );
+    return false;
+  }
+
+  return false;
+}
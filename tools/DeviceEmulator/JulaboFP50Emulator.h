@@ -0,0 +1,40 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _JULABOFP50EMULATOR_H_
+#define _JULABOFP50EMULATOR_H_
+
+#include <map>
+
+#include "PtyEmulator.h"
+
+/**
+  \brief Julabo FP50 with MC-2 controller.
+
+  in_* commands return the parameter, out_* commands set it without a
+  reply, version and status return fixed strings.
+*/
+class JulaboFP50Emulator : public PtyEmulator
+{
+ public:
+
+  JulaboFP50Emulator();
+  ~JulaboFP50Emulator() { Stop(); }
+
+ protected:
+
+  bool Respond( const std::string& command, std::string& reply );
+
+  std::map<std::string,std::string> fValues;
+};
+
+#endif // _JULABOFP50EMULATOR_H_
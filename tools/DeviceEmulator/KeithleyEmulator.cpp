@@ -0,0 +1,200 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include "KeithleyEmulator.h"
+
+namespace {
+
+//! Parses a SCPI channel list like (@101:105,201).
+std::vector<unsigned int> ParseChannelList( const std::string& command )
+{
+  std::vector<unsigned int> channels;
+
+  size_t begin = command.find( "(@" );
+  size_t end = command.find( ')', begin );
+  if (begin == std::string::npos || end == std::string::npos) return channels;
+
+  std::stringstream ss( command.substr( begin + 2, end - begin - 2 ) );
+  std::string item;
+  while (std::getline( ss, item, ',' )) {
+    size_t idx = item.find( ':' );
+    unsigned int first = std::atoi( item.c_str() );
+    unsigned int last = idx == std::string::npos ? first : std::atoi( item.c_str() + idx + 1 );
+    for (unsigned int channel = first; channel <= last; ++channel) channels.push_back( channel );
+  }
+
+  return channels;
+}
+
+//! Slowly varying temperature like value of a channel.
+double ChannelValue( unsigned int channel, unsigned long count )
+{
+  return 20.0 + 0.1 * (channel % 100) + 0.001 * (count % 100);
+}
+
+}
+
+Keithley2700Emulator::Keithley2700Emulator()
+  : PtyEmulator( "\n" ),
+    fSampleCount( 10 ),
+    fReadingNumber( 0 ),
+    fReadingOnly( false ),
+    fBinary( false ),
+    fContinuous( false )
+{
+
+}
+
+bool Keithley2700Emulator::Respond( const std::string& command, std::string& reply )
+{
+  if (command == "*IDN?") {
+    reply = "KEITHLEY INSTRUMENTS INC.,MODEL 2700,0000000,B09  /A02\n";
+    return true;
+  }
+
+  if (command.compare( 0, 9, "SAMP:COUN" ) == 0) {
+    fSampleCount = std::atoi( command.c_str() + 9 );
+    return false;
+  }
+
+  if (command == "FORM:ELEM READ") {
+    fReadingOnly = true;
+    return false;
+  }
+
+  if (command.compare( 0, 10, "FORM:DATA " ) == 0) {
+    fBinary = command.compare( 10, 3, "SRE" ) == 0;
+    return false;
+  }
+
+  if (command.compare( 0, 10, "INIT:CONT " ) == 0) {
+    fContinuous = command.compare( 10, 2, "ON" ) == 0;
+    return false;
+  }
+
+  if (command == "READ?" || (command == "FETC?" && fContinuous)) {
+    Readings( reply );
+    return true;
+  }
+
+  return false;
+}
+
+void Keithley2700Emulator::Readings( std::string& reply )
+{
+  char buffer[64];
+  reply.clear();
+
+  if (fBinary) {
+    reply = "#0";
+    for (unsigned int i = 0; i < fSampleCount; ++i) {
+      fReadingNumber++;
+      float value = ChannelValue( i, fReadingNumber );
+      uint32_t bits;
+      memcpy( &bits, &value, sizeof(bits) );
+      for (int shift = 24; shift >= 0; shift -= 8) reply += static_cast<char>( (bits >> shift) & 0xff );
+    }
+    reply += "\n";
+    return;
+  }
+
+  for (unsigned int i = 0; i < fSampleCount; ++i) {
+    if (i > 0) reply += ",";
+    fReadingNumber++;
+    if (fReadingOnly) {
+      snprintf( buffer, sizeof(buffer), "%+.6EC", ChannelValue( i, fReadingNumber ) );
+    } else {
+      snprintf( buffer, sizeof(buffer), "%+.6EC,%+012.3fSECS,+%05luRDNG#",
+                ChannelValue( i, fReadingNumber ), fReadingNumber * 0.1, fReadingNumber % 100000 );
+    }
+    reply += buffer;
+  }
+  reply += "\n";
+}
+
+KeithleyDAQ6510Emulator::KeithleyDAQ6510Emulator()
+  : PtyEmulator( "\n" ),
+    fScanCount( 0 )
+{
+
+}
+
+bool KeithleyDAQ6510Emulator::Respond( const std::string& command, std::string& reply )
+{
+  if (command == "*IDN?") {
+    reply = "KEITHLEY INSTRUMENTS,MODEL DAQ6510,00000000,1.6.7d\n";
+    return true;
+  }
+
+  if (command == "SYST:CARD1:IDN?" || command == "SYST:CARD2:IDN?") {
+    reply = "7700,20Ch Mux w/CJC,0000000,1.0.0a\n";
+    return true;
+  }
+
+  if (command.compare( 0, 10, "ROUT:SCAN " ) == 0) {
+    fChannels = ParseChannelList( command );
+    return false;
+  }
+
+  if (command == "ROUT:SCAN:STAT?") {
+    reply = "SUCCESS;1;" + std::to_string( fBuffer.size() ) + "\n";
+    return true;
+  }
+
+  if (command == "TRAC:CLE") {
+    fBuffer.clear();
+    return false;
+  }
+
+  if (command == "INIT") {
+    fScanCount++;
+    for (unsigned int channel : fChannels) {
+      fBuffer.push_back( std::make_pair( channel, ChannelValue( channel, fScanCount ) ) );
+    }
+    return false;
+  }
+
+  if (command == "TRAC:ACT?") {
+    reply = std::to_string( fBuffer.size() ) + "\n";
+    return true;
+  }
+
+  if (command.compare( 0, 10, "TRAC:DATA?" ) == 0) {
+
+    // TRAC:DATA? <start>, <end>, 'defbuffer1', CHAN, READ, REL
+    std::stringstream ss( command.substr( 10 ) );
+    std::string item;
+    std::getline( ss, item, ',' );
+    unsigned int start = std::atoi( item.c_str() );
+    std::getline( ss, item, ',' );
+    unsigned int end = std::atoi( item.c_str() );
+
+    char buffer[64];
+    reply.clear();
+    for (unsigned int i = start; i <= end && i <= fBuffer.size(); ++i) {
+      if (i > start) reply += ",";
+      snprintf( buffer, sizeof(buffer), "%u,%.9E,%.6f",
+                fBuffer[i-1].first, fBuffer[i-1].second, 0.3 * (i - 1) );
+      reply += buffer;
+    }
+    reply += "\n";
+    return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _KEITHLEYEMULATOR_H_
+#define _KEITHLEYEMULATOR_H_
+
+#include <vector>
+
+#include "PtyEmulator.h"
+
+/**
+  \brief SCPI subset of a Keithley 2700 with 7700 card as used by Keithley2700.
+
+  READ? returns one reading (value, timestamp, reading number) per channel
+  of the last SAMP:COUN. FORM:ELEM READ reduces it to the value and
+  FORM:DATA SRE switches to a #0 block of big endian floats. FETC? returns
+  the readings of a new scan while INIT:CONT is ON.
+*/
+class Keithley2700Emulator : public PtyEmulator
+{
+ public:
+
+  Keithley2700Emulator();
+  ~Keithley2700Emulator() { Stop(); }
+
+ protected:
+
+  bool Respond( const std::string& command, std::string& reply );
+
+  void Readings( std::string& reply );
+
+  unsigned int fSampleCount;
+  unsigned long fReadingNumber;
+  bool fReadingOnly;
+  bool fBinary;
+  bool fContinuous;
+};
+
+/**
+  \brief SCPI subset of a Keithley DAQ6510 with two 7700 cards as used by
+  KeithleyDAQ6510.
+
+  INIT fills the reading buffer with one reading per channel of the last
+  ROUT:SCAN channel list. TRAC:ACT? and TRAC:DATA? read it back.
+*/
+class KeithleyDAQ6510Emulator : public PtyEmulator
+{
+ public:
+
+  KeithleyDAQ6510Emulator();
+  ~KeithleyDAQ6510Emulator() { Stop(); }
+
+ protected:
+
+  bool Respond( const std::string& command, std::string& reply );
+
+  std::vector<unsigned int> fChannels;
+  std::vector<std::pair<unsigned int,double> > fBuffer;
+  unsigned long fScanCount;
+};
+
+#endif // _KEITHLEYEMULATOR_H_
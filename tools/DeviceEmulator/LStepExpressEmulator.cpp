@@ -0,0 +1,136 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+#include "LStepExpressEmulator.h"
+
+namespace {
+
+int AxisIndex( const std::string& name )
+{
+  if (name == "x") return 0;
+  if (name == "y") return 1;
+  if (name == "z") return 2;
+  if (name == "a") return 3;
+  return -1;
+}
+
+}
+
+LStepExpressEmulator::LStepExpressEmulator( const std::string& version,
+                                            const std::string& internalVersion )
+  : PtyEmulator( "\r" ),
+    fVersion( version ),
+    fInternalVersion( internalVersion )
+{
+  fValues["autostatus"] = { "0" };
+  fValues["joy"] = { "0" };
+  fValues["joyenable"] = { "0" };
+  fValues["poscon"] = { "0" };
+  fValues["err"] = { "0" };
+  fValues["axis"] = { "1", "1", "1", "1" };
+  fValues["axisdir"] = { "0", "0", "0", "0" };
+  fValues["dim"] = { "2", "2", "2", "2" };
+  fValues["pa"] = { "1", "1", "1", "1" };
+  fValues["accel"] = { "1.00", "1.00", "1.00", "1.00" };
+  fValues["decel"] = { "1.00", "1.00", "1.00", "1.00" };
+  fValues["acceljerk"] = { "100", "100", "100", "100" };
+  fValues["deceljerk"] = { "100", "100", "100", "100" };
+  fValues["vel"] = { "10.0000", "10.0000", "10.0000", "10.0000" };
+  fValues["pos"] = { "0.0000", "0.0000", "0.0000", "0.0000" };
+}
+
+bool LStepExpressEmulator::Respond( const std::string& command, std::string& reply )
+{
+  if (command == "ver") {
+    reply = fVersion + "\r";
+    return true;
+  }
+  if (command == "iver") {
+    reply = fInternalVersion + "\r";
+    return true;
+  }
+  if (command == "readsn") {
+    reply = "00000000000\r";
+    return true;
+  }
+  if (command == "statusaxis") {
+    reply = "@@@@---------\r";
+    return true;
+  }
+  if (command == "status" || command == "?sysstat" || command == "?sysstatus") {
+    reply = "OK...\r";
+    return true;
+  }
+
+  if (command == "Save") return false;
+
+  std::vector<std::string> tokens;
+  std::istringstream is( command );
+  std::string token;
+  while (is >> token) tokens.push_back( token );
+
+  bool isSet = tokens[0][0] == '!';
+  std::string name = tokens[0].substr( (isSet || tokens[0][0] == '?') ? 1 : 0 );
+  int axis = tokens.size() > 1 ? AxisIndex( tokens[1] ) : -1;
+
+  // setters of the motion parameters are accepted without the !
+  if (!isSet && tokens.size() > 2) isSet = true;
+  if (!isSet && tokens.size() == 2 && axis == -1) isSet = true;
+
+  if (name == "moa" || name == "mor") {
+    std::vector<std::string>& pos = fValues["pos"];
+    for (unsigned int i = 1; i < tokens.size() && i <= pos.size(); ++i) {
+      double value = std::atof( tokens[i].c_str() );
+      if (name == "mor") value += std::atof( pos[i-1].c_str() );
+      char buffer[32];
+      snprintf( buffer, sizeof(buffer), "%.4f", value );
+      pos[i-1] = buffer;
+    }
+    return false;
+  }
+
+  auto it = fValues.find( name );
+
+  if (isSet) {
+    if (it == fValues.end() || tokens.size() < 2) return false;
+    if (axis >= 0 && tokens.size() > 2) {
+      if (axis < (int)it->second.size()) it->second[axis] = tokens[2];
+    } else {
+      for (unsigned int i = 1; i < tokens.size() && i <= it->second.size(); ++i) {
+        it->second[i-1] = tokens[i];
+      }
+    }
+    return false;
+  }
+
+  if (it == fValues.end()) {
+    reply = "0\r";
+    return true;
+  }
+
+  if (axis >= 0) {
+    reply = axis < (int)it->second.size() ? it->second[axis] : "0";
+  } else {
+    reply.clear();
+    for (unsigned int i = 0; i < it->second.size(); ++i) {
+      if (i > 0) reply += " ";
+      reply += it->second[i];
+    }
+  }
+  reply += "\r";
+
+  return true;
+}
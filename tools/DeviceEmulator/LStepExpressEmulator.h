@@ -0,0 +1,46 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LSTEPEXPRESSEMULATOR_H_
+#define _LSTEPEXPRESSEMULATOR_H_
+
+#include <map>
+#include <vector>
+
+#include "PtyEmulator.h"
+
+/**
+  \brief Command set of a Lang LStep Express as used by LStepExpress.
+
+  Every parameter holds one value per axis (x, y, z, a). "name" returns
+  all values, "name x" a single one, "!name ..." sets them. Moves (!moa,
+  !mor) complete immediately.
+*/
+class LStepExpressEmulator : public PtyEmulator
+{
+ public:
+
+  LStepExpressEmulator( const std::string& version,
+                        const std::string& internalVersion );
+  ~LStepExpressEmulator() { Stop(); }
+
+ protected:
+
+  bool Respond( const std::string& command, std::string& reply );
+
+  std::string fVersion;
+  std::string fInternalVersion;
+
+  std::map<std::string,std::vector<std::string> > fValues;
+};
+
+#endif // _LSTEPEXPRESSEMULATOR_H_
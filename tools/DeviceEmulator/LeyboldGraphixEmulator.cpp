@@ -0,0 +1,104 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "LeyboldGraphixEmulator.h"
+
+namespace {
+
+const char EOT  = 0x04;
+const char ACK  = 0x06;
+const char NACK = 0x15;
+const char SO   = 0x0E;
+const char SI   = 0x0F;
+
+}
+
+LeyboldGraphixEmulator::LeyboldGraphixEmulator( int channels )
+  : PtyEmulator( std::string( 1, EOT ) )
+{
+  fValues["5;1"] = "LDS 1.52";
+  fValues["5;2"] = "12345";
+  fValues["5;3"] = channels == 1 ? "230680V01" : "230682V01";
+  fValues["5;4"] = "mbar";
+  fValues["5;8"] = std::to_string( channels );
+  fValues["5;20"] = "12:00:00";
+  fValues["5;21"] = "2020-01-01";
+
+  for (int sensor = 1; sensor <= channels; ++sensor) {
+    std::string prefix = std::to_string( sensor ) + ";";
+    fValues[prefix + "2"] = "Auto";
+    fValues[prefix + "4"] = "TTR91";
+    fValues[prefix + "5"] = "Sensor " + std::to_string( sensor );
+    fValues[prefix + "24"] = "OK";
+    fValues[prefix + "29"] = "1.0E-03";
+  }
+
+  for (int sp = 0; sp < 6; ++sp) {
+    fValues["4;" + std::to_string( sp*4 + 1 )] = "Off";
+    fValues["4;" + std::to_string( sp*4 + 2 )] = "1.0E-02";
+    fValues["4;" + std::to_string( sp*4 + 3 )] = "2.0E-02";
+    fValues["4;" + std::to_string( sp*4 + 4 )] = "Off";
+  }
+}
+
+//! 255 - (byte sum % 256), values below 32 are shifted out of the control characters.
+char LeyboldGraphixEmulator::Checksum( const std::string& buffer ) const
+{
+  int sum = 0;
+  for (unsigned char c : buffer) sum += c;
+
+  int crc = 255 - (sum % 256);
+  if (crc < 32) crc += 32;
+
+  return crc;
+}
+
+bool LeyboldGraphixEmulator::Respond( const std::string& command, std::string& reply )
+{
+  if (command[0] != SI && command[0] != SO) return false;
+
+  // strip the type character and the trailing " <CRC>"
+  std::string request = command.substr( 1 );
+  size_t idx = request.rfind( ' ' );
+  if (idx != std::string::npos) request.resize( idx );
+
+  std::string key = request;
+  std::string value;
+
+  if (command[0] == SO) {
+    idx = request.find( ';' );
+    if (idx != std::string::npos) idx = request.find( ';', idx + 1 );
+    if (idx != std::string::npos) {
+      key = request.substr( 0, idx );
+      value = request.substr( idx + 1 );
+    }
+  }
+
+  reply.clear();
+
+  auto it = fValues.find( key );
+  if (it == fValues.end()) {
+    reply += NACK;
+  } else {
+    reply += ACK;
+    if (command[0] == SO) {
+      it->second = value;
+    } else {
+      reply += it->second;
+    }
+  }
+
+  reply += Checksum( reply );
+  reply += EOT;
+
+  return true;
+}
@@ -0,0 +1,43 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LEYBOLDGRAPHIXEMULATOR_H_
+#define _LEYBOLDGRAPHIXEMULATOR_H_
+
+#include <map>
+
+#include "PtyEmulator.h"
+
+/**
+  \brief Leybold Graphix One/Three controller.
+
+  Requests are \<SI\>group;parameter \<CRC\>\<EOT\> (read) or
+  \<SO\>group;parameter;value \<CRC\>\<EOT\> (write). Every request is
+  answered with \<ACK\>[value]\<CRC\>\<EOT\>.
+*/
+class LeyboldGraphixEmulator : public PtyEmulator
+{
+ public:
+
+  LeyboldGraphixEmulator( int channels = 3 );
+  ~LeyboldGraphixEmulator() { Stop(); }
+
+ protected:
+
+  bool Respond( const std::string& command, std::string& reply );
+
+  char Checksum( const std::string& buffer ) const;
+
+  std::map<std::string,std::string> fValues;
+};
+
+#endif // _LEYBOLDGRAPHIXEMULATOR_H_
@@ -0,0 +1,153 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <iostream>
+
+#include "PtyEmulator.h"
+
+PtyEmulator::PtyEmulator( const std::string& terminator )
+  : fTerminator( terminator ),
+    fMaster( -1 ),
+    fSlave( -1 ),
+    fResponseDelay( 0 ),
+    fBaudRate( 0 ),
+    fCommandCount( 0 ),
+    fRunning( false )
+{
+
+}
+
+PtyEmulator::~PtyEmulator()
+{
+  Stop();
+}
+
+bool PtyEmulator::Start( void )
+{
+  if (fRunning) return true;
+
+  fMaster = posix_openpt( O_RDWR | O_NOCTTY | O_CLOEXEC );
+  if (fMaster == -1 || grantpt( fMaster ) != 0 || unlockpt( fMaster ) != 0) {
+    std::cerr << "[PtyEmulator::Start] ** ERROR: could not create pseudo terminal." << std::endl;
+    Stop();
+    return false;
+  }
+
+  fDevicePath = ptsname( fMaster );
+
+  // keep the slave side open while the emulator is running, otherwise the
+  // master reports a hangup whenever the driver closes its port
+  fSlave = open( fDevicePath.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC );
+  if (fSlave == -1) {
+    std::cerr << "[PtyEmulator::Start] ** ERROR: could not open " << fDevicePath << "." << std::endl;
+    Stop();
+    return false;
+  }
+
+  // a device does not echo, drivers that do not configure the port
+  // (e.g. usbtmc) would otherwise read their own commands back
+  struct termios settings;
+  tcgetattr( fSlave, &settings );
+  cfmakeraw( &settings );
+  tcsetattr( fSlave, TCSANOW, &settings );
+
+  fRunning = true;
+  fThread = std::thread( &PtyEmulator::Run, this );
+
+  return true;
+}
+
+void PtyEmulator::Stop( void )
+{
+  fRunning = false;
+  if (fThread.joinable()) fThread.join();
+
+  if (fSlave != -1) close( fSlave );
+  if (fMaster != -1) close( fMaster );
+  fSlave = -1;
+  fMaster = -1;
+}
+
+void PtyEmulator::Run( void )
+{
+  std::string buffer;
+  char data[1024];
+
+  while (fRunning) {
+
+    struct pollfd pfd = { fMaster, POLLIN, 0 };
+    if (poll( &pfd, 1, 100 ) <= 0) continue;
+
+    ssize_t count = read( fMaster, data, sizeof(data) );
+    if (count <= 0) {
+      if (count < 0 && errno != EAGAIN && errno != EINTR) usleep( 10000 );
+      continue;
+    }
+
+    buffer.append( data, count );
+    Process( buffer );
+  }
+}
+
+void PtyEmulator::Process( std::string& buffer )
+{
+  size_t idx;
+  while ((idx = buffer.find( fTerminator )) != std::string::npos) {
+
+    std::string command = buffer.substr( 0, idx );
+    buffer.erase( 0, idx + fTerminator.length() );
+
+    while (!command.empty() && (command.back() == '\r' || command.back() == '\n')) {
+      command.pop_back();
+    }
+    while (!command.empty() && (command.front() == '\r' || command.front() == '\n')) {
+      command.erase( 0, 1 );
+    }
+    if (command.empty()) continue;
+
+    fCommandCount++;
+
+    std::string reply;
+    if (Respond( command, reply )) Send( reply );
+  }
+}
+
+void PtyEmulator::Send( const std::string& reply )
+{
+  long delay = fResponseDelay;
+
+  // 10 bits per character for 8N1
+  int baudRate = fBaudRate;
+  if (baudRate > 0) delay += 10000000L * reply.length() / baudRate;
+
+  if (delay > 0) usleep( delay );
+
+  size_t written = 0;
+  while (written < reply.length()) {
+    ssize_t result = write( fMaster, reply.data() + written, reply.length() - written );
+    if (result > 0) {
+      written += result;
+      continue;
+    }
+    if (result < 0 && errno != EAGAIN && errno != EINTR) return;
+
+    struct pollfd pfd = { fMaster, POLLOUT, 0 };
+    poll( &pfd, 1, 100 );
+  }
+}
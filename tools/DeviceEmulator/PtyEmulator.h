@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//               Copyright (C) 2011-2020 - The DESY CMS Group                  //
+//                           All rights reserved                               //
+//                                                                             //
+//      The CMStkModLab source code is licensed under the GNU GPL v3.0.        //
+//      You have the right to modify and/or redistribute this source code      //
+//      under the terms specified in the license, which may be found online    //
+//      at http://www.gnu.org/licenses or at License.txt.                      //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _PTYEMULATOR_H_
+#define _PTYEMULATOR_H_
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+/**
+  \brief Emulates a serial device on a pseudo terminal.
+
+  Start() creates a pty pair and serves the master side from a background
+  thread. The slave side (DevicePath()) is passed to the real device
+  driver in place of /dev/ttyS*, so the full ComHandler path is exercised
+  without hardware.
+
+  Incoming bytes are split into commands at the command terminator.
+  Trailing carriage returns and line feeds are removed before the command
+  is passed to Respond(). A reply is sent after the response delay plus
+  the time its bytes would need on a line with the emulated baud rate.
+
+  Derived classes have to call Stop() in their destructor, otherwise the
+  thread may call Respond() on a partially destroyed object.
+*/
+class PtyEmulator
+{
+ public:
+
+  PtyEmulator( const std::string& terminator );
+  virtual ~PtyEmulator();
+
+  bool Start( void );
+  void Stop( void );
+
+  //! Path of the slave device to be opened by the driver.
+  const std::string& DevicePath( void ) const { return fDevicePath; }
+
+  //! Fixed delay in us between the end of a command and its reply.
+  void SetResponseDelay( int delay ) { fResponseDelay = delay; }
+
+  //! Emulated line speed, 0 disables the transmission delay.
+  void SetBaudRate( int baudRate ) { fBaudRate = baudRate; }
+
+  unsigned long CommandCount( void ) const { return fCommandCount; }
+
+ protected:
+
+  /**
+    Handles one command. Returns false if the device does not reply,
+    otherwise reply contains the complete reply including its terminator.
+    */
+  virtual bool Respond( const std::string& command, std::string& reply ) = 0;
+
+  void Run( void );
+  void Process( std::string& buffer );
+  void Send( const std::string& reply );
+
+  std::string fTerminator;
+  std::string fDevicePath;
+
+  int fMaster;
+  int fSlave;
+
+  std::atomic<int> fResponseDelay;
+  std::atomic<int> fBaudRate;
+  std::atomic<unsigned long> fCommandCount;
+
+  std::atomic<bool> fRunning;
+  std::thread fThread;
+};
+
+#endif // _PTYEMULATOR_H_